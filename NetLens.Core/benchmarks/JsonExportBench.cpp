@@ -0,0 +1,168 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+// Time of JsonExporter::toJson against the nlohmann document it replaced,
+// on synthetic hosts whose banners mix plain text, escapes, control bytes
+// and multi-byte UTF-8. Both outputs must match byte for byte, pretty and
+// compact, on a host list large enough for the parallel slices and on one
+// small enough for the serial path; the program exits with status 1 if
+// they differ.
+//
+// Usage: JsonExportBench [hosts] [runs]
+
+#include <netlens/JsonExporter.h>
+#include <json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using json = nlohmann::json;
+
+// Below JsonExporter's threshold for parallel slices
+constexpr size_t SERIAL_HOSTS = 1000;
+
+/// <summary>
+/// The exporter before JsonWriter: builds a document and dumps it.
+/// </summary>
+std::string nlohmannJson(const netlens::ScanResult& result, bool pretty) {
+    json j;
+    j["settings"] = {
+        {"startIp", result.settings.start_ip},
+        {"endIp", result.settings.end_ip},
+        {"ports", result.settings.ports},
+        {"timeoutMs", result.settings.timeout_ms},
+        {"maxConcurrency", result.settings.max_concurrency}
+    };
+
+    j["hosts"] = json::array();
+    for (const auto& host : result.hosts) {
+        json host_obj = {
+            {"ip", host.address},
+            {"isAlive", host.is_alive},
+            {"ports", json::array()}
+        };
+        for (const auto& port : host.ports) {
+            json port_obj = {
+                {"port", port.port},
+                {"isOpen", port.is_open}
+            };
+            if (!port.banner.empty()) {
+                port_obj["banner"] = port.banner;
+            }
+            host_obj["ports"].push_back(port_obj);
+        }
+        j["hosts"].push_back(host_obj);
+    }
+
+    j["metadata"] = {
+        {"version", "1.0"},
+        {"tool", "NetLens"},
+        {"totalHosts", result.hosts.size()},
+        {"aliveHosts", std::count_if(result.hosts.begin(), result.hosts.end(),
+                                     [](const netlens::HostResult& h) { return h.is_alive; })}
+    };
+
+    return pretty ? j.dump(2) : j.dump();
+}
+
+std::string syntheticBanner(std::mt19937& rng) {
+    static const char* const pieces[] = {
+        "SSH-2.0-OpenSSH_9.6p1 Ubuntu-3ubuntu13",
+        "HTTP/1.1 200 OK\r\nServer: nginx\r\nContent-Type: text/html\r\n\r\n",
+        "220 mail.example.com ESMTP \"ready\"",
+        "path C:\\inetpub\\wwwroot\t",
+        "\x01\x02\x1f\x7f",
+        "caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x94\x92",
+        "+OK POP3 server ready <1896.697170952@example.com>",
+    };
+    std::string banner;
+    const size_t count = rng() % 4;
+    for (size_t i = 0; i < count; ++i) {
+        banner += pieces[rng() % std::size(pieces)];
+    }
+    return banner;
+}
+
+netlens::ScanResult syntheticResult(size_t host_count) {
+    std::mt19937 rng(12345);
+    netlens::ScanResult result;
+    result.settings.start_ip = "10.0.0.0";
+    result.settings.end_ip = "10.255.255.255";
+    result.settings.ports = { 21, 22, 25, 80, 110, 143, 443, 3306, 8080 };
+    result.hosts.reserve(host_count);
+
+    for (size_t i = 0; i < host_count; ++i) {
+        const auto address = static_cast<uint32_t>(0x0A000000u + i);
+        netlens::HostResult host(std::to_string(address >> 24) + '.' + std::to_string((address >> 16) & 0xFF) + '.' +
+                                 std::to_string((address >> 8) & 0xFF) + '.' + std::to_string(address & 0xFF),
+                                 rng() % 3 != 0);
+        if (host.is_alive) {
+            for (uint16_t port : result.settings.ports) {
+                const bool open = rng() % 4 == 0;
+                host.ports.emplace_back(port, open, open ? syntheticBanner(rng) : std::string());
+            }
+        }
+        result.hosts.push_back(std::move(host));
+    }
+    return result;
+}
+
+template<typename Export>
+double bestMs(size_t runs, std::string& out, Export&& run) {
+    double best = 0.0;
+    for (size_t i = 0; i < runs; ++i) {
+        const auto started = Clock::now();
+        run(out);
+        const double ms = std::chrono::duration<double, std::milli>(Clock::now() - started).count();
+        best = i == 0 ? ms : std::min(best, ms);
+    }
+    return best;
+}
+
+bool compare(const char* name, const netlens::ScanResult& result, bool pretty, size_t runs) {
+    std::string expected;
+    std::string actual;
+    const double reference_ms = bestMs(runs, expected, [&](std::string& out) {
+        out = nlohmannJson(result, pretty);
+    });
+    const double writer_ms = bestMs(runs, actual, [&](std::string& out) {
+        netlens::JsonExporter::toJson(result, out, pretty);
+    });
+
+    const bool identical = expected == actual;
+    std::printf("%-8s %-8s %8zu hosts  nlohmann %9.1f ms  JsonWriter %8.1f ms  %5.1fx  %10zu bytes  identical %s\n",
+                name, pretty ? "pretty" : "compact", result.hosts.size(), reference_ms, writer_ms,
+                writer_ms > 0.0 ? reference_ms / writer_ms : 0.0, actual.size(), identical ? "yes" : "NO");
+    if (!identical) {
+        const auto mismatch = std::mismatch(expected.begin(), expected.end(), actual.begin(), actual.end());
+        std::printf("  first difference at byte %zu\n", static_cast<size_t>(mismatch.first - expected.begin()));
+    }
+    return identical;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t hosts = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    const size_t runs = std::max<size_t>(1, argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 3);
+
+    const netlens::ScanResult large = syntheticResult(hosts);
+    const netlens::ScanResult small = syntheticResult(std::min(hosts, SERIAL_HOSTS));
+
+    bool identical = true;
+    for (bool pretty : { true, false }) {
+        identical = compare("large", large, pretty, runs) && identical;
+        identical = compare("small", small, pretty, runs) && identical;
+    }
+    return identical ? 0 : 1;
+}
@@ -0,0 +1,613 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+// Throughput regression suite on loopback. Starts a target farm on
+// 127.0.0.0/8 (see TargetFarm.h): thousands of listeners that send a
+// banner, stay silent or close at once, plus blackholed and refused
+// targets. On POSIX systems the farm runs in a child process so that its
+// CPU and memory are not charged to the scanner. Each scenario is then
+// scanned with Scanner::scan (or scanStream) several times:
+//   refused  a block where nothing listens; pure connect rate
+//   mixed    the farm; connects, banner reads and timeouts
+// Per run it measures probes per second, time to the first result, peak
+// RSS and CPU time per probe, and checks the results against the farm's
+// layout. Each backend is also checked to close its pending connects
+// promptly on cancel: the farm is scanned with a timeout far beyond the
+// run, cancelled once its blackholed connects are pending, and must return
+// within CANCEL_LIMIT_MS. A table goes to stderr and the medians to a JSON document. Given
+// the document of an earlier commit as --baseline, the run is compared
+// against it and the exit code is 2 if any metric got worse by more than
+// --threshold percent; results that do not match the farm exit with 1.
+//
+// Usage: LoopbackBench [--hosts N] [--ports P,P,...] [--runs N] [--threads N]
+//                      [--timeout MS] [--window N] [--api scan|stream]
+//                      [--backend asio|io_uring|all] [--label TEXT]
+//                      [--output FILE|-] [--baseline FILE] [--threshold PCT]
+
+#include "TargetFarm.h"
+#include <netlens/Scanner.h>
+#include <json.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <csignal>
+#include <unistd.h>
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using json = nlohmann::json;
+
+constexpr uint32_t CANCEL_TIMEOUT_MS = 10000;
+constexpr int CANCEL_AFTER_MS = 300;
+constexpr double CANCEL_LIMIT_MS = 500.0;
+using netlens::bench::FarmLayout;
+using netlens::bench::TargetFarm;
+using netlens::bench::TargetKind;
+
+struct Options {
+    FarmLayout layout;
+    int runs = 3;
+    uint32_t threads = 0;
+    uint32_t timeout_ms = 500;
+    uint32_t window = 1024;
+    bool stream = false;
+    std::vector<netlens::IoBackend> backends = { netlens::IoBackend::Asio };
+    std::string label;
+    std::string output = "-";
+    std::string baseline;
+    double threshold = 10.0;
+};
+
+[[noreturn]] void usage(const char* message) {
+    std::fprintf(stderr, "LoopbackBench: %s\n", message);
+    std::exit(1);
+}
+
+Options parseOptions(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string key = argv[i];
+        if (i + 1 >= argc) {
+            usage(("missing value for " + key).c_str());
+        }
+        const std::string value = argv[++i];
+        if (key == "--hosts") {
+            options.layout.hosts = static_cast<uint32_t>(std::stoul(value));
+        } else if (key == "--ports") {
+            options.layout.ports.clear();
+            std::istringstream list(value);
+            std::string port;
+            while (std::getline(list, port, ',')) {
+                options.layout.ports.push_back(static_cast<uint16_t>(std::stoul(port)));
+            }
+        } else if (key == "--runs") {
+            options.runs = std::max(1, std::stoi(value));
+        } else if (key == "--threads") {
+            options.threads = static_cast<uint32_t>(std::stoul(value));
+        } else if (key == "--timeout") {
+            options.timeout_ms = static_cast<uint32_t>(std::stoul(value));
+        } else if (key == "--window") {
+            options.window = static_cast<uint32_t>(std::stoul(value));
+        } else if (key == "--api") {
+            options.stream = value == "stream";
+        } else if (key == "--backend") {
+            options.backends.clear();
+            if (value == "asio" || value == "all") {
+                options.backends.push_back(netlens::IoBackend::Asio);
+            }
+            if (value == "io_uring" || value == "all") {
+                options.backends.push_back(netlens::IoBackend::IoUring);
+            }
+        } else if (key == "--label") {
+            options.label = value;
+        } else if (key == "--output") {
+            options.output = value;
+        } else if (key == "--baseline") {
+            options.baseline = value;
+        } else if (key == "--threshold") {
+            options.threshold = std::stod(value);
+        } else {
+            usage(("unknown option " + key).c_str());
+        }
+    }
+    if (options.layout.hosts == 0 || options.layout.hosts > 65536 || options.layout.ports.empty()) {
+        usage("need 1 to 65536 hosts and at least one port");
+    }
+    if (options.backends.empty()) {
+        usage("backend must be asio, io_uring or all");
+    }
+    return options;
+}
+
+const char* toString(netlens::IoBackend backend) {
+    return backend == netlens::IoBackend::IoUring ? "io_uring" : "asio";
+}
+
+// --- Process measurements -------------------------------------------------
+
+double cpuSeconds() {
+#ifdef _WIN32
+    FILETIME creation, exit, kernel, user;
+    GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user);
+    const auto ticks = [](const FILETIME& time) {
+        return (static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+    };
+    return static_cast<double>(ticks(kernel) + ticks(user)) / 1e7;
+#else
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec)
+        + static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+#endif
+}
+
+/// <summary>
+/// Resets the peak RSS where the system allows it (Linux 4.0+), so each
+/// run reports its own peak. Returns false where the peak covers the whole
+/// process so far.
+/// </summary>
+bool resetPeakRss() {
+#ifdef __linux__
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    clear_refs << "5";
+    return static_cast<bool>(clear_refs.flush());
+#else
+    return false;
+#endif
+}
+
+uint64_t peakRssKb() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters{};
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return counters.PeakWorkingSetSize / 1024;
+#elif defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("VmHWM:", 0) == 0) {
+            return std::stoull(line.substr(6));
+        }
+    }
+    return 0;
+#else
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return static_cast<uint64_t>(usage.ru_maxrss) / 1024;
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss);
+#endif
+#endif
+}
+
+// --- Farm process ---------------------------------------------------------
+
+/// <summary>
+/// Runs the farm in a child process on POSIX systems, on a thread of this
+/// process elsewhere.
+/// </summary>
+class FarmRunner {
+public:
+    explicit FarmRunner(const FarmLayout& layout) {
+        TargetFarm::raiseFileLimit();
+#ifdef _WIN32
+        m_farm = std::make_unique<TargetFarm>(layout);
+        m_thread = std::thread([this]() { m_farm->run(); });
+#else
+        int fds[2];
+        if (pipe(fds) != 0) {
+            usage("pipe failed");
+        }
+        m_child = fork();
+        if (m_child == 0) {
+            close(fds[0]);
+            char ready = 1;
+            try {
+                TargetFarm farm(layout);
+                if (write(fds[1], &ready, 1) != 1) {
+                    _exit(1);
+                }
+                close(fds[1]);
+                farm.run();
+            } catch (const std::exception& e) {
+                std::fprintf(stderr, "LoopbackBench: farm: %s\n", e.what());
+                ready = 0;
+                (void)!write(fds[1], &ready, 1);
+            }
+            _exit(0);
+        }
+        close(fds[1]);
+        char ready = 0;
+        const bool started = read(fds[0], &ready, 1) == 1 && ready == 1;
+        close(fds[0]);
+        if (!started) {
+            usage("target farm failed to start");
+        }
+#endif
+    }
+
+    ~FarmRunner() {
+#ifdef _WIN32
+        m_farm->stop();
+        m_thread.join();
+#else
+        kill(m_child, SIGTERM);
+        waitpid(m_child, nullptr, 0);
+#endif
+    }
+
+    bool inProcess() const {
+#ifdef _WIN32
+        return true;
+#else
+        return false;
+#endif
+    }
+
+private:
+#ifdef _WIN32
+    std::unique_ptr<TargetFarm> m_farm;
+    std::thread m_thread;
+#else
+    pid_t m_child = -1;
+#endif
+};
+
+// --- Scenarios -----------------------------------------------------------
+
+struct Expected {
+    uint64_t open = 0;
+    uint64_t banners = 0;
+    uint64_t closed = 0;
+    uint64_t filtered = 0;
+};
+
+struct Scenario {
+    std::string name;
+    netlens::ScanSettings settings;
+    Expected expected;
+};
+
+struct RunSample {
+    double probes_per_sec = 0.0;
+    double first_result_ms = -1.0;
+    double cpu_us_per_probe = 0.0;
+    uint64_t peak_rss_kb = 0;
+    Expected found;
+};
+
+std::vector<Scenario> makeScenarios(const Options& options) {
+    const FarmLayout& layout = options.layout;
+    const uint64_t probes = static_cast<uint64_t>(layout.hosts) * layout.ports.size();
+
+    netlens::ScanSettings base;
+    base.ports = layout.ports;
+    base.timeout_ms = options.timeout_ms;
+    base.max_concurrency = options.window;
+    base.adaptive_concurrency = false;
+    base.adaptive_timeout = false;
+    base.progress_interval_ms = 5;
+
+    std::vector<Scenario> scenarios;
+
+    // The next /16 up from the farm, where nothing listens
+    Scenario refused{ "refused", base, {} };
+    refused.settings.start_ip = asio::ip::address_v4(layout.first_address + 0x10000).to_string();
+    refused.settings.end_ip = asio::ip::address_v4(layout.first_address + 0x10000 + layout.hosts - 1).to_string();
+    refused.expected.closed = probes;
+    scenarios.push_back(refused);
+
+    const auto counts = layout.counts();
+    Scenario mixed{ "mixed", base, {} };
+    mixed.settings.start_ip = asio::ip::address_v4(layout.first_address).to_string();
+    mixed.settings.end_ip = layout.lastAddress();
+    mixed.expected.banners = counts[static_cast<size_t>(TargetKind::Banner)];
+    mixed.expected.open = mixed.expected.banners + counts[static_cast<size_t>(TargetKind::Silent)]
+        + counts[static_cast<size_t>(TargetKind::Close)];
+    mixed.expected.closed = counts[static_cast<size_t>(TargetKind::Refused)];
+    mixed.expected.filtered = counts[static_cast<size_t>(TargetKind::Blackhole)];
+    scenarios.push_back(mixed);
+
+    return scenarios;
+}
+
+void countHost(const netlens::HostResult& host, Expected& found) {
+    for (const auto& port : host.ports) {
+        if (port.is_open) {
+            ++found.open;
+            found.banners += port.banner.empty() ? 0 : 1;
+        }
+    }
+    found.closed += host.closed_ports;
+    found.filtered += host.filtered_ports;
+}
+
+RunSample runOnce(netlens::Scanner& scanner, const Scenario& scenario, bool stream) {
+    RunSample sample;
+    resetPeakRss();
+    const double cpu_before = cpuSeconds();
+    const auto started = Clock::now();
+    std::atomic<int64_t> first_result_us{-1};
+    const auto markFirst = [&]() {
+        int64_t unset = -1;
+        const int64_t elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - started).count();
+        first_result_us.compare_exchange_strong(unset, elapsed);
+    };
+
+    if (stream) {
+        scanner.scanStream(scenario.settings, [&](netlens::HostResult&& host) {
+            markFirst();
+            countHost(host, sample.found);
+        });
+    } else {
+        // Snapshots come every progress_interval_ms once anything completed
+        const netlens::ScanResult result = scanner.scan(scenario.settings,
+            [&](const netlens::ScanProgress& progress) {
+                if (progress.completed_hosts > 0) {
+                    markFirst();
+                }
+            });
+        for (const auto& host : result.hosts) {
+            countHost(host, sample.found);
+        }
+    }
+
+    const double seconds = std::chrono::duration<double>(Clock::now() - started).count();
+    const double cpu = cpuSeconds() - cpu_before;
+    const double probes = static_cast<double>(scenario.expected.open + scenario.expected.closed
+                                              + scenario.expected.filtered);
+
+    sample.probes_per_sec = probes / seconds;
+    sample.cpu_us_per_probe = cpu / probes * 1e6;
+    sample.peak_rss_kb = peakRssKb();
+    sample.first_result_ms = first_result_us.load() >= 0 ? first_result_us.load() / 1000.0 : -1.0;
+    return sample;
+}
+
+/// <summary>
+/// Scans the farm under a timeout far longer than the run and cancels it
+/// once its blackholed connects are pending. Returns the milliseconds from
+/// the cancel until the scan returned.
+/// </summary>
+double cancelLatencyMs(netlens::Scanner& scanner, const Scenario& scenario) {
+    netlens::ScanSettings settings = scenario.settings;
+    settings.timeout_ms = CANCEL_TIMEOUT_MS;
+
+    netlens::ScanControl control;
+    Clock::time_point cancelled_at;
+    std::thread canceller([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(CANCEL_AFTER_MS));
+        cancelled_at = Clock::now();
+        control.cancel();
+    });
+    scanner.scanStream(settings, [](netlens::HostResult&&) {}, nullptr, &control);
+    const Clock::time_point returned = Clock::now();
+    canceller.join();
+    return std::chrono::duration<double, std::milli>(returned - cancelled_at).count();
+}
+
+double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    const size_t middle = values.size() / 2;
+    return values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) / 2.0;
+}
+
+/// <summary>
+/// Whether the results match the farm. scan() reports open ports only, so
+/// closed and filtered counts are checked with scanStream alone.
+/// </summary>
+bool matches(const Expected& expected, const Expected& found, bool stream) {
+    if (found.open != expected.open || found.banners != expected.banners) {
+        return false;
+    }
+    return !stream || (found.closed == expected.closed && found.filtered == expected.filtered);
+}
+
+// --- Baseline comparison ------------------------------------------------------
+
+struct Metric {
+    const char* name;
+    bool higher_is_better;
+};
+
+constexpr Metric METRICS[] = {
+    { "probes_per_sec", true },
+    { "time_to_first_result_ms", false },
+    { "cpu_us_per_probe", false },
+    { "peak_rss_kb", false },
+};
+
+/// <summary>
+/// Prints the change of each metric against the baseline; returns false
+/// if any got worse by more than the threshold.
+/// </summary>
+bool compare(const json& current, const json& baseline, double threshold) {
+    bool passed = true;
+    std::fprintf(stderr, "\nagainst baseline %s (threshold %.1f%%)\n",
+                baseline.value("label", std::string("?")).c_str(), threshold);
+    json config = current["config"];
+    json baseline_config = baseline["config"];
+    config.erase("runs");
+    baseline_config.erase("runs");
+    if (config != baseline_config) {
+        std::fprintf(stderr, "  note: the baseline was run with a different configuration\n");
+    }
+    for (const json& result : current["results"]) {
+        const json* before = nullptr;
+        for (const json& candidate : baseline["results"]) {
+            if (candidate["scenario"] == result["scenario"] && candidate["backend"] == result["backend"]) {
+                before = &candidate;
+            }
+        }
+        if (!before) {
+            continue;
+        }
+        for (const Metric& metric : METRICS) {
+            const double old_value = (*before)[metric.name].get<double>();
+            const double new_value = result[metric.name].get<double>();
+            if (old_value <= 0.0 || new_value < 0.0) {
+                continue;
+            }
+            const double change = (new_value - old_value) / old_value * 100.0;
+            const bool regressed = metric.higher_is_better ? change < -threshold : change > threshold;
+            passed = passed && !regressed;
+            std::fprintf(stderr, "  %-8s %-8s %-24s %12.2f -> %12.2f  %+7.1f%%%s\n",
+                        result["backend"].get<std::string>().c_str(), result["scenario"].get<std::string>().c_str(),
+                        metric.name, old_value, new_value, change, regressed ? "  REGRESSION" : "");
+        }
+    }
+    return passed;
+}
+
+std::string timestamp() {
+    const std::time_t now = std::time(nullptr);
+    char text[32];
+    std::strftime(text, sizeof(text), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    return text;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const Options options = parseOptions(argc, argv);
+    const auto counts = options.layout.counts();
+
+    std::fprintf(stderr, "starting farm: %u hosts x %zu ports ...\n", options.layout.hosts, options.layout.ports.size());
+    FarmRunner farm(options.layout);
+
+    json document;
+    document["benchmark"] = "LoopbackBench";
+    document["label"] = options.label;
+    document["timestamp"] = timestamp();
+    document["hardware_threads"] = std::thread::hardware_concurrency();
+    document["config"] = {
+        { "hosts", options.layout.hosts },
+        { "ports", options.layout.ports },
+        { "runs", options.runs },
+        { "threads", options.threads },
+        { "timeout_ms", options.timeout_ms },
+        { "window", options.window },
+        { "api", options.stream ? "stream" : "scan" },
+        { "farm_in_process", farm.inProcess() },
+        { "peak_rss_per_run", resetPeakRss() },
+    };
+    for (size_t kind = 0; kind < netlens::bench::TARGET_KINDS; ++kind) {
+        document["config"]["farm"][netlens::bench::toString(static_cast<TargetKind>(kind))] = counts[kind];
+    }
+    document["results"] = json::array();
+    document["cancel_checks"] = json::array();
+
+    bool valid = true;
+    std::fprintf(stderr, "%-8s %-8s %12s %12s %12s %10s %6s\n",
+                "backend", "scenario", "probes/s", "first ms", "cpu us/probe", "rss KB", "valid");
+    for (const netlens::IoBackend backend : options.backends) {
+        netlens::EngineOptions engine;
+        engine.threads = options.threads;
+        engine.io_backend = backend;
+        netlens::Scanner scanner(engine);
+
+        for (const Scenario& scenario : makeScenarios(options)) {
+            std::vector<double> rates, first_results, cpu;
+            uint64_t peak_rss = 0;
+            bool scenario_valid = true;
+            json runs = json::array();
+            for (int run = 0; run < options.runs; ++run) {
+                const RunSample sample = runOnce(scanner, scenario, options.stream);
+                rates.push_back(sample.probes_per_sec);
+                first_results.push_back(sample.first_result_ms);
+                cpu.push_back(sample.cpu_us_per_probe);
+                peak_rss = std::max(peak_rss, sample.peak_rss_kb);
+                const bool run_valid = matches(scenario.expected, sample.found, options.stream);
+                scenario_valid = scenario_valid && run_valid;
+                runs.push_back({
+                    { "probes_per_sec", sample.probes_per_sec },
+                    { "time_to_first_result_ms", sample.first_result_ms },
+                    { "cpu_us_per_probe", sample.cpu_us_per_probe },
+                    { "peak_rss_kb", sample.peak_rss_kb },
+                    { "open", sample.found.open },
+                    { "banners", sample.found.banners },
+                    { "closed", sample.found.closed },
+                    { "filtered", sample.found.filtered },
+                    { "valid", run_valid },
+                });
+            }
+            valid = valid && scenario_valid;
+
+            const json result = {
+                { "scenario", scenario.name },
+                { "backend", toString(backend) },
+                { "probes", static_cast<uint64_t>(scenario.settings.ports.size()) * options.layout.hosts },
+                { "probes_per_sec", median(rates) },
+                { "time_to_first_result_ms", median(first_results) },
+                { "cpu_us_per_probe", median(cpu) },
+                { "peak_rss_kb", peak_rss },
+                { "expected", {
+                    { "open", scenario.expected.open },
+                    { "banners", scenario.expected.banners },
+                    { "closed", scenario.expected.closed },
+                    { "filtered", scenario.expected.filtered } } },
+                { "valid", scenario_valid },
+                { "runs", runs },
+            };
+            document["results"].push_back(result);
+            std::fprintf(stderr, "%-8s %-8s %12.0f %12.2f %12.2f %10llu %6s\n", toString(backend), scenario.name.c_str(),
+                        median(rates), median(first_results), median(cpu),
+                        static_cast<unsigned long long>(peak_rss), scenario_valid ? "yes" : "NO");
+            std::fflush(stderr);
+        }
+
+        // The mixed scenario holds the blackholes that keep connects pending
+        const double latency = cancelLatencyMs(scanner, makeScenarios(options).back());
+        const bool cancel_valid = latency <= CANCEL_LIMIT_MS;
+        valid = valid && cancel_valid;
+        document["cancel_checks"].push_back({
+            { "backend", toString(backend) },
+            { "cancel_latency_ms", latency },
+            { "limit_ms", CANCEL_LIMIT_MS },
+            { "valid", cancel_valid },
+        });
+        std::fprintf(stderr, "%-8s %-8s returned %.2f ms after cancel %6s\n", toString(backend), "cancel",
+                    latency, cancel_valid ? "yes" : "NO");
+        std::fflush(stderr);
+    }
+
+    if (options.output == "-") {
+        std::cout << document.dump(2) << std::endl;
+    } else {
+        std::ofstream(options.output) << document.dump(2) << std::endl;
+    }
+
+    int status = valid ? 0 : 1;
+    if (!options.baseline.empty()) {
+        std::ifstream input(options.baseline);
+        if (!input) {
+            usage(("cannot read baseline " + options.baseline).c_str());
+        }
+        if (!compare(document, json::parse(input), options.threshold) && status == 0) {
+            status = 2;
+        }
+    }
+    return status;
+}
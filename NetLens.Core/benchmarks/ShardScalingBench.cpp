@@ -0,0 +1,67 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+// Throughput of the sharded connect engine against thread count. Scans a
+// block of 127.0.0.0/8 on ports nothing listens on, so every probe is a
+// connect refused by the local stack and the engine, not the network, is
+// the bottleneck. Each run uses a fresh Scanner with EngineOptions::threads
+// set to 1, 2, 4, ... up to the hardware thread count, and prints probes per
+// second and the speedup over one thread.
+//
+// Usage: ShardScalingBench [hosts] [ports_per_host] [pin_threads 0|1]
+
+#include <netlens/Scanner.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main(int argc, char** argv) {
+    const uint32_t hosts = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 16384;
+    const uint32_t ports = argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 4;
+    const bool pin = argc > 3 && std::strtoul(argv[3], nullptr, 10) != 0;
+
+    netlens::ScanSettings settings;
+    settings.start_ip = "127.1.0.0";
+    settings.end_ip = "127.1." + std::to_string((hosts - 1) / 256) + "." + std::to_string((hosts - 1) % 256);
+    for (uint32_t i = 0; i < ports; ++i) {
+        settings.ports.push_back(static_cast<uint16_t>(1 + i));
+    }
+    settings.timeout_ms = 1000;
+    settings.adaptive_concurrency = false;
+
+    const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> counts;
+    for (unsigned threads = 1; threads < hardware; threads *= 2) {
+        counts.push_back(threads);
+    }
+    counts.push_back(hardware);
+
+    std::printf("%u hosts x %u ports, %s\n", hosts, ports, pin ? "pinned" : "unpinned");
+    double baseline = 0.0;
+    for (unsigned threads : counts) {
+        netlens::EngineOptions options;
+        options.threads = threads;
+        options.pin_threads = pin;
+        netlens::Scanner scanner(options);
+
+        // The window grows with the threads so every shard gets a full share
+        settings.max_concurrency = 256 * threads;
+
+        const auto started = std::chrono::steady_clock::now();
+        const netlens::ScanSummary summary = scanner.scanStream(settings, [](netlens::HostResult&&) {});
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+        const double rate = static_cast<double>(summary.total_hosts) * ports / seconds;
+        if (baseline == 0.0) {
+            baseline = rate;
+        }
+        std::printf("threads %3u  %10.0f probes/s  speedup %5.2f\n", threads, rate, rate / baseline);
+    }
+    return 0;
+}
@@ -0,0 +1,410 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+// Scheduler benchmark on a simulated network (see SimulatedNetwork.h).
+// Builds a network of blocks of 16 hosts, each block one profile drawn by
+// a fixed hash: dead space, web servers, SSH/SMTP servers, hosts behind a
+// rate-limiting firewall, distant lossy hosts with a long latency tail,
+// hosts that drop everything and tarpits. Each scheduler configuration
+// then scans the whole network once, in virtual time, and reports:
+//   virtual_s        how long the scan would have taken on that network
+//   wall_s           how long it took here
+//   recall           share of the truly open ports found
+//   false_open       ports reported open that are not (must be 0)
+//   tarpit_open      ports the tarpits made look open
+//   rate_limited     connects the firewalls dropped
+// The last configuration is scanned twice and must yield the same results
+// and virtual duration; the exit code is 1 if it does not or if a false
+// open shows up. A table goes to stderr and a JSON document to --output.
+//
+// Usage: SimulatedScanBench [--prefix N] [--ports N] [--timeout MS]
+//                           [--window N] [--seed N] [--output FILE|-]
+
+#include <netlens/Scanner.h>
+#include <netlens/SimulatedNetwork.h>
+#include <asio.hpp>
+#include <json.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using json = nlohmann::json;
+using namespace netlens;
+
+constexpr uint32_t FIRST_ADDRESS = 0x0A000000;     // 10.0.0.0
+constexpr uint32_t BLOCK_HOSTS = 16;
+
+constexpr uint16_t COMMON_PORTS[] = {
+    80, 443, 22, 21, 25, 23, 53, 110, 143, 445, 3389, 8080, 3306, 993, 995, 8443,
+    139, 135, 111, 5900, 1723, 587, 465, 2222, 5432, 6379, 8000, 8888, 9000, 9090, 27017, 11211
+};
+
+struct Options {
+    unsigned prefix = 15;
+    size_t ports = 16;
+    uint32_t timeout_ms = 1000;
+    uint32_t window = 5000;
+    uint64_t seed = 1;
+    std::string output = "-";
+};
+
+[[noreturn]] void usage(const char* message) {
+    std::fprintf(stderr, "SimulatedScanBench: %s\n", message);
+    std::exit(1);
+}
+
+Options parseOptions(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string key = argv[i];
+        if (i + 1 >= argc) {
+            usage(("missing value for " + key).c_str());
+        }
+        const std::string value = argv[++i];
+        if (key == "--prefix") {
+            options.prefix = static_cast<unsigned>(std::stoul(value));
+        } else if (key == "--ports") {
+            options.ports = std::stoul(value);
+        } else if (key == "--timeout") {
+            options.timeout_ms = static_cast<uint32_t>(std::stoul(value));
+        } else if (key == "--window") {
+            options.window = static_cast<uint32_t>(std::stoul(value));
+        } else if (key == "--seed") {
+            options.seed = std::stoull(value);
+        } else if (key == "--output") {
+            options.output = value;
+        } else {
+            usage(("unknown option " + key).c_str());
+        }
+    }
+    if (options.prefix < 8 || options.prefix > 28) {
+        usage("prefix must be 8 to 28");
+    }
+    if (options.ports == 0 || options.ports > std::size(COMMON_PORTS)) {
+        usage("ports must be 1 to 32");
+    }
+    return options;
+}
+
+// --- The network ---------------------------------------------------------------
+
+struct Profile {
+    const char* name;
+    unsigned weight;
+    bool present;               // False for dead space
+    SimulatedHost host;
+};
+
+std::vector<Profile> makeProfiles() {
+    const std::string http = "HTTP/1.1 200 OK\r\nServer: nginx/1.24.0\r\nContent-Length: 0\r\n\r\n";
+
+    SimulatedHost web;
+    web.open_ports = { 80, 443, 8080 };
+    web.banners[80] = http;
+    web.banners[8080] = http;
+    web.latency = LatencyModel(LatencyDistribution::LogNormal, 40.0, 25.0);
+
+    SimulatedHost server;
+    server.open_ports = { 22, 25, 3306 };
+    server.banners[22] = "SSH-2.0-OpenSSH_9.6p1 Ubuntu-3ubuntu13\r\n";
+    server.banners[25] = "220 mail.example.net ESMTP Postfix\r\n";
+    server.latency = LatencyModel(LatencyDistribution::Normal, 15.0, 5.0);
+
+    SimulatedHost firewalled;
+    firewalled.open_ports = { 443 };
+    firewalled.other_ports = PortState::Filtered;
+    firewalled.firewall_rate = 50.0;
+    firewalled.firewall_burst = 10.0;
+    firewalled.latency = LatencyModel(LatencyDistribution::Constant, 60.0);
+
+    SimulatedHost distant;
+    distant.open_ports = { 22, 80 };
+    distant.banners[22] = "SSH-2.0-dropbear_2022.83\r\n";
+    distant.loss = 0.05;
+    distant.latency = LatencyModel(LatencyDistribution::LogNormal, 250.0, 200.0);
+
+    SimulatedHost silent;
+    silent.other_ports = PortState::Filtered;
+
+    SimulatedHost tarpit;
+    tarpit.tarpit = true;
+    tarpit.latency = LatencyModel(LatencyDistribution::Constant, 80.0);
+
+    return {
+        { "dead", 40, false, SimulatedHost() },
+        { "web", 20, true, web },
+        { "server", 12, true, server },
+        { "firewalled", 10, true, firewalled },
+        { "distant", 10, true, distant },
+        { "silent", 5, true, silent },
+        { "tarpit", 3, true, tarpit },
+    };
+}
+
+uint64_t mix(uint64_t value) {
+    // splitmix64 finalizer
+    value += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+std::string toString(uint32_t address) {
+    return asio::ip::address_v4(address).to_string();
+}
+
+/// <summary>
+/// The simulated network and what a perfect scan of it would find.
+/// </summary>
+class Testbed {
+public:
+    Testbed(const Options& options)
+        : m_profiles(makeProfiles())
+        , m_ports(COMMON_PORTS, COMMON_PORTS + options.ports)
+        , m_hosts(uint32_t{1} << (32 - options.prefix))
+        , m_seed(options.seed) {
+        unsigned total = 0;
+        for (const Profile& profile : m_profiles) {
+            total += profile.weight;
+        }
+        m_blocks.resize(m_hosts / BLOCK_HOSTS);
+        for (size_t block = 0; block < m_blocks.size(); ++block) {
+            unsigned pick = static_cast<unsigned>(mix(m_seed ^ (block * 0x100000001ull)) % total);
+            size_t profile = 0;
+            while (pick >= m_profiles[profile].weight) {
+                pick -= m_profiles[profile].weight;
+                ++profile;
+            }
+            m_blocks[block] = profile;
+        }
+    }
+
+    /// <summary>
+    /// A fresh network with the same hosts, so every scan starts from
+    /// rested firewalls and zeroed counters.
+    /// </summary>
+    std::shared_ptr<SimulatedNetwork> network() const {
+        auto network = std::make_shared<SimulatedNetwork>(m_seed);
+        for (size_t block = 0; block < m_blocks.size(); ++block) {
+            const Profile& profile = m_profiles[m_blocks[block]];
+            if (profile.present) {
+                const uint32_t first = FIRST_ADDRESS + static_cast<uint32_t>(block) * BLOCK_HOSTS;
+                network->addHosts(toString(first) + "/28", profile.host);
+            }
+        }
+        return network;
+    }
+
+    std::string targets(unsigned prefix) const { return toString(FIRST_ADDRESS) + "/" + std::to_string(prefix); }
+    const std::vector<uint16_t>& ports() const { return m_ports; }
+    uint64_t probes() const { return static_cast<uint64_t>(m_hosts) * m_ports.size(); }
+
+    const Profile& profileOf(uint32_t address) const {
+        return m_profiles[m_blocks[(address - FIRST_ADDRESS) / BLOCK_HOSTS]];
+    }
+
+    static bool isOpen(const Profile& profile, uint16_t port) {
+        const auto& open = profile.host.open_ports;
+        return profile.present && std::find(open.begin(), open.end(), port) != open.end();
+    }
+
+    /// <summary>
+    /// Truly open (host, port) pairs among the scanned ports.
+    /// </summary>
+    uint64_t openPairs() const {
+        uint64_t result = 0;
+        for (size_t profile : m_blocks) {
+            for (uint16_t port : m_ports) {
+                result += isOpen(m_profiles[profile], port) ? BLOCK_HOSTS : 0;
+            }
+        }
+        return result;
+    }
+
+private:
+    std::vector<Profile> m_profiles;
+    std::vector<uint16_t> m_ports;
+    uint32_t m_hosts;
+    uint64_t m_seed;
+    std::vector<size_t> m_blocks;   // Profile of each block
+};
+
+// --- Scans ---------------------------------------------------------------------
+
+struct Config {
+    const char* name;
+    bool adaptive_concurrency;
+    bool adaptive_timeout;
+    ProbeOrder order;
+    uint32_t window;
+    uint32_t max_rate;
+};
+
+struct Result {
+    std::string name;
+    uint64_t probes = 0;
+    double virtual_s = 0.0;
+    double wall_s = 0.0;
+    uint64_t found_open = 0;
+    uint64_t false_open = 0;
+    uint64_t tarpit_open = 0;
+    uint64_t closed = 0;
+    uint64_t filtered = 0;
+    uint64_t rate_limited = 0;
+    uint64_t lost = 0;
+    uint64_t digest = 0;
+};
+
+Result runScan(const Testbed& testbed, const Options& options, const Config& config) {
+    auto network = testbed.network();
+    EngineOptions engine;
+    engine.threads = 1;
+    engine.network = network;
+    Scanner scanner(engine);
+
+    ScanSettings settings;
+    settings.targets = { testbed.targets(options.prefix) };
+    settings.ports = testbed.ports();
+    settings.timeout_ms = options.timeout_ms;
+    settings.adaptive_concurrency = config.adaptive_concurrency;
+    settings.adaptive_timeout = config.adaptive_timeout;
+    settings.max_concurrency = config.window;
+    settings.max_rate = config.max_rate;
+    settings.probe_order = config.order;
+    settings.random_seed = options.seed;
+    // A consumer that never holds the engine back keeps the scan reproducible
+    settings.max_buffered_hosts = static_cast<uint32_t>(testbed.probes() / testbed.ports().size());
+
+    Result result;
+    result.name = config.name;
+    result.probes = testbed.probes();
+    const auto start = Clock::now();
+    scanner.scanStream(settings, [&](HostResult&& host) {
+        const uint32_t address = asio::ip::make_address_v4(host.address).to_uint();
+        const Profile& profile = testbed.profileOf(address);
+        uint64_t digest = mix(address) ^ (static_cast<uint64_t>(host.closed_ports) << 32 | host.filtered_ports);
+        for (const PortResult& port : host.ports) {
+            if (Testbed::isOpen(profile, port.port)) {
+                ++result.found_open;
+            } else if (profile.host.tarpit) {
+                ++result.tarpit_open;
+            } else {
+                ++result.false_open;
+            }
+            digest = mix(digest ^ port.port ^ (std::hash<std::string>()(port.banner) << 16));
+        }
+        result.closed += host.closed_ports;
+        result.filtered += host.filtered_ports;
+        // Hosts complete in an order that depends on the schedule; the digest does not
+        result.digest += digest;
+    });
+    result.wall_s = std::chrono::duration<double>(Clock::now() - start).count();
+
+    const SimulationStats stats = network->stats();
+    result.virtual_s = std::chrono::duration<double>(stats.virtual_time).count();
+    result.rate_limited = stats.rate_limited;
+    result.lost = stats.lost;
+    return result;
+}
+
+json toJson(const Result& result, uint64_t open_pairs) {
+    return {
+        { "config", result.name },
+        { "probes", result.probes },
+        { "virtual_s", result.virtual_s },
+        { "wall_s", result.wall_s },
+        { "virtual_probes_per_sec", result.virtual_s > 0.0 ? result.probes / result.virtual_s : 0.0 },
+        { "recall", open_pairs ? static_cast<double>(result.found_open) / open_pairs : 1.0 },
+        { "found_open", result.found_open },
+        { "false_open", result.false_open },
+        { "tarpit_open", result.tarpit_open },
+        { "closed", result.closed },
+        { "filtered", result.filtered },
+        { "rate_limited", result.rate_limited },
+        { "lost", result.lost },
+    };
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const Options options = parseOptions(argc, argv);
+    const Testbed testbed(options);
+    const uint64_t open_pairs = testbed.openPairs();
+
+    const Config configs[] = {
+        { "fixed", false, false, ProbeOrder::Sequential, options.window, 0 },
+        { "fixed-small", false, false, ProbeOrder::Sequential, options.window / 10, 0 },
+        { "adaptive-window", true, false, ProbeOrder::Sequential, options.window, 0 },
+        { "adaptive-timeout", false, true, ProbeOrder::Sequential, options.window, 0 },
+        { "adaptive", true, true, ProbeOrder::Sequential, options.window, 0 },
+        { "adaptive-random", true, true, ProbeOrder::Random, options.window, 0 },
+        { "rate-20k", true, true, ProbeOrder::Random, options.window, 20000 },
+    };
+
+    std::fprintf(stderr, "simulated network: %s, %zu ports, %llu probes, %llu open pairs\n",
+                 testbed.targets(options.prefix).c_str(), testbed.ports().size(),
+                 static_cast<unsigned long long>(testbed.probes()), static_cast<unsigned long long>(open_pairs));
+    std::fprintf(stderr, "%-18s %10s %8s %8s %12s %8s %6s %8s %10s %8s\n", "config", "virtual_s", "wall_s",
+                 "speedup", "probes/vs", "recall", "false", "tarpit", "filtered", "limited");
+
+    json results = json::array();
+    std::vector<Result> runs;
+    for (const Config& config : configs) {
+        const Result result = runScan(testbed, options, config);
+        std::fprintf(stderr, "%-18s %10.1f %8.2f %7.0fx %12.0f %7.2f%% %6llu %8llu %10llu %8llu\n",
+                     result.name.c_str(), result.virtual_s, result.wall_s,
+                     result.wall_s > 0.0 ? result.virtual_s / result.wall_s : 0.0,
+                     result.virtual_s > 0.0 ? result.probes / result.virtual_s : 0.0,
+                     open_pairs ? 100.0 * result.found_open / open_pairs : 100.0,
+                     static_cast<unsigned long long>(result.false_open),
+                     static_cast<unsigned long long>(result.tarpit_open),
+                     static_cast<unsigned long long>(result.filtered),
+                     static_cast<unsigned long long>(result.rate_limited));
+        results.push_back(toJson(result, open_pairs));
+        runs.push_back(result);
+    }
+
+    // The same scan again must replay exactly
+    const Result& first = runs.back();
+    const Result replay = runScan(testbed, options, configs[std::size(configs) - 1]);
+    const bool deterministic = replay.digest == first.digest && replay.virtual_s == first.virtual_s &&
+                               replay.rate_limited == first.rate_limited;
+    std::fprintf(stderr, "replay of %s: %s\n", first.name.c_str(), deterministic ? "identical" : "DIFFERENT");
+
+    bool valid = deterministic;
+    for (const Result& result : runs) {
+        valid = valid && result.false_open == 0;
+    }
+
+    const json document = {
+        { "benchmark", "SimulatedScanBench" },
+        { "config", {
+            { "targets", testbed.targets(options.prefix) },
+            { "ports", testbed.ports().size() },
+            { "timeout_ms", options.timeout_ms },
+            { "window", options.window },
+            { "seed", options.seed },
+        } },
+        { "open_pairs", open_pairs },
+        { "deterministic", deterministic },
+        { "results", results },
+    };
+    if (options.output == "-") {
+        std::cout << document.dump(2) << "\n";
+    } else {
+        std::ofstream(options.output) << document.dump(2) << "\n";
+    }
+    return valid ? 0 : 1;
+}
@@ -0,0 +1,167 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "TargetFarm.h"
+#include <numeric>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+namespace netlens::bench {
+
+namespace {
+
+uint64_t mix(uint64_t value) {
+    // splitmix64 finalizer
+    value += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+bool isHttpPort(uint16_t port) {
+    return port == 80 || port == 8000 || port == 8080 || port == 8443;
+}
+
+} // namespace
+
+const char* toString(TargetKind kind) {
+    switch (kind) {
+        case TargetKind::Refused: return "refused";
+        case TargetKind::Banner: return "banner";
+        case TargetKind::Silent: return "silent";
+        case TargetKind::Close: return "close";
+        case TargetKind::Blackhole: return "blackhole";
+    }
+    return "unknown";
+}
+
+TargetKind FarmLayout::kindOf(uint32_t host, size_t port_index) const {
+    const unsigned total = std::accumulate(weights.begin(), weights.end(), 0u);
+    if (total == 0) {
+        return TargetKind::Refused;
+    }
+    uint64_t pick = mix(static_cast<uint64_t>(host) * ports.size() + port_index) % total;
+    for (size_t kind = 0; kind < TARGET_KINDS; ++kind) {
+        if (pick < weights[kind]) {
+            return static_cast<TargetKind>(kind);
+        }
+        pick -= weights[kind];
+    }
+    return TargetKind::Refused;
+}
+
+std::array<uint64_t, TARGET_KINDS> FarmLayout::counts() const {
+    std::array<uint64_t, TARGET_KINDS> result{};
+    for (uint32_t host = 0; host < hosts; ++host) {
+        for (size_t port = 0; port < ports.size(); ++port) {
+            ++result[static_cast<size_t>(kindOf(host, port))];
+        }
+    }
+    return result;
+}
+
+std::string FarmLayout::lastAddress() const {
+    return asio::ip::address_v4(first_address + hosts - 1).to_string();
+}
+
+TargetFarm::TargetFarm(const FarmLayout& layout)
+    : m_io(1) {
+    for (uint32_t host = 0; host < layout.hosts; ++host) {
+        const asio::ip::address_v4 address(layout.first_address + host);
+        for (size_t port_index = 0; port_index < layout.ports.size(); ++port_index) {
+            const TargetKind kind = layout.kindOf(host, port_index);
+            if (kind == TargetKind::Refused) {
+                continue;
+            }
+            const asio::ip::tcp::endpoint endpoint(address, layout.ports[port_index]);
+            auto acceptor = std::make_unique<asio::ip::tcp::acceptor>(m_io, endpoint.protocol());
+            acceptor->set_option(asio::socket_base::reuse_address(true));
+            acceptor->bind(endpoint);
+
+            if (kind == TargetKind::Blackhole) {
+                acceptor->listen(0);
+                auto filler = std::make_unique<asio::ip::tcp::socket>(m_io);
+                filler->connect(endpoint);
+                m_fillers.push_back(std::move(filler));
+            } else {
+                acceptor->listen(asio::socket_base::max_listen_connections);
+                accept(*acceptor, kind, layout.ports[port_index]);
+            }
+            m_acceptors.push_back(std::move(acceptor));
+        }
+    }
+}
+
+TargetFarm::~TargetFarm() = default;
+
+void TargetFarm::run() {
+    m_io.run();
+}
+
+void TargetFarm::stop() {
+    m_io.stop();
+}
+
+void TargetFarm::raiseFileLimit() {
+#ifndef _WIN32
+    rlimit limit{};
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+#endif
+}
+
+void TargetFarm::accept(asio::ip::tcp::acceptor& acceptor, TargetKind kind, uint16_t port) {
+    acceptor.async_accept([this, &acceptor, kind, port](const asio::error_code& ec, asio::ip::tcp::socket socket) {
+        if (ec == asio::error::operation_aborted) {
+            return;
+        }
+        if (!ec) {
+            auto connection = std::make_shared<asio::ip::tcp::socket>(std::move(socket));
+            switch (kind) {
+                case TargetKind::Banner: {
+                    static const std::string ssh = "SSH-2.0-NetLensFarm\r\n";
+                    static const std::string http =
+                        "HTTP/1.1 200 OK\r\nServer: NetLensFarm\r\nContent-Length: 0\r\n\r\n";
+                    const std::string& banner = isHttpPort(port) ? http : ssh;
+                    asio::async_write(*connection, asio::buffer(banner),
+                        [this, connection](const asio::error_code& write_ec, size_t) {
+                            if (!write_ec) {
+                                drain(connection);
+                            }
+                        });
+                    break;
+                }
+                case TargetKind::Silent:
+                    drain(connection);
+                    break;
+                default: {
+                    asio::error_code ignore_ec;
+                    connection->close(ignore_ec);
+                    break;
+                }
+            }
+        }
+        accept(acceptor, kind, port);
+    });
+}
+
+void TargetFarm::drain(const std::shared_ptr<asio::ip::tcp::socket>& socket) {
+    // Reads and discards until the scanner closes, then closes too
+    auto buffer = std::make_shared<std::array<char, 512>>();
+    socket->async_read_some(asio::buffer(*buffer), [this, socket, buffer](const asio::error_code& ec, size_t) {
+        if (ec) {
+            asio::error_code ignore_ec;
+            socket->close(ignore_ec);
+            return;
+        }
+        drain(socket);
+    });
+}
+
+} // namespace netlens::bench
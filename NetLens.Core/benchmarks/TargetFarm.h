@@ -0,0 +1,100 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#pragma once
+
+#include <asio.hpp>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace netlens::bench {
+
+/// <summary>
+/// What a (host, port) pair of the farm does with a connect.
+/// </summary>
+enum class TargetKind {
+    Refused,    // Nothing listens: the connect is refused
+    Banner,     // Accepts, sends a banner (an HTTP response on HTTP ports) and closes
+    Silent,     // Accepts and sends nothing until the scanner hangs up
+    Close,      // Accepts and closes at once
+    Blackhole   // Never answers: the connect times out
+};
+
+constexpr size_t TARGET_KINDS = 5;
+
+const char* toString(TargetKind kind);
+
+/// <summary>
+/// Which targets of a block of 127.0.0.0/8 do what. Kinds are spread over
+/// the (host, port) pairs by a fixed hash, in proportion to the weights, so
+/// the same layout always yields the same targets.
+/// </summary>
+struct FarmLayout {
+    uint32_t first_address = 0x7F0A0000;   // 127.10.0.0
+    uint32_t hosts = 2048;
+    std::vector<uint16_t> ports = { 2222, 8080, 9000 };
+
+    /// <summary>
+    /// Relative share of each kind, indexed by TargetKind.
+    /// </summary>
+    std::array<unsigned, TARGET_KINDS> weights = { 3, 3, 1, 2, 1 };
+
+    TargetKind kindOf(uint32_t host, size_t port_index) const;
+
+    /// <summary>
+    /// Pairs of each kind, indexed by TargetKind.
+    /// </summary>
+    std::array<uint64_t, TARGET_KINDS> counts() const;
+
+    std::string lastAddress() const;
+};
+
+/// <summary>
+/// Listeners for every target of a layout, served by one io_context. A
+/// blackhole is a listener with a backlog of zero whose single queue slot
+/// the farm fills itself and never accepts; Linux then drops further SYNs
+/// instead of refusing them. Other stacks may refuse those connects.
+/// </summary>
+class TargetFarm {
+public:
+    /// <summary>
+    /// Binds every listener of the layout.
+    /// </summary>
+    /// <exception cref="std::system_error">Thrown if a listener cannot be set up</exception>
+    explicit TargetFarm(const FarmLayout& layout);
+
+    ~TargetFarm();
+
+    TargetFarm(const TargetFarm&) = delete;
+    TargetFarm& operator=(const TargetFarm&) = delete;
+
+    /// <summary>
+    /// Serves connections until stop() is called.
+    /// </summary>
+    void run();
+
+    void stop();
+
+    size_t listeners() const { return m_acceptors.size(); }
+
+    /// <summary>
+    /// Raises the open file limit as far as allowed; the farm needs a
+    /// descriptor per listener and per connection held open.
+    /// </summary>
+    static void raiseFileLimit();
+
+private:
+    void accept(asio::ip::tcp::acceptor& acceptor, TargetKind kind, uint16_t port);
+    void drain(const std::shared_ptr<asio::ip::tcp::socket>& socket);
+
+    asio::io_context m_io;
+    std::vector<std::unique_ptr<asio::ip::tcp::acceptor>> m_acceptors;
+    std::vector<std::unique_ptr<asio::ip::tcp::socket>> m_fillers;
+};
+
+} // namespace netlens::bench
@@ -0,0 +1,157 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+// Latency of tiny scans (one host, a few ports) on loopback, run either on
+// one long-lived Scanner or on a new Scanner per scan, plus the same tiny
+// scans issued from several threads at once on one Scanner. The difference
+// between the first two is the engine setup (io threads, reactor, sockets
+// layer) that a reused Scanner no longer pays per scan.
+//
+// Usage: TinyScanBench [iterations] [concurrent_threads]
+
+#include <netlens/Scanner.h>
+#include <asio.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// <summary>
+/// Accepts and closes connections on one loopback port until destroyed.
+/// </summary>
+class LoopbackListener {
+public:
+    LoopbackListener()
+        : m_acceptor(m_io, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0)) {
+        accept();
+        m_thread = std::thread([this]() { m_io.run(); });
+    }
+
+    ~LoopbackListener() {
+        m_io.stop();
+        m_thread.join();
+    }
+
+    uint16_t port() const { return m_acceptor.local_endpoint().port(); }
+
+private:
+    void accept() {
+        m_acceptor.async_accept([this](const asio::error_code& ec, asio::ip::tcp::socket socket) {
+            if (!ec) {
+                asio::error_code ignored;
+                socket.close(ignored);
+            }
+            accept();
+        });
+    }
+
+    asio::io_context m_io;
+    asio::ip::tcp::acceptor m_acceptor;
+    std::thread m_thread;
+};
+
+struct Stats {
+    double median_us = 0.0;
+    double p99_us = 0.0;
+    double mean_us = 0.0;
+};
+
+Stats summarize(std::vector<double> samples) {
+    Stats stats;
+    if (samples.empty()) {
+        return stats;
+    }
+    std::sort(samples.begin(), samples.end());
+    stats.median_us = samples[samples.size() / 2];
+    stats.p99_us = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+    for (double sample : samples) {
+        stats.mean_us += sample;
+    }
+    stats.mean_us /= static_cast<double>(samples.size());
+    return stats;
+}
+
+double timeScan(netlens::Scanner& scanner, const netlens::ScanSettings& settings) {
+    const auto started = Clock::now();
+    scanner.scanStream(settings, [](netlens::HostResult&&) {});
+    return std::chrono::duration<double, std::micro>(Clock::now() - started).count();
+}
+
+void print(const char* name, const Stats& stats, size_t scans, double seconds) {
+    std::printf("%-22s median %9.1f us  p99 %9.1f us  mean %9.1f us  %8.1f scans/s\n",
+                name, stats.median_us, stats.p99_us, stats.mean_us,
+                seconds > 0.0 ? static_cast<double>(scans) / seconds : 0.0);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200;
+    const size_t threads = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 4;
+
+    LoopbackListener listener;
+
+    // One open port and two that refuse, so every probe answers at once
+    netlens::ScanSettings settings;
+    settings.start_ip = "127.0.0.1";
+    settings.end_ip = "127.0.0.1";
+    settings.ports = { listener.port(), 1, 2 };
+    settings.timeout_ms = 500;
+
+    std::vector<double> samples;
+    samples.reserve(iterations);
+
+    // Warm both paths once before measuring
+    {
+        netlens::Scanner scanner;
+        timeScan(scanner, settings);
+    }
+
+    auto started = Clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        netlens::Scanner scanner;
+        samples.push_back(timeScan(scanner, settings));
+    }
+    print("new Scanner per scan", summarize(samples),
+          iterations, std::chrono::duration<double>(Clock::now() - started).count());
+
+    netlens::Scanner reused;
+    timeScan(reused, settings);
+    samples.clear();
+    started = Clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        samples.push_back(timeScan(reused, settings));
+    }
+    print("reused Scanner", summarize(samples),
+          iterations, std::chrono::duration<double>(Clock::now() - started).count());
+
+    // Several callers sharing the warm engine
+    std::vector<std::vector<double>> per_thread(threads);
+    std::vector<std::thread> callers;
+    started = Clock::now();
+    for (size_t t = 0; t < threads; ++t) {
+        callers.emplace_back([&, t]() {
+            for (size_t i = 0; i < iterations; ++i) {
+                per_thread[t].push_back(timeScan(reused, settings));
+            }
+        });
+    }
+    for (auto& caller : callers) {
+        caller.join();
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - started).count();
+    samples.clear();
+    for (const auto& thread_samples : per_thread) {
+        samples.insert(samples.end(), thread_samples.begin(), thread_samples.end());
+    }
+    print("reused, concurrent", summarize(samples), samples.size(), seconds);
+    return 0;
+}
@@ -0,0 +1,169 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+// Asio against io_uring socket backends on loopback. A child process
+// listens on two ports, one that sends a banner and one that closes each
+// connection at once, so its work is not charged to the scanner. Each
+// scenario sweeps a block of 127.0.0.0/8:
+//   refused  ports nothing listens on (connect only)
+//   close    the closing listener (connect and an empty banner read)
+//   banner   the banner listener (connect and a banner read)
+// For each backend and scenario the best of several runs is printed with
+// probes per second and the process CPU time (user + system) per probe.
+// Linux only.
+//
+// Usage: UringBench [hosts] [runs] [threads]
+
+#include <netlens/Scanner.h>
+#include <asio.hpp>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// <summary>
+/// Accepts forever; sends the banner, if any, then closes.
+/// </summary>
+void serve(asio::ip::tcp::acceptor& acceptor, const std::string& banner) {
+    acceptor.async_accept([&acceptor, &banner](const asio::error_code& ec, asio::ip::tcp::socket socket) {
+        if (!ec) {
+            auto connection = std::make_shared<asio::ip::tcp::socket>(std::move(socket));
+            if (banner.empty()) {
+                asio::error_code ignore_ec;
+                connection->close(ignore_ec);
+            } else {
+                asio::async_write(*connection, asio::buffer(banner),
+                    [connection](const asio::error_code&, size_t) {
+                        asio::error_code ignore_ec;
+                        connection->shutdown(asio::ip::tcp::socket::shutdown_both, ignore_ec);
+                    });
+            }
+        }
+        serve(acceptor, banner);
+    });
+}
+
+/// <summary>
+/// Forks the listener process and returns its (banner, close) ports.
+/// </summary>
+std::pair<uint16_t, uint16_t> startListeners(pid_t& child) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        std::perror("pipe");
+        std::exit(1);
+    }
+    child = fork();
+    if (child == 0) {
+        close(fds[0]);
+        asio::io_context io(1);
+        const asio::ip::tcp::endpoint any(asio::ip::address_v4::any(), 0);
+        asio::ip::tcp::acceptor banner_acceptor(io, any);
+        asio::ip::tcp::acceptor close_acceptor(io, any);
+        banner_acceptor.listen(asio::socket_base::max_listen_connections);
+        close_acceptor.listen(asio::socket_base::max_listen_connections);
+        const std::string banner = "SSH-2.0-UringBench\r\n";
+        const std::string none;
+        serve(banner_acceptor, banner);
+        serve(close_acceptor, none);
+
+        const uint16_t ports[2] = { banner_acceptor.local_endpoint().port(), close_acceptor.local_endpoint().port() };
+        if (write(fds[1], ports, sizeof(ports)) != sizeof(ports)) {
+            _exit(1);
+        }
+        close(fds[1]);
+        io.run();
+        _exit(0);
+    }
+    close(fds[1]);
+    uint16_t ports[2] = {};
+    if (read(fds[0], ports, sizeof(ports)) != sizeof(ports)) {
+        std::fprintf(stderr, "listener failed to start\n");
+        std::exit(1);
+    }
+    close(fds[0]);
+    return { ports[0], ports[1] };
+}
+
+double cpuSeconds() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec)
+        + static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+struct Scenario {
+    const char* name;
+    std::vector<uint16_t> ports;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const uint32_t hosts = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 8192;
+    const int runs = argc > 2 ? std::max(1, std::atoi(argv[2])) : 3;
+    const uint32_t threads = argc > 3 ? static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10)) : 1;
+
+    pid_t child = 0;
+    const auto [banner_port, close_port] = startListeners(child);
+
+    const std::vector<Scenario> scenarios = {
+        { "refused", { 1, 2, 3, 4 } },
+        { "close", { close_port } },
+        { "banner", { banner_port } },
+    };
+
+    std::printf("%u hosts, %u thread(s), best of %d\n", hosts, threads, runs);
+    std::printf("%-8s %-8s %12s %14s %10s\n", "backend", "scenario", "probes/s", "cpu us/probe", "open");
+    for (const netlens::IoBackend backend : { netlens::IoBackend::Asio, netlens::IoBackend::IoUring }) {
+        netlens::EngineOptions options;
+        options.threads = threads;
+        options.io_backend = backend;
+        netlens::Scanner scanner(options);
+
+        for (const Scenario& scenario : scenarios) {
+            netlens::ScanSettings settings;
+            settings.start_ip = "127.2.0.0";
+            settings.end_ip = "127.2." + std::to_string((hosts - 1) / 256) + "." + std::to_string((hosts - 1) % 256);
+            settings.ports = scenario.ports;
+            settings.timeout_ms = 2000;
+            settings.max_concurrency = 512;
+            settings.adaptive_concurrency = false;
+
+            double best_rate = 0.0;
+            double best_cpu = 0.0;
+            size_t open = 0;
+            for (int run = 0; run < runs; ++run) {
+                const double cpu_before = cpuSeconds();
+                const auto started = std::chrono::steady_clock::now();
+                const netlens::ScanSummary summary = scanner.scanStream(settings, [](netlens::HostResult&&) {});
+                const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+                const double cpu = cpuSeconds() - cpu_before;
+
+                const double probes = static_cast<double>(summary.total_hosts * settings.ports.size());
+                if (probes / seconds > best_rate) {
+                    best_rate = probes / seconds;
+                    best_cpu = cpu / probes * 1e6;
+                }
+                open = summary.open_ports;
+            }
+            std::printf("%-8s %-8s %12.0f %14.2f %10zu\n",
+                        backend == netlens::IoBackend::Asio ? "asio" : "io_uring",
+                        scenario.name, best_rate, best_cpu, open);
+        }
+    }
+
+    kill(child, SIGTERM);
+    waitpid(child, nullptr, 0);
+    return 0;
+}
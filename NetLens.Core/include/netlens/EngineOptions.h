@@ -0,0 +1,75 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+namespace netlens {
+
+class SimulatedNetwork;
+
+/// <summary>
+/// How the connect engine drives its sockets.
+/// </summary>
+enum class IoBackend {
+    /// Asio's reactor (epoll, IOCP, kqueue); available everywhere
+    Asio,
+    /// io_uring on Linux 5.19 and later: each probe's connect and banner
+    /// read are submitted with their deadline as linked operations on a
+    /// descriptor that never enters the process's file table. Where the
+    /// kernel or its policy does not allow io_uring, the shard falls back
+    /// to Asio, as do ICMP echo probes.
+    IoUring
+};
+
+/// <summary>
+/// Execution settings of a Scanner's engines, fixed for the Scanner's
+/// lifetime. The connect engine runs one shard per thread: an io_context
+/// served by that thread alone, which owns a slice of each scan's targets
+/// and its share of the in-flight window. Shards that run out of targets
+/// steal blocks of hosts from busy ones.
+/// </summary>
+struct EngineOptions {
+    /// <summary>
+    /// Number of io threads, and so of shards; 0 for one per hardware thread.
+    /// A scan uses at most one shard per MIN_SHARD_WINDOW probes of its
+    /// in-flight window and never more shards than it has hosts.
+    /// </summary>
+    uint32_t threads;
+
+    /// <summary>
+    /// Pin each io thread to its own core (thread i to core i, wrapping
+    /// around). Worth enabling on machines dedicated to scanning.
+    /// </summary>
+    bool pin_threads;
+
+    /// <summary>
+    /// Socket backend of the connect engine's shards.
+    /// </summary>
+    IoBackend io_backend;
+
+    /// <summary>
+    /// Simulated network the connect engine scans instead of the real one,
+    /// on a virtual clock; null to scan the real network. Overrides
+    /// io_backend. Each scan then runs on a single shard and host discovery
+    /// sends no ICMP echo. SYN scans are not simulated.
+    /// </summary>
+    std::shared_ptr<SimulatedNetwork> network;
+
+    /// <summary>
+    /// Smallest share of a scan's in-flight window given to one shard.
+    /// </summary>
+    static constexpr uint32_t MIN_SHARD_WINDOW = 16;
+
+    EngineOptions()
+        : threads(0)
+        , pin_threads(false)
+        , io_backend(IoBackend::Asio)
+        , network() {}
+};
+
+} // namespace netlens
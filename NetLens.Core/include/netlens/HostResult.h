@@ -5,12 +5,39 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include "PortResult.h"
 
 namespace netlens {
 
+/// <summary>
+/// How a host was found to be alive.
+/// </summary>
+enum class Liveness : uint8_t {
+    /// <summary>
+    /// No evidence that the host is up.
+    /// </summary>
+    None,
+
+    /// <summary>
+    /// A scanned port accepted a connection.
+    /// </summary>
+    OpenPort,
+
+    /// <summary>
+    /// The host answered an ICMP echo request during host discovery.
+    /// </summary>
+    EchoReply,
+
+    /// <summary>
+    /// The host accepted or refused a TCP ping during host discovery, or
+    /// refused every SYN of a SYN scan that it answered.
+    /// </summary>
+    TcpReply
+};
+
 /// <summary>
 /// Represents the scan results for a single host.
 /// </summary>
@@ -25,15 +52,40 @@ struct HostResult {
     /// </summary>
     bool is_alive;
 
+    /// <summary>
+    /// What established is_alive; Liveness::None for hosts that are not alive.
+    /// </summary>
+    Liveness liveness;
+
     /// <summary>
     /// Collection of port scan results for this host.
+    /// Hosts streamed by Scanner::scanStream carry only their open ports;
+    /// the others are summarized by closed_ports and filtered_ports.
     /// </summary>
     std::vector<PortResult> ports;
 
-    HostResult() : address(), is_alive(false), ports() {}
+    /// <summary>
+    /// Number of probed ports that actively refused the connection and are
+    /// not listed in ports.
+    /// </summary>
+    uint32_t closed_ports;
+
+    /// <summary>
+    /// Number of probed ports that did not answer (timed out or unreachable)
+    /// and are not listed in ports.
+    /// </summary>
+    uint32_t filtered_ports;
+
+    HostResult()
+        : address(), is_alive(false), liveness(Liveness::None), ports(), closed_ports(0), filtered_ports(0) {}
 
     HostResult(const std::string& addr, bool alive)
-        : address(addr), is_alive(alive), ports() {}
+        : address(addr)
+        , is_alive(alive)
+        , liveness(alive ? Liveness::OpenPort : Liveness::None)
+        , ports()
+        , closed_ports(0)
+        , filtered_ports(0) {}
 };
 
 } // namespace netlens
@@ -21,8 +21,20 @@ public:
     /// <param name="result">The scan result to export</param>
     /// <param name="pretty">If true, formats JSON with indentation</param>
     /// <returns>JSON string representation</returns>
+    /// <exception cref="std::invalid_argument">Thrown if a banner is not valid UTF-8</exception>
     static std::string toJson(const ScanResult& result, bool pretty = true);
 
+    /// <summary>
+    /// Serializes a ScanResult into out, replacing its contents but keeping
+    /// its capacity, so repeated exports reuse one buffer. Large host lists
+    /// are serialized in parallel slices.
+    /// </summary>
+    /// <param name="result">The scan result to export</param>
+    /// <param name="out">Buffer receiving the JSON text</param>
+    /// <param name="pretty">If true, formats JSON with indentation</param>
+    /// <exception cref="std::invalid_argument">Thrown if a banner is not valid UTF-8</exception>
+    static void toJson(const ScanResult& result, std::string& out, bool pretty = true);
+
     /// <summary>
     /// Saves a ScanResult to a JSON file.
     /// </summary>
@@ -31,6 +43,14 @@ public:
     /// <param name="pretty">If true, formats JSON with indentation</param>
     /// <returns>True if successful, false otherwise</returns>
     static bool saveToFile(const ScanResult& result, const std::string& filepath, bool pretty = true);
+
+    /// <summary>
+    /// Loads a ScanResult from a file written by saveToFile.
+    /// </summary>
+    /// <param name="filepath">Path to the JSON file</param>
+    /// <returns>The scan result, with the settings the file records</returns>
+    /// <exception cref="std::runtime_error">Thrown if the file cannot be read or is not an export</exception>
+    static ScanResult loadFromFile(const std::string& filepath);
 };
 
 } // namespace netlens
@@ -0,0 +1,105 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#pragma once
+
+#include <netlens/HostResult.h>
+#include <netlens/ScanSettings.h>
+#include <netlens/Scanner.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace netlens {
+
+/// <summary>
+/// Writes scan results as newline-delimited JSON while the scan runs.
+/// The first line records the settings, each completed host follows on its
+/// own line and a summary line closes the file:
+///   {"type":"settings", ...}
+///   {"type":"host","ip":"10.0.0.1","isAlive":true,"ports":[...], ...}
+///   {"type":"summary","totalHosts":..., ...}
+/// Lines are buffered and handed to the operating system once the buffer
+/// reaches flush_bytes, or by a thread of the writer's own once
+/// flush_interval has passed since the last flush, also when no host
+/// arrives meanwhile. The file can thus be tailed during the scan and holds
+/// every flushed host if the process dies. Intended as the sink of
+/// Scanner::scanStream. Thread-safe.
+/// </summary>
+class NdjsonWriter {
+public:
+    static constexpr size_t DEFAULT_FLUSH_BYTES = 64 * 1024;
+    static constexpr std::chrono::milliseconds DEFAULT_FLUSH_INTERVAL{ 1000 };
+
+    /// <summary>
+    /// Creates or truncates the file and writes the settings line.
+    /// </summary>
+    /// <param name="filepath">Path to the output file</param>
+    /// <param name="settings">Settings of the scan being written</param>
+    /// <param name="flush_bytes">Buffered bytes that trigger a flush</param>
+    /// <param name="flush_interval">Longest time a written host stays buffered</param>
+    /// <exception cref="std::runtime_error">Thrown if the file cannot be opened</exception>
+    NdjsonWriter(const std::string& filepath, const ScanSettings& settings,
+                 size_t flush_bytes = DEFAULT_FLUSH_BYTES,
+                 std::chrono::milliseconds flush_interval = DEFAULT_FLUSH_INTERVAL);
+
+    /// <summary>
+    /// Stops the background flush and flushes buffered hosts. A writer
+    /// destroyed without finish() leaves
+    /// a file without a summary line, which readers treat as incomplete.
+    /// </summary>
+    ~NdjsonWriter();
+
+    NdjsonWriter(const NdjsonWriter&) = delete;
+    NdjsonWriter& operator=(const NdjsonWriter&) = delete;
+
+    /// <summary>
+    /// Appends one host line.
+    /// </summary>
+    /// <exception cref="std::runtime_error">Thrown if writing to the file fails, here or in the background flush</exception>
+    void write(const HostResult& host);
+
+    /// <summary>
+    /// Writes the summary line, flushes and closes the file.
+    /// </summary>
+    /// <exception cref="std::runtime_error">Thrown if writing to the file fails, here or in the background flush</exception>
+    void finish(const ScanSummary& summary);
+
+    /// <summary>
+    /// Hands buffered lines to the operating system.
+    /// </summary>
+    /// <exception cref="std::runtime_error">Thrown if writing to the file fails, here or in the background flush</exception>
+    void flush();
+
+    /// <summary>
+    /// Number of host lines written so far.
+    /// </summary>
+    size_t hostsWritten() const;
+
+private:
+    void run();
+    void stopFlusher();
+    void flushLocked();
+
+    const size_t m_flush_bytes;
+    const std::chrono::milliseconds m_flush_interval;
+
+    mutable std::mutex m_mutex;         // Guards the members below
+    std::condition_variable m_wake;
+    std::ofstream m_file;
+    std::string m_buffer;
+    std::chrono::steady_clock::time_point m_last_flush;
+    size_t m_hosts_written;
+    bool m_stopping;
+    std::exception_ptr m_error;         // First failure of the background flush
+    std::thread m_flusher;
+};
+
+} // namespace netlens
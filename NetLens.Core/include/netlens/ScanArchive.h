@@ -0,0 +1,139 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#pragma once
+
+#include <netlens/ScanResult.h>
+#include <netlens/ScanResultStore.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace netlens {
+
+/// <summary>
+/// Writes scan results in the binary archive format and converts between
+/// archives and JsonExporter output.
+///
+/// An archive is a fixed header, a section directory and 8-byte aligned
+/// sections: the settings, one column per host field (addresses sorted
+/// ascending), one column per open-port field and the banner pool. Every
+/// column is a plain little-endian array, so a reader maps the file and
+/// indexes the columns in place.
+/// </summary>
+class ScanArchive {
+public:
+    /// <summary>
+    /// Writes a compact result store to an archive.
+    /// </summary>
+    /// <param name="store">Results to write; hosts need not be sorted</param>
+    /// <param name="filepath">Path to the output archive</param>
+    /// <exception cref="std::runtime_error">Thrown if the file cannot be written</exception>
+    static void save(const ScanResultStore& store, const std::string& filepath);
+
+    /// <summary>
+    /// Writes a ScanResult to an archive. Host addresses must be dotted IPv4.
+    /// </summary>
+    /// <exception cref="std::runtime_error">Thrown if the file cannot be written or an address is invalid</exception>
+    static void save(const ScanResult& result, const std::string& filepath);
+
+    /// <summary>
+    /// Returns true if the file starts with the archive signature.
+    /// </summary>
+    static bool isArchive(const std::string& filepath);
+
+    /// <summary>
+    /// Converts a file written by JsonExporter into an archive.
+    /// </summary>
+    /// <returns>True if successful, false otherwise</returns>
+    static bool fromJsonFile(const std::string& json_path, const std::string& archive_path);
+
+    /// <summary>
+    /// Converts an archive into JsonExporter output.
+    /// </summary>
+    /// <returns>True if successful, false otherwise</returns>
+    static bool toJsonFile(const std::string& archive_path, const std::string& json_path, bool pretty = true);
+};
+
+/// <summary>
+/// Read-only view of a scan archive. The file is memory-mapped and queried
+/// in place: opening an archive reads its header and directory and checks
+/// the port and banner indexes once, and a host lookup then touches a
+/// handful of pages. Views returned by the reader stay valid while it is
+/// alive.
+/// </summary>
+class ScanArchiveReader {
+public:
+    /// <summary>
+    /// Maps an archive and validates its layout, so that no later query on
+    /// a corrupt archive reads outside the mapping.
+    /// </summary>
+    /// <exception cref="std::runtime_error">Thrown if the file cannot be mapped or is not a valid archive</exception>
+    explicit ScanArchiveReader(const std::string& filepath);
+    ~ScanArchiveReader();
+
+    ScanArchiveReader(const ScanArchiveReader&) = delete;
+    ScanArchiveReader& operator=(const ScanArchiveReader&) = delete;
+    ScanArchiveReader(ScanArchiveReader&&) noexcept;
+    ScanArchiveReader& operator=(ScanArchiveReader&&) noexcept;
+
+    /// <summary>
+    /// The settings used for the scan.
+    /// </summary>
+    const ScanSettings& settings() const;
+
+    size_t hostCount() const;
+    size_t openPortCount() const;
+
+    /// <summary>
+    /// Host at the given index, in address order.
+    /// </summary>
+    CompactHost hostAt(size_t index) const;
+
+    /// <summary>
+    /// Port numbers of the host's open ports, ascending.
+    /// </summary>
+    std::span<const uint16_t> openPorts(size_t index) const;
+
+    /// <summary>
+    /// Banner ids of the host's open ports, parallel to openPorts.
+    /// </summary>
+    std::span<const BannerId> openPortBanners(size_t index) const;
+
+    /// <summary>
+    /// Returns the banner for an id, or an empty view for 0 or unknown ids.
+    /// </summary>
+    std::string_view banner(BannerId id) const;
+
+    /// <summary>
+    /// Looks up a host by address (binary search over the address column).
+    /// </summary>
+    std::optional<size_t> findHost(uint32_t address) const;
+
+    /// <summary>
+    /// Legacy view of one host: every probed port, in settings order.
+    /// </summary>
+    HostResult host(size_t index) const;
+
+    /// <summary>
+    /// Copies the archive into a result store.
+    /// </summary>
+    ScanResultStore toStore() const;
+
+    /// <summary>
+    /// Legacy view of the whole scan.
+    /// </summary>
+    ScanResult toScanResult() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace netlens
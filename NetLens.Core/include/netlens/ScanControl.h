@@ -0,0 +1,102 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <utility>
+#include <vector>
+
+namespace netlens {
+
+/// <summary>
+/// Cancels, pauses and resumes a running scan from any thread.
+/// Cancelling closes the scan's pending connects and timers at once; the
+/// scan call then returns the hosts completed so far. Pausing closes the
+/// connects in flight as well, but their probes are sent again on resume,
+/// so no result is lost. One control may be passed to several scans in
+/// turn; a cancelled control stays cancelled.
+/// </summary>
+class ScanControl {
+public:
+    /// <summary>
+    /// Receives the new state each time the scan is paused (true) or resumed (false).
+    /// </summary>
+    using PauseListener = std::function<void(bool paused)>;
+
+    /// <summary>
+    /// Creates a control cancelled only through cancel().
+    /// </summary>
+    ScanControl();
+
+    /// <summary>
+    /// Creates a control that is also cancelled when the given token is
+    /// stopped, e.g. the token of the std::jthread running the scan.
+    /// </summary>
+    explicit ScanControl(std::stop_token stopToken);
+
+    ~ScanControl();
+
+    // Listeners and the stop callback refer to this object
+    ScanControl(const ScanControl&) = delete;
+    ScanControl& operator=(const ScanControl&) = delete;
+
+    /// <summary>
+    /// Requests cancellation. Safe to call more than once.
+    /// </summary>
+    void cancel();
+
+    /// <summary>
+    /// True once cancellation was requested.
+    /// </summary>
+    bool cancelled() const { return m_stop.stop_requested(); }
+
+    /// <summary>
+    /// Token stopped on cancellation, for use with std::stop_callback.
+    /// </summary>
+    std::stop_token stopToken() const { return m_stop.get_token(); }
+
+    /// <summary>
+    /// Pauses the scan. Has no effect if already paused.
+    /// </summary>
+    void pause();
+
+    /// <summary>
+    /// Resumes a paused scan. Has no effect if not paused.
+    /// </summary>
+    void resume();
+
+    bool paused() const;
+
+    /// <summary>
+    /// Registers a listener for pause and resume, used by the scan engines.
+    /// The listener is called at once with the current state, and later on
+    /// the thread calling pause or resume. It must not call back into the
+    /// control.
+    /// </summary>
+    /// <returns>Id to pass to removePauseListener</returns>
+    size_t addPauseListener(PauseListener listener);
+
+    /// <summary>
+    /// Unregisters a listener. Once this returns the listener is not running
+    /// and will not be called again.
+    /// </summary>
+    void removePauseListener(size_t id);
+
+private:
+    std::stop_source m_stop;
+    std::optional<std::stop_callback<std::function<void()>>> m_forward;
+
+    mutable std::mutex m_mutex;
+    bool m_paused;
+    size_t m_next_listener;
+    std::vector<std::pair<size_t, PauseListener>> m_listeners;
+};
+
+} // namespace netlens
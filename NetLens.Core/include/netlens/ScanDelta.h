@@ -0,0 +1,167 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#pragma once
+
+#include <netlens/ScanResultStore.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace netlens {
+
+/// <summary>
+/// How a delta scan treats ranges the baseline found dead: subnets in which
+/// every baseline host was down.
+/// </summary>
+enum class DeadRangePolicy {
+    /// <summary>
+    /// Probe dead ranges like any other.
+    /// </summary>
+    Probe,
+
+    /// <summary>
+    /// Probe dead ranges after everything else, so changes in live ranges
+    /// are found first.
+    /// </summary>
+    Deprioritize,
+
+    /// <summary>
+    /// Probe a sample of each dead range after everything else. A range in
+    /// which a sampled host answers is then probed in full.
+    /// </summary>
+    Sample
+};
+
+/// <summary>
+/// Options of a delta scan.
+/// </summary>
+struct DeltaOptions {
+    /// <summary>
+    /// Treatment of ranges the baseline found dead.
+    /// </summary>
+    DeadRangePolicy dead_ranges;
+
+    /// <summary>
+    /// Prefix length of the subnets judged dead or live as a whole.
+    /// </summary>
+    uint8_t range_prefix;
+
+    /// <summary>
+    /// Share of each dead range's hosts probed under Sample; at least one
+    /// host per range is always probed.
+    /// </summary>
+    double sample_ratio;
+
+    DeltaOptions()
+        : dead_ranges(DeadRangePolicy::Deprioritize)
+        , range_prefix(24)
+        , sample_ratio(0.1) {}
+};
+
+/// <summary>
+/// Kind of difference between a baseline and a rescan.
+/// </summary>
+enum class ChangeKind {
+    /// <summary>
+    /// Host is alive now but was down or absent in the baseline.
+    /// </summary>
+    HostAppeared,
+
+    /// <summary>
+    /// Host was alive in the baseline and is down now.
+    /// </summary>
+    HostVanished,
+
+    PortOpened,
+    PortClosed,
+
+    /// <summary>
+    /// Port is open in both scans with different, non-empty banners.
+    /// </summary>
+    BannerChanged
+};
+
+/// <summary>
+/// One difference between a baseline and a rescan.
+/// </summary>
+struct ScanChange {
+    ChangeKind kind;
+    std::string address;
+
+    /// <summary>
+    /// Port concerned; 0 for host changes.
+    /// </summary>
+    uint16_t port;
+
+    /// <summary>
+    /// Banner in the baseline (PortClosed, BannerChanged).
+    /// </summary>
+    std::string previous_banner;
+
+    /// <summary>
+    /// Banner now (PortOpened, BannerChanged).
+    /// </summary>
+    std::string banner;
+
+    ScanChange()
+        : kind(ChangeKind::HostAppeared), address(), port(0), previous_banner(), banner() {}
+};
+
+/// <summary>
+/// Result of a delta scan. Only ports probed by both the baseline and the
+/// rescan are compared.
+/// </summary>
+struct ScanDelta {
+    /// <summary>
+    /// Changes ordered by address, host changes before port changes.
+    /// </summary>
+    std::vector<ScanChange> changes;
+
+    size_t hosts_scanned;
+
+    /// <summary>
+    /// Hosts in dead ranges left unprobed by sampling. They are assumed
+    /// unchanged and produce no changes.
+    /// </summary>
+    size_t hosts_skipped;
+
+    /// <summary>
+    /// True if the scan was cancelled; only the hosts scanned before that
+    /// were compared.
+    /// </summary>
+    bool cancelled;
+
+    ScanDelta()
+        : changes(), hosts_scanned(0), hosts_skipped(0), cancelled(false) {}
+};
+
+/// <summary>
+/// Results of an earlier scan that a delta scan compares against.
+/// </summary>
+class ScanBaseline {
+public:
+    /// <summary>
+    /// Uses results already in memory.
+    /// </summary>
+    explicit ScanBaseline(ScanResultStore results);
+
+    /// <summary>
+    /// Loads a ScanArchive or a JsonExporter file; the format is detected.
+    /// </summary>
+    /// <exception cref="std::runtime_error">Thrown if the file cannot be read</exception>
+    static ScanBaseline load(const std::string& filepath);
+
+    /// <summary>
+    /// The baseline results, sorted by address.
+    /// </summary>
+    const ScanResultStore& results() const { return m_results; }
+
+private:
+    ScanResultStore m_results;
+};
+
+} // namespace netlens
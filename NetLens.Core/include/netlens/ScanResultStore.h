@@ -0,0 +1,163 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "ScanSettings.h"
+#include "ScanResult.h"
+
+namespace netlens {
+
+/// <summary>
+/// Identifier of a banner interned in a BannerTable. 0 means "no banner".
+/// </summary>
+using BannerId = uint32_t;
+
+/// <summary>
+/// Deduplicating string table for service banners. Thousands of hosts
+/// typically return the same SSH or HTTP banner; each distinct string is
+/// stored once and referenced by id.
+/// </summary>
+class BannerTable {
+public:
+    BannerTable();
+
+    BannerTable(const BannerTable& other);
+    BannerTable& operator=(const BannerTable& other);
+    BannerTable(BannerTable&&) noexcept = default;
+    BannerTable& operator=(BannerTable&&) noexcept = default;
+
+    /// <summary>
+    /// Returns the id of the banner, adding it if not yet present.
+    /// The empty string always maps to 0.
+    /// </summary>
+    BannerId intern(std::string_view banner);
+
+    /// <summary>
+    /// Returns the banner for an id, or an empty view for 0 or unknown ids.
+    /// </summary>
+    std::string_view get(BannerId id) const;
+
+    /// <summary>
+    /// Number of distinct banners, including the empty banner.
+    /// </summary>
+    size_t size() const { return m_strings.size(); }
+
+private:
+    // Deque keeps element addresses stable, so the index can hold views
+    std::deque<std::string> m_strings;
+    std::unordered_map<std::string_view, BannerId> m_index;
+};
+
+/// <summary>
+/// An open port in compact form.
+/// </summary>
+struct CompactPort {
+    uint16_t port;
+    BannerId banner;
+};
+
+/// <summary>
+/// A host in compact form. Only open ports are stored; closed and filtered
+/// ports are counted.
+/// </summary>
+struct CompactHost {
+    /// <summary>
+    /// IPv4 address in host byte order.
+    /// </summary>
+    uint32_t address;
+
+    /// <summary>
+    /// Index of the host's first open port in the store's port array.
+    /// </summary>
+    uint32_t first_port;
+
+    uint32_t open_count;
+    uint32_t closed_count;
+    uint32_t filtered_count;
+    bool is_alive;
+    Liveness liveness;
+};
+
+/// <summary>
+/// Compact, open-only storage for scan results. Hosts and open ports live in
+/// contiguous arrays and banners are interned in a shared BannerTable.
+/// The legacy HostResult / ScanResult views are reconstructed on demand: any
+/// probed port that is not stored as open is reported as closed.
+/// </summary>
+class ScanResultStore {
+public:
+    ScanResultStore();
+    explicit ScanResultStore(const ScanSettings& settings);
+
+    /// <summary>
+    /// The settings used for the scan.
+    /// </summary>
+    const ScanSettings& settings() const { return m_settings; }
+
+    /// <summary>
+    /// Appends a host. Only the open entries of host.ports are kept; closed
+    /// entries are folded into the closed count.
+    /// </summary>
+    /// <param name="address">IPv4 address in host byte order</param>
+    /// <param name="host">Host result to store</param>
+    void addHost(uint32_t address, const HostResult& host);
+
+    /// <summary>
+    /// Sorts hosts by address. Streaming scans deliver hosts in completion
+    /// order; sorting restores range order and enables findHost.
+    /// </summary>
+    void sortByAddress();
+
+    size_t hostCount() const { return m_hosts.size(); }
+    size_t openPortCount() const { return m_ports.size(); }
+
+    const CompactHost& hostAt(size_t index) const { return m_hosts[index]; }
+    std::span<const CompactHost> hosts() const { return m_hosts; }
+
+    /// <summary>
+    /// Open ports of the host at the given index.
+    /// </summary>
+    std::span<const CompactPort> openPorts(size_t index) const;
+
+    /// <summary>
+    /// Looks up a host by address. Requires sortByAddress.
+    /// </summary>
+    std::optional<size_t> findHost(uint32_t address) const;
+
+    const BannerTable& banners() const { return m_banners; }
+    std::string_view banner(BannerId id) const { return m_banners.get(id); }
+
+    /// <summary>
+    /// Number of hosts marked alive.
+    /// </summary>
+    size_t aliveHostCount() const;
+
+    /// <summary>
+    /// Legacy view of one host: every probed port, in settings order.
+    /// </summary>
+    HostResult host(size_t index) const;
+
+    /// <summary>
+    /// Legacy view of the whole scan.
+    /// </summary>
+    ScanResult toScanResult() const;
+
+private:
+    ScanSettings m_settings;
+    std::vector<CompactHost> m_hosts;
+    std::vector<CompactPort> m_ports;
+    BannerTable m_banners;
+};
+
+} // namespace netlens
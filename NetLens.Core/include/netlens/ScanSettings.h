@@ -11,6 +11,59 @@
 
 namespace netlens {
 
+/// <summary>
+/// How ports are probed.
+/// </summary>
+enum class ScanMode {
+    /// <summary>
+    /// Full TCP connect through the operating system's socket API, with
+    /// banner grabbing on open ports. Works everywhere without privileges.
+    /// </summary>
+    Connect,
+
+    /// <summary>
+    /// Stateless half-open SYN scan over a raw socket. Linux only; requires
+    /// CAP_NET_RAW. No banners are captured.
+    /// </summary>
+    Syn
+};
+
+/// <summary>
+/// Order in which (host, port) probes are sent.
+/// </summary>
+enum class ProbeOrder {
+    /// <summary>
+    /// Hosts in address order, each host's ports in the order given.
+    /// </summary>
+    Sequential,
+
+    /// <summary>
+    /// Hosts in a keyed pseudo-random order over the whole target set, each
+    /// host's ports in its own pseudo-random order, with consecutive probes
+    /// rotating across many hosts. No host or subnet sees a burst, and the
+    /// order is reproducible from random_seed.
+    /// </summary>
+    Random
+};
+
+/// <summary>
+/// Whether hosts are checked for liveness before their ports are swept.
+/// </summary>
+enum class HostDiscovery {
+    /// <summary>
+    /// Treat every host as up and sweep all of its ports.
+    /// </summary>
+    AssumeUp,
+
+    /// <summary>
+    /// Ping each host first (ICMP echo where unprivileged echo sockets are
+    /// available, plus TCP connects to discovery_ports) and sweep only hosts
+    /// that answer. Ports of silent hosts are not probed and are counted as
+    /// filtered.
+    /// </summary>
+    Ping
+};
+
 /// <summary>
 /// Configuration settings for a network scan operation.
 /// </summary>
@@ -25,27 +78,154 @@ struct ScanSettings {
     /// </summary>
     std::string end_ip;
 
+    /// <summary>
+    /// Additional targets, in any mix of CIDR blocks ("10.0.0.0/8"), ranges
+    /// ("10.0.0.1-10.0.0.50" or "10.0.0.1-50") and single addresses.
+    /// Combined with start_ip/end_ip when those are set; overlaps are scanned once.
+    /// </summary>
+    std::vector<std::string> targets;
+
+    /// <summary>
+    /// Addresses never to probe, in the same forms as targets.
+    /// </summary>
+    std::vector<std::string> excludes;
+
     /// <summary>
     /// List of ports to scan on each host.
     /// </summary>
     std::vector<uint16_t> ports;
 
     /// <summary>
-    /// Connection timeout in milliseconds.
+    /// Connection timeout in milliseconds. With adaptive_timeout this is the
+    /// upper bound; otherwise every probe waits this long.
     /// </summary>
     uint32_t timeout_ms;
 
     /// <summary>
-    /// Maximum number of concurrent scan operations.
+    /// Derive each probe's timeout from round-trip times measured on
+    /// accepted and refused connects (smoothed RTT plus variance, as in
+    /// TCP's retransmission timer), per host, falling back to the host's /24
+    /// and then to the whole scan.
+    /// </summary>
+    bool adaptive_timeout;
+
+    /// <summary>
+    /// Maximum number of outstanding connection attempts across the whole scan.
+    /// The engine refills this window as probes complete; 0 selects the engine default.
+    /// With adaptive_concurrency this is the upper bound of the window.
     /// </summary>
     uint32_t max_concurrency;
 
+    /// <summary>
+    /// Lower bound of the adaptive window; 0 selects the engine default.
+    /// </summary>
+    uint32_t min_concurrency;
+
+    /// <summary>
+    /// Size the in-flight window from observed loss (AIMD): it grows while
+    /// probes are answered and is halved when timeouts or refusals rise
+    /// sharply or the local stack runs out of sockets or buffers.
+    /// </summary>
+    bool adaptive_concurrency;
+
+    /// <summary>
+    /// Hard ceiling on probes sent per second over the whole scan, counting
+    /// discovery pings; 0 for no limit. Applies on top of the window.
+    /// </summary>
+    uint32_t max_rate;
+
+    /// <summary>
+    /// Ceiling on probes sent per second into any one subnet of
+    /// rate_subnet_prefix bits; 0 for no limit.
+    /// </summary>
+    uint32_t max_subnet_rate;
+
+    /// <summary>
+    /// Prefix length of the subnets max_subnet_rate applies to.
+    /// </summary>
+    uint8_t rate_subnet_prefix;
+
+    /// <summary>
+    /// Maximum number of hosts held in memory at once, either in progress or
+    /// completed and awaiting delivery to a streaming consumer. New hosts are
+    /// not started while the buffer is full; 0 derives a bound from max_concurrency.
+    /// </summary>
+    uint32_t max_buffered_hosts;
+
+    /// <summary>
+    /// Probe transport used for the scan.
+    /// </summary>
+    ScanMode scan_mode;
+
+    /// <summary>
+    /// Order in which probes are sent.
+    /// </summary>
+    ProbeOrder probe_order;
+
+    /// <summary>
+    /// Seed of the Random probe order; 0 picks a fresh seed for each scan.
+    /// </summary>
+    uint64_t random_seed;
+
+    /// <summary>
+    /// Host discovery stage run before each host's port sweep (connect mode).
+    /// </summary>
+    HostDiscovery host_discovery;
+
+    /// <summary>
+    /// Ports tried by TCP pings during host discovery. A refused connect
+    /// counts as an answer as much as an accepted one.
+    /// </summary>
+    std::vector<uint16_t> discovery_ports;
+
+    /// <summary>
+    /// Also send an ICMP echo request during host discovery. Uses Linux
+    /// unprivileged echo sockets (net.ipv4.ping_group_range); skipped where
+    /// they are unavailable.
+    /// </summary>
+    bool discovery_echo;
+
+    /// <summary>
+    /// Journal file recording each completed host as the scan runs; empty
+    /// for none. If the file already holds a journal of the same targets,
+    /// ports and probing mode, its hosts are delivered from the journal and
+    /// only the remaining hosts are scanned, so an interrupted scan resumes
+    /// where it stopped. Writes are synced to disk in batches, so a crash
+    /// loses at most the last second or so of hosts, which are scanned again.
+    /// The journal is deleted once the scan runs to completion and kept if
+    /// it is cancelled or fails.
+    /// </summary>
+    std::string journal_path;
+
+    /// <summary>
+    /// Interval between progress snapshots in milliseconds; 0 selects the
+    /// engine default.
+    /// </summary>
+    uint32_t progress_interval_ms;
+
     ScanSettings()
         : start_ip()
         , end_ip()
+        , targets()
+        , excludes()
         , ports()
         , timeout_ms(1000)
-        , max_concurrency(100) {}
+        , adaptive_timeout(true)
+        , max_concurrency(100)
+        , min_concurrency(0)
+        , adaptive_concurrency(true)
+        , max_rate(0)
+        , max_subnet_rate(0)
+        , rate_subnet_prefix(24)
+        , max_buffered_hosts(0)
+        , scan_mode(ScanMode::Connect)
+        , probe_order(ProbeOrder::Sequential)
+        , random_seed(0)
+        , host_discovery(HostDiscovery::AssumeUp)
+        , discovery_ports{ 80, 443, 22, 445, 3389 }
+        , discovery_echo(true)
+        , journal_path()
+        , progress_interval_ms(0) {}
 };
 
 } // namespace netlens
@@ -7,12 +7,19 @@
 
 #include "ScanSettings.h"
 #include "ScanResult.h"
+#include "ScanResultStore.h"
+#include "ScanDelta.h"
+#include "ScanControl.h"
+#include "EngineOptions.h"
 #include <functional>
+#include <memory>
 
 namespace netlens {
 
 /// <summary>
-/// Progress information for an ongoing scan.
+/// Progress information for an ongoing scan. Snapshots are coalesced: they
+/// arrive every ScanSettings::progress_interval_ms while hosts complete, on
+/// a reporting thread of their own, plus once at the end of the scan.
 /// </summary>
 struct ScanProgress {
     size_t total_hosts;
@@ -21,12 +28,77 @@ struct ScanProgress {
     size_t total_ports;
     size_t completed_ports;
 
+    /// <summary>
+    /// Current in-flight window and the probes outstanding in it.
+    /// </summary>
+    size_t window;
+    size_t in_flight;
+
+    /// <summary>
+    /// Probes that timed out, were refused, or failed for lack of local
+    /// resources (sockets, buffers), and how often the window was cut.
+    /// </summary>
+    size_t timeouts;
+    size_t refusals;
+    size_t local_errors;
+    size_t window_decreases;
+
+    /// <summary>
+    /// Probes sent per second, smoothed over about the last second.
+    /// </summary>
+    double probe_rate;
+
+    /// <summary>
+    /// Hosts and ports completed per second, smoothed over about the last second.
+    /// </summary>
+    double host_rate;
+    double port_rate;
+
+    /// <summary>
+    /// Time since the scan started, and the estimated time until it
+    /// completes at the current port rate (negative while unknown).
+    /// </summary>
+    double elapsed_seconds;
+    double eta_seconds;
+
     ScanProgress()
         : total_hosts(0)
         , completed_hosts(0)
         , current_ip()
         , total_ports(0)
-        , completed_ports(0) {}
+        , completed_ports(0)
+        , window(0)
+        , in_flight(0)
+        , timeouts(0)
+        , refusals(0)
+        , local_errors(0)
+        , window_decreases(0)
+        , probe_rate(0.0)
+        , host_rate(0.0)
+        , port_rate(0.0)
+        , elapsed_seconds(0.0)
+        , eta_seconds(-1.0) {}
+};
+
+/// <summary>
+/// Totals for a completed streaming scan.
+/// </summary>
+struct ScanSummary {
+    size_t total_hosts;
+    size_t alive_hosts;
+    size_t open_ports;
+
+    /// <summary>
+    /// True if the scan was cancelled; the totals cover the hosts completed
+    /// before that.
+    /// </summary>
+    bool cancelled;
+
+    ScanSummary()
+        : total_hosts(0)
+        , alive_hosts(0)
+        , open_ports(0)
+        , cancelled(false) {}
 };
 
 /// <summary>
@@ -34,21 +106,40 @@ struct ScanProgress {
 /// </summary>
 using ProgressCallback = std::function<void(const ScanProgress&)>;
 
+/// <summary>
+/// Callback function type receiving each host as soon as it completes.
+/// The host lists only its open ports; closed and filtered ports are counted.
+/// </summary>
+using HostResultCallback = std::function<void(HostResult&& host)>;
+
 /// <summary>
 /// Main scanner class responsible for executing network scans.
+/// The scan engines, with their io threads and sockets layer, are created
+/// on first use and kept for the lifetime of the Scanner, so repeated small
+/// scans do not pay for their setup. Scans may be run concurrently on one
+/// Scanner from different threads.
 /// </summary>
 class Scanner {
 public:
     /// <summary>
-    /// Constructs a new Scanner instance.
+    /// Constructs a new Scanner instance with the default engine options.
     /// </summary>
     Scanner();
 
     /// <summary>
-    /// Destroys the Scanner instance.
+    /// Constructs a new Scanner instance whose engines run with the given options.
+    /// </summary>
+    /// <param name="options">Thread count and pinning of the engines.</param>
+    explicit Scanner(const EngineOptions& options);
+
+    /// <summary>
+    /// Destroys the Scanner instance and its engines. No scan may be running.
     /// </summary>
     ~Scanner();
 
+    Scanner(const Scanner&) = delete;
+    Scanner& operator=(const Scanner&) = delete;
+
     /// <summary>
     /// Performs a network scan based on the provided settings.
     /// </summary>
@@ -61,8 +152,59 @@ public:
     /// </summary>
     /// <param name="settings">Scan configuration settings.</param>
     /// <param name="progressCallback">Callback for progress updates.</param>
-    /// <returns>Scan results.</returns>
-    ScanResult scan(const ScanSettings& settings, ProgressCallback progressCallback);
+    /// <param name="control">Optional control to cancel or pause the scan.</param>
+    /// <returns>Scan results; after a cancel, the hosts completed before it.</returns>
+    ScanResult scan(const ScanSettings& settings, ProgressCallback progressCallback,
+                    ScanControl* control = nullptr);
+
+    /// <summary>
+    /// Performs a network scan and returns the results in compact form:
+    /// open ports only, closed/filtered counts and interned banners.
+    /// </summary>
+    /// <param name="settings">Scan configuration settings.</param>
+    /// <param name="progressCallback">Optional callback for progress updates.</param>
+    /// <param name="control">Optional control to cancel or pause the scan.</param>
+    /// <returns>Compact scan results, sorted by address; after a cancel, the hosts completed before it.</returns>
+    ScanResultStore scanCompact(const ScanSettings& settings, ProgressCallback progressCallback = nullptr,
+                                ScanControl* control = nullptr);
+
+    /// <summary>
+    /// Performs a network scan, handing out each host as soon as it completes
+    /// instead of materializing the whole result. Hosts arrive in completion
+    /// order on the calling thread. While the callback is busy the scan keeps
+    /// at most ScanSettings::max_buffered_hosts hosts in memory and stops
+    /// starting new ones, so memory stays flat regardless of range size.
+    /// </summary>
+    /// <param name="settings">Scan configuration settings.</param>
+    /// <param name="hostCallback">Receives each completed host.</param>
+    /// <param name="progressCallback">Optional callback for progress updates.</param>
+    /// <param name="control">Optional control to cancel or pause the scan.</param>
+    /// <returns>Totals for the scan.</returns>
+    ScanSummary scanStream(const ScanSettings& settings, HostResultCallback hostCallback,
+                           ProgressCallback progressCallback = nullptr, ScanControl* control = nullptr);
+
+    /// <summary>
+    /// Rescans and reports only what changed since a baseline: hosts that
+    /// appeared or vanished, ports that opened or closed and changed
+    /// banners. Ranges the baseline found dead are probed last or sampled,
+    /// as the options select. Each pass is a separate engine run, so
+    /// progress restarts per pass; with a journal, passes after the first
+    /// journal to journal_path with the pass number appended, and all of
+    /// them are deleted once the last pass completes.
+    /// </summary>
+    /// <param name="settings">Scan configuration settings.</param>
+    /// <param name="baseline">Results to compare against.</param>
+    /// <param name="options">Treatment of dead ranges.</param>
+    /// <param name="progressCallback">Optional callback for progress updates.</param>
+    /// <param name="control">Optional control to cancel or pause the scan; a cancel skips the remaining passes.</param>
+    /// <returns>The changes, ordered by address.</returns>
+    ScanDelta scanDelta(const ScanSettings& settings, const ScanBaseline& baseline,
+                        const DeltaOptions& options = DeltaOptions(),
+                        ProgressCallback progressCallback = nullptr, ScanControl* control = nullptr);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
 };
 
 } // namespace netlens
@@ -0,0 +1,205 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace netlens {
+
+namespace internal {
+class NetworkModel;
+class SimulatedTransport;
+}
+
+/// <summary>
+/// Shape of the round-trip times a simulated host answers with.
+/// </summary>
+enum class LatencyDistribution {
+    /// <summary>Always rtt_ms.</summary>
+    Constant,
+    /// <summary>Uniform over rtt_ms ± spread_ms.</summary>
+    Uniform,
+    /// <summary>Normal with mean rtt_ms and standard deviation spread_ms, cut at zero.</summary>
+    Normal,
+    /// <summary>
+    /// Log-normal with mean rtt_ms, skewed by spread_ms: a long tail of slow
+    /// answers, as on real paths.
+    /// </summary>
+    LogNormal
+};
+
+/// <summary>
+/// Round-trip time of a simulated host.
+/// </summary>
+struct LatencyModel {
+    LatencyDistribution distribution;
+    double rtt_ms;
+    double spread_ms;
+
+    LatencyModel(LatencyDistribution shape = LatencyDistribution::Constant, double rtt = 20.0, double spread = 0.0)
+        : distribution(shape)
+        , rtt_ms(rtt)
+        , spread_ms(spread) {}
+};
+
+/// <summary>
+/// How a simulated host answers a connect to one of its ports.
+/// </summary>
+enum class PortState {
+    /// <summary>Accepted; the banner, if any, follows.</summary>
+    Open,
+    /// <summary>Refused with a reset.</summary>
+    Closed,
+    /// <summary>Dropped: the connect times out.</summary>
+    Filtered
+};
+
+/// <summary>
+/// Behaviour of the hosts of a simulated address range.
+/// </summary>
+struct SimulatedHost {
+    /// <summary>
+    /// Ports that accept connects.
+    /// </summary>
+    std::vector<uint16_t> open_ports;
+
+    /// <summary>
+    /// Ports whose connects are dropped.
+    /// </summary>
+    std::vector<uint16_t> filtered_ports;
+
+    /// <summary>
+    /// State of every port in neither list.
+    /// </summary>
+    PortState other_ports;
+
+    /// <summary>
+    /// What open ports send back, after the scanner's request if it sends
+    /// one. An open port without an entry accepts and stays silent.
+    /// </summary>
+    std::map<uint16_t, std::string> banners;
+
+    LatencyModel latency;
+
+    /// <summary>
+    /// Probability, from 0 to 1, that a connect or its answer is lost.
+    /// </summary>
+    double loss;
+
+    /// <summary>
+    /// Connects per second a firewall in front of the range lets through,
+    /// over all of its hosts; the rest are dropped. 0 for no firewall.
+    /// </summary>
+    double firewall_rate;
+
+    /// <summary>
+    /// Connects the firewall lets through back to back after a quiet spell.
+    /// </summary>
+    double firewall_burst;
+
+    /// <summary>
+    /// Accept a connect on every port and never send anything, holding each
+    /// connection until the scanner gives up on it.
+    /// </summary>
+    bool tarpit;
+
+    SimulatedHost()
+        : open_ports()
+        , filtered_ports()
+        , other_ports(PortState::Closed)
+        , banners()
+        , latency()
+        , loss(0.0)
+        , firewall_rate(0.0)
+        , firewall_burst(1.0)
+        , tarpit(false) {}
+};
+
+/// <summary>
+/// What a simulated network was asked and how it answered, over all scans.
+/// </summary>
+struct SimulationStats {
+    uint64_t connects = 0;
+    uint64_t accepted = 0;
+    uint64_t refused = 0;
+
+    /// <summary>
+    /// Connects to addresses without hosts or to filtered ports.
+    /// </summary>
+    uint64_t dropped = 0;
+
+    uint64_t lost = 0;
+
+    /// <summary>
+    /// Connects a firewall dropped for exceeding its rate.
+    /// </summary>
+    uint64_t rate_limited = 0;
+
+    uint64_t banners = 0;
+
+    /// <summary>
+    /// Virtual time that passed on the network's clocks.
+    /// </summary>
+    std::chrono::nanoseconds virtual_time{0};
+};
+
+/// <summary>
+/// A network that exists only in memory, for the connect engine to scan
+/// instead of the real one (see EngineOptions::network). Ranges of hosts are
+/// described by their open, closed and filtered ports, banners, latency,
+/// loss, rate-limiting firewalls and tarpits; addresses outside every range
+/// have no host and never answer.
+///
+/// Nothing is sent on the wire and no time is spent waiting: each engine
+/// thread keeps a virtual clock that jumps to the next answer or deadline
+/// as soon as the engine has nothing else to do, so a scan of millions of
+/// probes with second-long timeouts runs in the time its CPU work takes.
+/// A scan of a simulated network runs on one engine thread, and latency
+/// and loss are drawn from the seed, address and port, so a scan in
+/// Sequential or seeded Random order yields the same results and the same
+/// virtual duration every time, provided its consumer keeps up with the
+/// result buffer.
+///
+/// Ranges are set up before scanning; addHosts may not be called while a
+/// scan runs.
+/// </summary>
+class SimulatedNetwork {
+public:
+    /// <summary>
+    /// Creates an empty network.
+    /// </summary>
+    /// <param name="seed">Seed of the latency and loss draws</param>
+    explicit SimulatedNetwork(uint64_t seed = 1);
+
+    ~SimulatedNetwork();
+
+    SimulatedNetwork(const SimulatedNetwork&) = delete;
+    SimulatedNetwork& operator=(const SimulatedNetwork&) = delete;
+
+    /// <summary>
+    /// Places hosts on every address of a target specification (a CIDR
+    /// block, a range or a single address). Where ranges overlap, the one
+    /// added last wins.
+    /// </summary>
+    /// <exception cref="std::runtime_error">Thrown if the specification is invalid</exception>
+    void addHosts(const std::string& spec, const SimulatedHost& host);
+
+    uint64_t seed() const;
+
+    SimulationStats stats() const;
+
+private:
+    friend class internal::SimulatedTransport;
+
+    std::shared_ptr<internal::NetworkModel> m_model;
+};
+
+} // namespace netlens
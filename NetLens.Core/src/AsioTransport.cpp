@@ -0,0 +1,132 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "AsioTransport.h"
+#include <limits>
+
+namespace netlens::internal {
+
+AsioTransport::AsioTransport(asio::io_context& io)
+    : m_io(io) {}
+
+std::unique_ptr<Transport::Timer> AsioTransport::makeTimer() {
+    return std::make_unique<AsioTimer>(m_io);
+}
+
+size_t AsioTransport::freeSlots() const {
+    return std::numeric_limits<size_t>::max();
+}
+
+void AsioTransport::reserveSlots(size_t slots) {
+    while (m_free.size() < slots) {
+        m_free.push_back(static_cast<uint32_t>(m_slots.size()));
+        m_slots.emplace_back(m_io);
+    }
+    m_free.reserve(m_slots.size());
+}
+
+uint32_t AsioTransport::connect(Handler& handler, uint32_t address, uint16_t port, uint32_t timeout_ms) {
+    uint32_t slot;
+    if (m_free.empty()) {
+        slot = static_cast<uint32_t>(m_slots.size());
+        m_slots.emplace_back(m_io);
+    } else {
+        slot = m_free.back();
+        m_free.pop_back();
+    }
+    Connection& connection = m_slots[slot];
+    connection.handler = &handler;
+
+    // The socket was closed by the slot's last user and reopens here
+    armDeadline(connection, timeout_ms);
+    connection.socket.async_connect(
+        asio::ip::tcp::endpoint(asio::ip::address_v4(address), port),
+        [&connection, generation = connection.generation](const asio::error_code& ec) {
+            if (generation != connection.generation) {
+                return;
+            }
+            disarmDeadline(connection);
+            connection.handler->onConnect(outcome(connection, ec));
+        });
+    return slot;
+}
+
+void AsioTransport::exchange(uint32_t slot, std::string_view request, char* buffer, size_t size,
+                             uint32_t timeout_ms) {
+    Connection& connection = m_slots[slot];
+    armDeadline(connection, timeout_ms);
+    if (request.empty()) {
+        read(connection, buffer, size);
+        return;
+    }
+
+    asio::async_write(connection.socket, asio::buffer(request.data(), request.size()),
+        [&connection, generation = connection.generation, buffer, size](const asio::error_code& ec, size_t) {
+            if (generation != connection.generation) {
+                return;
+            }
+            if (ec) {
+                disarmDeadline(connection);
+                connection.handler->onReceive(outcome(connection, ec), 0);
+                return;
+            }
+            read(connection, buffer, size);
+        });
+}
+
+void AsioTransport::cancel(uint32_t slot) {
+    Connection& connection = m_slots[slot];
+    disarmDeadline(connection);
+    asio::error_code ignore_ec;
+    connection.socket.close(ignore_ec);
+}
+
+void AsioTransport::close(uint32_t slot) {
+    Connection& connection = m_slots[slot];
+    ++connection.generation;
+    disarmDeadline(connection);
+    asio::error_code ignore_ec;
+    connection.socket.close(ignore_ec);
+    connection.handler = nullptr;
+    m_free.push_back(slot);
+}
+
+void AsioTransport::armDeadline(Connection& connection, uint32_t timeout_ms) {
+    // A stale expiry from an earlier phase or an earlier user of the slot is
+    // recognized by its generation
+    const unsigned generation = ++connection.deadline_generation;
+    connection.timed_out = false;
+    connection.timer.expires_after(std::chrono::milliseconds(timeout_ms));
+    connection.timer.async_wait([&connection, generation](const asio::error_code& ec) {
+        if (!ec && generation == connection.deadline_generation) {
+            connection.timed_out = true;
+            asio::error_code ignore_ec;
+            connection.socket.close(ignore_ec);
+        }
+    });
+}
+
+void AsioTransport::disarmDeadline(Connection& connection) {
+    ++connection.deadline_generation;
+    connection.timer.cancel();
+}
+
+asio::error_code AsioTransport::outcome(const Connection& connection, const asio::error_code& ec) {
+    // The deadline closes the socket, so the operation itself only reports an abort
+    return connection.timed_out ? asio::error_code(asio::error::timed_out) : ec;
+}
+
+void AsioTransport::read(Connection& connection, char* buffer, size_t size) {
+    connection.socket.async_read_some(asio::buffer(buffer, size),
+        [&connection, generation = connection.generation](const asio::error_code& ec, size_t bytes) {
+            if (generation != connection.generation) {
+                return;
+            }
+            disarmDeadline(connection);
+            connection.handler->onReceive(outcome(connection, ec), ec ? 0 : bytes);
+        });
+}
+
+} // namespace netlens::internal
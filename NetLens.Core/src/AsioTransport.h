@@ -0,0 +1,63 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#pragma once
+
+#include "Transport.h"
+#include <deque>
+#include <vector>
+
+namespace netlens::internal {
+
+/// <summary>
+/// Transport on Asio sockets: each slot is a TCP socket and a steady_timer
+/// for its deadline, which closes the socket when it expires. Both live on
+/// the shard's io_context, which one thread serves, so the deadline and
+/// I/O handlers never race on the socket. Slots are only bounded by the
+/// descriptor limit, where connects fail with no_descriptors. A closed
+/// slot keeps its socket and timer for the next connect, so the table
+/// grows to the largest window the shard has run and then stops allocating.
+/// </summary>
+class AsioTransport : public Transport {
+public:
+    explicit AsioTransport(asio::io_context& io);
+
+    Clock::time_point now() const override { return Clock::now(); }
+    std::unique_ptr<Timer> makeTimer() override;
+    size_t freeSlots() const override;
+    void reserveSlots(size_t slots) override;
+
+    uint32_t connect(Handler& handler, uint32_t address, uint16_t port,
+                     uint32_t timeout_ms) override;
+    void exchange(uint32_t slot, std::string_view request, char* buffer, size_t size,
+                  uint32_t timeout_ms) override;
+    void cancel(uint32_t slot) override;
+    void close(uint32_t slot) override;
+
+private:
+    struct Connection {
+        asio::ip::tcp::socket socket;
+        asio::steady_timer timer;
+        Handler* handler = nullptr;
+        unsigned generation = 0;            // Bumped by close; older handlers are stale
+        unsigned deadline_generation = 0;
+        bool timed_out = false;
+
+        explicit Connection(asio::io_context& io)
+            : socket(io)
+            , timer(io) {}
+    };
+
+    static void armDeadline(Connection& connection, uint32_t timeout_ms);
+    static void disarmDeadline(Connection& connection);
+    static asio::error_code outcome(const Connection& connection, const asio::error_code& ec);
+    static void read(Connection& connection, char* buffer, size_t size);
+
+    asio::io_context& m_io;
+    std::deque<Connection> m_slots;     // Never shrinks, so queued handlers may keep pointers
+    std::vector<uint32_t> m_free;
+};
+
+} // namespace netlens::internal
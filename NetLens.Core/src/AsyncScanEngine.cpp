@@ -5,13 +5,38 @@
 
 #include "AsyncScanEngine.h"
 #include "IpRange.h"
+#include "TargetSpec.h"
 #include "BannerGrabber.h"
+#include "RttEstimator.h"
+#include "CongestionController.h"
+#include "Permutation.h"
+#include "RateLimiter.h"
+#include "ControlSubscription.h"
+#include "ProgressReporter.h"
+#include "TargetBlocks.h"
+#include "AsioTransport.h"
+#include "SimulatedTransport.h"
+#include "UringConnector.h"
 #include <asio.hpp>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
 #include <algorithm>
+#include <array>
+#include <deque>
+#include <future>
+#include <unordered_map>
+#include <exception>
+#include <optional>
+#include <random>
+#include <stop_token>
+
+#ifdef __linux__
+#include <netinet/in.h>
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 #ifdef _WIN32
 #include <winsock2.h>
@@ -20,59 +45,1271 @@
 
 namespace netlens::internal {
 
+namespace {
+
+/// <summary>
+/// Progress counter stripe of the current io thread, its shard's index.
+/// Threads outside the engine share stripe 0.
+/// </summary>
+thread_local size_t t_progress_stripe = 0;
+
+/// <summary>
+/// Pins the calling thread to one core, wrapping around the cores present
+/// (on Windows, those of the first processor group). A failure leaves the
+/// thread unpinned.
+/// </summary>
+void pinCurrentThread(size_t index) {
+    const size_t cores = std::max<size_t>(1, std::thread::hardware_concurrency());
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<int>(index % cores), &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#elif defined(_WIN32)
+    SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{1} << (index % std::min<size_t>(cores, 64)));
+#else
+    (void)index;
+    (void)cores;
+#endif
+}
+
+/// <summary>
+/// Final state of a single probe.
+/// </summary>
+enum class ProbeOutcome {
+    Open,
+    Closed,
+    Filtered
+};
+
+/// <summary>
+/// What a probe is for.
+/// </summary>
+enum class ProbeKind {
+    /// <summary>Connect to a scanned port, then capture its banner.</summary>
+    Port,
+    /// <summary>Host discovery connect; accepted and refused both mean up.</summary>
+    TcpPing,
+    /// <summary>Host discovery ICMP echo request.</summary>
+    Echo
+};
+
+/// <summary>
+/// A host whose probes are in flight. Only open ports are kept, tagged with
+/// their position in the settings so they can be emitted in settings order;
+/// closed and filtered ports are counted in the result. With host discovery
+/// the port sweep only starts once a ping is answered; the host completes
+/// when both its pings and its ports are resolved.
+/// </summary>
+struct HostState {
+    uint32_t address;
+    Permutation port_order;
+    RttEstimator rtt;
+    HostResult result;
+    std::vector<std::pair<size_t, PortResult>> open_ports;
+    size_t ports_remaining;
+    size_t next_port = 0;
+    size_t next_ping = 0;
+    size_t pings_remaining = 0;
+    bool sweeping = false;
+};
+
+/// <summary>
+/// One probe to send: a port, a TCP ping port or the echo request of a host.
+/// </summary>
+struct ProbeTask {
+    HostState* host;
+    ProbeKind kind;
+    size_t index;
+    unsigned attempts;
+};
+
+/// <summary>
+/// Entry of a job's list of probes in flight, through which a pause or a
+/// cancel reaches their sockets. Linked and unlinked under the job lock;
+/// a linked probe is still alive.
+/// </summary>
+struct InFlightProbe {
+    InFlightProbe* prev = nullptr;
+    InFlightProbe* next = nullptr;
+
+    /// <summary>
+    /// Set on the probe's strand once abort has closed its socket.
+    /// </summary>
+    bool aborted = false;
+
+    /// <summary>
+    /// Set on the probes of a shard's pool, which untrack hands back to it.
+    /// </summary>
+    bool pooled = false;
+
+    virtual ~InFlightProbe() = default;
+
+    /// <summary>
+    /// Closes the probe's socket on its strand. The pending handler then
+    /// finds aborted set and hands the probe back instead of finishing it.
+    /// </summary>
+    virtual void abort() = 0;
+};
+
+struct ShardJob;
+
+/// <summary>
+/// State of a single executeScan call shared by its shards: the settings
+/// and targets, the global limits and the hand-off of completed hosts to
+/// the consumer, which the mutex guards. Each shard dispatches and
+/// accounts its own probes in a ShardJob. The engine's threads outlive the
+/// scan, so each probe handler and pacing timer hold a reference that
+/// keeps the job, and the probe pools of its shards, alive until they
+/// return; the job keeps its own copy of the settings.
+/// </summary>
+struct ScanJob : std::enable_shared_from_this<ScanJob> {
+    const ScanSettings settings;
+    IntervalSet targets;
+    uint64_t host_count = 0;
+    uint32_t timeout_ms = 0;
+    size_t max_buffered_hosts = 0;
+    bool discovery = false;
+    size_t ping_count = 0;
+    bool echo = false;
+    bool random_order = false;
+    uint64_t seed = 0;
+    Permutation host_order;
+    std::unique_ptr<TargetBlocks> blocks;
+    std::vector<std::unique_ptr<ShardJob>> shards;
+
+    // Set once dispatch stops for good, by a cancel or a failing sink
+    std::atomic<bool> stopped{false};
+    std::atomic<bool> cancelled{false};
+
+    // Hosts in progress or awaiting delivery, over all shards
+    std::atomic<size_t> buffered_hosts{0};
+
+    std::mutex mutex;
+    std::condition_variable ready_cv;
+    std::deque<std::unique_ptr<HostState>> ready;
+    uint64_t finished_hosts = 0;
+    size_t quiet_shards = 0;
+
+    // Completion counts, bumped lock-free by the io threads, and the last
+    // host completed, for progress snapshots
+    ProgressCounters progress;
+    std::optional<uint32_t> last_completed;
+
+    // The rate limits hold over the whole scan, so shards share the buckets
+    std::mutex limiter_mutex;
+    RateLimiter limiter;
+
+    ScanJob(const ScanSettings& s, IntervalSet t, size_t stripes)
+        : settings(s)
+        , targets(std::move(t))
+        , host_count(targets.size())
+        , progress(stripes)
+        , limiter(s.max_rate, s.max_subnet_rate, s.rate_subnet_prefix) {}
+
+    ScanJob(const ScanJob&) = delete;
+    ScanJob& operator=(const ScanJob&) = delete;
+
+    /// <summary>
+    /// True once every host is delivered, or dispatch stopped and every
+    /// shard is quiet. Called with the lock held.
+    /// </summary>
+    bool drained() const {
+        return ready.empty() &&
+               (finished_hosts == host_count || (stopped && quiet_shards == shards.size()));
+    }
+
+    /// <summary>
+    /// Claims room for one more host in the result buffer.
+    /// </summary>
+    bool reserveHost() {
+        size_t buffered = buffered_hosts.load(std::memory_order_relaxed);
+        while (buffered < max_buffered_hosts) {
+            if (buffered_hosts.compare_exchange_weak(buffered, buffered + 1, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+/// <summary>
+/// One shard's part of a scan: the hosts it opened from its target blocks,
+/// its probes in flight and its share of the window, with its own
+/// congestion control and timeouts. Guarded by the mutex. Its probes run on
+/// the shard's io_context, which a single thread serves, through the
+/// shard's transports.
+/// </summary>
+struct ShardJob {
+    ScanJob& job;
+    const size_t index;
+    asio::io_context& io;
+    Transport& transport;       // Asio sockets, io_uring or a simulated network
+    Transport& overflow;        // Asio sockets, for when transport has no free slot
+    AdaptiveTimeout timeouts{0, 0};
+    CongestionController congestion{1, 1};
+    size_t max_in_flight = 0;
+    size_t sweep_width = 1;
+
+    std::mutex mutex;
+    uint64_t next_index = 0;
+    uint64_t block_end = 0;
+    size_t in_flight = 0;
+    bool quiet = false;
+    std::unordered_map<uint32_t, std::unique_ptr<HostState>> active_hosts;
+    std::deque<HostState*> pinging;
+    std::deque<HostState*> sweeping;
+    std::deque<ProbeTask> retries;
+    size_t sockets_freed = 0;
+
+    // Pause and cancel: both close the probes in flight; after a pause
+    // their tasks wait in requeued and are sent first on resume
+    bool paused = false;
+    InFlightProbe* probes = nullptr;
+    std::deque<ProbeTask> requeued;
+
+    // TCP probes, allocated for the whole window when the scan starts and
+    // reused, so that launching one allocates nothing. Only the shard's
+    // thread takes probes from the free list or gives them back.
+    std::vector<std::unique_ptr<InFlightProbe>> probe_pool;
+    std::vector<InFlightProbe*> free_probes;
+
+    // Rate limiting: a task that found a bucket empty waits in paced for
+    // the shard's pacing timer, which runs on the transport's clock
+    RateMeter sent_rate;
+    std::optional<ProbeTask> paced;
+    std::unique_ptr<Transport::Timer> pacing_timer;
+    bool pacing_armed = false;
+
+    ShardJob(ScanJob& owner, size_t shard_index, asio::io_context& shard_io, Transport& primary,
+             Transport& fallback)
+        : job(owner)
+        , index(shard_index)
+        , io(shard_io)
+        , transport(primary)
+        , overflow(fallback)
+        , pacing_timer(primary.makeTimer()) {}
+
+    ShardJob(const ShardJob&) = delete;
+    ShardJob& operator=(const ShardJob&) = delete;
+
+    /// <summary>
+    /// Probes allowed in flight right now.
+    /// </summary>
+    size_t window() const {
+        return job.settings.adaptive_concurrency ? congestion.window() : max_in_flight;
+    }
+
+    void track(InFlightProbe& probe) {
+        probe.prev = nullptr;
+        probe.next = probes;
+        if (probes) {
+            probes->prev = &probe;
+        }
+        probes = &probe;
+    }
+
+    /// <summary>
+    /// Unlinks a probe that is done. A probe of the pool goes back to its
+    /// free list, so the caller must not touch it once it launches probes.
+    /// </summary>
+    void untrack(InFlightProbe& probe) {
+        (probe.prev ? probe.prev->next : probes) = probe.next;
+        if (probe.next) {
+            probe.next->prev = probe.prev;
+        }
+        probe.prev = nullptr;
+        probe.next = nullptr;
+        if (probe.pooled) {
+            free_probes.push_back(&probe);
+        }
+    }
+
+    void abortInFlight() {
+        for (InFlightProbe* probe = probes; probe; probe = probe->next) {
+            probe->abort();
+        }
+    }
+};
+
+/// <summary>
+/// Arms the deadline of an echo probe. A stale expiry from an earlier
+/// phase is recognized by its generation and ignored.
+/// </summary>
+template <typename ProbeType>
+void armDeadline(const std::shared_ptr<ProbeType>& probe, uint32_t timeout_ms) {
+    const unsigned generation = ++probe->deadline_generation;
+    probe->timer.expires_after(std::chrono::milliseconds(timeout_ms));
+    probe->timer.async_wait([probe, generation](const asio::error_code& ec) {
+        if (!ec && generation == probe->deadline_generation) {
+            probe->timed_out = true;
+            asio::error_code ignore_ec;
+            probe->socket.close(ignore_ec);
+        }
+    });
+}
+
+template <typename ProbeType>
+void disarmDeadline(ProbeType& probe) {
+    ++probe.deadline_generation;
+    probe.timer.cancel();
+}
+
+template <typename ProbeType>
+void postAbort(ProbeType& probe) {
+    asio::post(probe.socket.get_executor(), [self = probe.shared_from_this()]() {
+        self->aborted = true;
+        disarmDeadline(*self);
+        asio::error_code ignore_ec;
+        self->socket.close(ignore_ec);
+    });
+}
+
+#ifdef __linux__
+/// <summary>
+/// ICMP echo over an unprivileged datagram socket. The kernel fills in the
+/// identifier and checksum, and a connected socket only receives the
+/// replies of its own target.
+/// </summary>
+struct EchoProbe : InFlightProbe, std::enable_shared_from_this<EchoProbe> {
+    asio::generic::datagram_protocol::socket socket;
+    asio::steady_timer timer;
+    ProbeTask task;
+    std::chrono::steady_clock::time_point started;
+    unsigned deadline_generation = 0;
+    bool timed_out = false;
+    std::array<unsigned char, 64> buffer;
+
+    std::shared_ptr<ScanJob> job;
+
+    EchoProbe(asio::io_context& io, std::shared_ptr<ScanJob> owner, const ProbeTask& probe_task)
+        : socket(io)
+        , timer(io)
+        , task(probe_task)
+        , job(std::move(owner)) {}
+
+    void abort() override { postAbort(*this); }
+
+    static asio::generic::datagram_protocol protocol() {
+        return asio::generic::datagram_protocol(AF_INET, IPPROTO_ICMP);
+    }
+
+    /// <summary>
+    /// True if this process may open echo sockets.
+    /// </summary>
+    static bool available(asio::io_context& io) {
+        asio::generic::datagram_protocol::socket probe_socket(io);
+        asio::error_code ec;
+        probe_socket.open(protocol(), ec);
+        return !ec;
+    }
+};
+#endif
+
+} // namespace
+
 // Implementation details hidden from header
 struct AsyncScanEngine::Impl {
-    asio::io_context io_context;
-    std::unique_ptr<asio::io_context::work> work_guard;
-    std::vector<std::thread> thread_pool;
-    std::mutex results_mutex;
-    std::condition_variable completion_cv;
-    std::atomic<size_t> pending_operations{0};
-    std::atomic<size_t> completed_hosts{0};
-    std::atomic<size_t> completed_ports{0};
-    
-    ProgressCallback progress_callback;
-    ScanProgress current_progress;
-    std::mutex progress_mutex;
-    
-    static constexpr size_t DEFAULT_MAX_PORTS_PER_HOST = 100;
+    /// <summary>
+    /// An io_context, its transports and the one thread that runs it.
+    /// </summary>
+    struct Shard {
+        asio::io_context io{1};
+        asio::executor_work_guard<asio::io_context::executor_type> work{io.get_executor()};
+        AsioTransport sockets{io};
+        std::unique_ptr<Transport> transport;   // io_uring or simulated network; null for sockets alone
+        std::thread thread;
+
+        Transport& primary() { return transport ? *transport : sockets; }
+    };
+
+    /// <summary>
+    /// A single TCP probe: the connect attempt and, for open scanned ports,
+    /// the banner read on that same connection, on a slot of one of the
+    /// shard's transports. Its handlers run on the shard's thread. Probes
+    /// belong to their shard's pool and are reset for every launch.
+    /// </summary>
+    struct TcpProbe : InFlightProbe, Transport::Handler {
+        Impl& engine;
+        ShardJob& shard;
+        Transport* transport = nullptr;
+        ProbeTask task{};
+        uint16_t port = 0;
+        Transport::Clock::time_point started;
+        double connect_rtt_ms = -1.0;
+        ProbeSignal signal = ProbeSignal::Other;
+        uint32_t slot = 0;
+        unsigned launches = 0;      // An abort posted for an earlier launch finds it changed
+        bool connected = false;     // Holds a slot
+        bool closed = false;
+        std::array<char, BannerGrabber::MAX_BANNER_SIZE> banner_buffer;
+
+        TcpProbe(Impl& owner, ShardJob& probe_shard)
+            : engine(owner)
+            , shard(probe_shard) {
+            pooled = true;
+        }
+
+        void reset(Transport& probe_transport, const ProbeTask& probe_task, uint16_t port_number) {
+            ++launches;
+            transport = &probe_transport;
+            task = probe_task;
+            port = port_number;
+            connect_rtt_ms = -1.0;
+            signal = ProbeSignal::Other;
+            aborted = false;
+            connected = false;
+            closed = false;
+        }
+
+        void abort() override {
+            asio::post(shard.io, [this, launch = launches, lease = shard.job.shared_from_this()]() {
+                if (launch != launches) {
+                    return;
+                }
+                aborted = true;
+                if (connected && !closed) {
+                    transport->cancel(slot);
+                }
+            });
+        }
+
+        // The probe's last handler may hand the scan's last host to the
+        // consumer, which then releases the job and this pool with it
+        void onConnect(const asio::error_code& ec) override {
+            const std::shared_ptr<ScanJob> lease = shard.job.shared_from_this();
+            engine.probeConnected(shard, *this, ec);
+        }
+
+        void onReceive(const asio::error_code& ec, size_t bytes) override {
+            const std::shared_ptr<ScanJob> lease = shard.job.shared_from_this();
+            engine.probeReceived(shard, *this, ec, bytes);
+        }
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::atomic<size_t> next_shard{0};
+    bool simulated = false;
+
+    static constexpr size_t DEFAULT_MAX_IN_FLIGHT = 500;
+    static constexpr size_t DEFAULT_MIN_IN_FLIGHT = 16;
+    static constexpr unsigned MAX_LOCAL_ATTEMPTS = 4;
+    static constexpr size_t DEFAULT_RESULT_BUFFER_HOSTS = 256;
     static constexpr size_t MIN_TIMEOUT_MS = 50;
     static constexpr size_t MAX_TIMEOUT_MS = 30000;
+    static constexpr uint64_t BLOCKS_PER_SHARD = 16;
+    static constexpr uint64_t MAX_BLOCK_HOSTS = 1024;
+
+    /// <summary>
+    /// Starts one shard per io thread, which then serve every scan until the
+    /// engine is destroyed.
+    /// </summary>
+    void startShards(const EngineOptions& options) {
+        size_t count = options.threads;
+        if (count == 0) {
+            count = std::thread::hardware_concurrency();
+        }
+        if (count == 0) {
+            count = 4;
+        }
+
+        simulated = options.network != nullptr;
+        for (size_t i = 0; i < count; ++i) {
+            auto shard = std::make_unique<Shard>();
+            Shard& self = *shard;
+            std::promise<void> ready;
+            std::future<void> started = ready.get_future();
+            self.thread = std::thread([&self, i, &options, &ready]() {
+                if (options.pin_threads) {
+                    pinCurrentThread(i);
+                }
+                t_progress_stripe = i;
+                attachTransport(self, options);
+                ready.set_value();
+                self.io.run();
+            });
+            started.wait();
+            shards.push_back(std::move(shard));
+        }
+    }
+
+    /// <summary>
+    /// Gives the shard its primary transport: the simulated network if the
+    /// options name one, else an io_uring if asked for and the kernel
+    /// allows one. Runs on the shard's own thread, the ring's only submitter.
+    /// </summary>
+    static void attachTransport(Shard& shard, const EngineOptions& options) {
+        if (options.network) {
+            shard.transport = std::make_unique<SimulatedTransport>(shard.io, *options.network);
+            return;
+        }
+#ifdef NETLENS_HAS_IO_URING
+        if (options.io_backend != IoBackend::IoUring || !UringConnector::supported()) {
+            return;
+        }
+        try {
+            shard.transport = std::make_unique<UringConnector>(shard.io);
+        } catch (const std::system_error&) {
+            // Refused by seccomp, io_uring_disabled or memlock limits: stay on Asio
+        }
+#endif
+    }
+
+    /// <summary>
+    /// Lets each io thread run the handlers past scans left queued (the
+    /// cancelled deadlines and pacing timers of their last probes) and
+    /// return. Stopping the io_contexts instead would destroy those
+    /// handlers, and with them a job whose timers belong to another shard,
+    /// in whatever order the shards are torn down.
+    /// </summary>
+    void stopShards() {
+        for (auto& shard : shards) {
+            shard->work.reset();
+        }
+        for (auto& shard : shards) {
+            if (shard->thread.joinable()) {
+                shard->thread.join();
+            }
+        }
+        shards.clear();
+    }
+
+    /// <summary>
+    /// Fills the window, loss and rate fields of a progress snapshot, summed
+    /// over the shards. Runs on the reporting thread, once per snapshot.
+    /// </summary>
+    static void sampleProgress(ScanJob& job, ScanProgress& progress) {
+        const auto now = std::chrono::steady_clock::now();
+        CongestionStats totals;
+        progress.window = 0;
+        progress.in_flight = 0;
+        progress.probe_rate = 0.0;
+        for (auto& shard : job.shards) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            const CongestionStats& stats = shard->congestion.stats();
+            totals.timeouts += stats.timeouts;
+            totals.refused += stats.refused;
+            totals.local_errors += stats.local_errors;
+            totals.decreases += stats.decreases;
+            progress.window += shard->window();
+            progress.in_flight += shard->in_flight;
+            progress.probe_rate += shard->sent_rate.rate(now);
+        }
+        progress.timeouts = static_cast<size_t>(totals.timeouts);
+        progress.refusals = static_cast<size_t>(totals.refused);
+        progress.local_errors = static_cast<size_t>(totals.local_errors);
+        progress.window_decreases = static_cast<size_t>(totals.decreases);
+
+        std::optional<uint32_t> last_completed;
+        {
+            std::lock_guard<std::mutex> lock(job.mutex);
+            last_completed = job.last_completed;
+        }
+        if (last_completed) {
+            progress.current_ip = IpRange::toString(*last_completed);
+        }
+    }
+
+    /// <summary>
+    /// Classifies a failed connect for the congestion controller. Errors
+    /// raised by the local stack itself mean we are pushing too hard.
+    /// </summary>
+    static ProbeSignal classifyConnectError(const asio::error_code& ec) {
+        if (ec == asio::error::timed_out) {
+            return ProbeSignal::TimedOut;
+        }
+        if (ec == asio::error::connection_refused) {
+            return ProbeSignal::Refused;
+        }
+        if (ec == asio::error::no_descriptors || ec == asio::error::no_buffer_space ||
+            ec == asio::error::no_memory || ec == std::errc::address_not_available) {
+            return ProbeSignal::LocalError;
+        }
+        return ProbeSignal::Other;
+    }
+
+    /// <summary>
+    /// Takes the shard's next probe to send, or returns false if the scan is
+    /// paused or the window, the result buffer or the targets are exhausted.
+    /// Order of preference: probes closed by a pause, probes turned away by
+    /// the local stack, pings of hosts under discovery, ports of hosts being
+    /// swept, then a new host; in random order new hosts are opened until
+    /// sweep_width are in rotation. A retry only goes out once another probe
+    /// has released its socket, or when nothing is left in flight to release
+    /// one. Called with the shard lock held.
+    /// </summary>
+    bool nextTask(ShardJob& shard, ProbeTask& task) {
+        const ScanJob& job = shard.job;
+        const size_t port_count = job.settings.ports.size();
+
+        if (job.stopped || shard.paused || shard.in_flight >= shard.window()) {
+            return false;
+        }
+
+        if (!shard.requeued.empty()) {
+            task = shard.requeued.front();
+            shard.requeued.pop_front();
+            return true;
+        }
+
+        if (!shard.retries.empty()) {
+            if (shard.sockets_freed == 0 && shard.in_flight > 0) {
+                return false;
+            }
+            if (shard.sockets_freed > 0) {
+                --shard.sockets_freed;
+            }
+            task = shard.retries.front();
+            shard.retries.pop_front();
+            return true;
+        }
+
+        for (;;) {
+            if (!shard.pinging.empty()) {
+                HostState* host = shard.pinging.front();
+                const size_t index = host->next_ping++;
+                if (host->next_ping == job.ping_count) {
+                    shard.pinging.pop_front();
+                }
+                const bool echo = job.echo && index == job.ping_count - 1;
+                task = { host, echo ? ProbeKind::Echo : ProbeKind::TcpPing, index, 1 };
+                return true;
+            }
+
+            if (job.random_order) {
+                // Keep sweep_width hosts in rotation; each probe goes to the
+                // next host in turn, at that host's next permuted port
+                if (shard.sweeping.size() < shard.sweep_width && openHost(shard)) {
+                    continue;
+                }
+                if (shard.sweeping.empty()) {
+                    return false;
+                }
+                HostState* host = shard.sweeping.front();
+                shard.sweeping.pop_front();
+                const size_t index = static_cast<size_t>(host->port_order(host->next_port++));
+                if (host->next_port < port_count) {
+                    shard.sweeping.push_back(host);
+                }
+                task = { host, ProbeKind::Port, index, 1 };
+                return true;
+            }
+
+            if (!shard.sweeping.empty()) {
+                HostState* host = shard.sweeping.front();
+                const size_t index = host->next_port++;
+                if (host->next_port == port_count) {
+                    shard.sweeping.pop_front();
+                }
+                task = { host, ProbeKind::Port, index, 1 };
+                return true;
+            }
+
+            if (!openHost(shard)) {
+                return false;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Starts the next host of the shard's target block, queueing it for
+    /// discovery or directly for its port sweep. Once the block is used up
+    /// the next one is taken, stolen from another shard if need be. Returns
+    /// false when no host is left or the result buffer is full. Called with
+    /// the shard lock held.
+    /// </summary>
+    bool openHost(ShardJob& shard) {
+        ScanJob& job = shard.job;
+        const size_t port_count = job.settings.ports.size();
+
+        // A block taken while the buffer is full stays with the shard
+        if (shard.next_index == shard.block_end &&
+            !job.blocks->take(shard.index, shard.next_index, shard.block_end)) {
+            return false;
+        }
+        if (!job.reserveHost()) {
+            return false;
+        }
+
+        const uint64_t index = shard.next_index++;
+        auto state = std::make_unique<HostState>();
+        if (job.random_order) {
+            state->address = job.targets.at(job.host_order(index));
+            state->port_order = Permutation(port_count, job.seed ^ Permutation::mix(state->address));
+        } else {
+            state->address = job.targets.at(index);
+        }
+        state->ports_remaining = port_count;
+        if (job.discovery) {
+            state->pings_remaining = job.ping_count;
+            shard.pinging.push_back(state.get());
+        } else {
+            state->sweeping = true;
+            shard.sweeping.push_back(state.get());
+        }
+        shard.timeouts.addHost(state->address);
+        shard.active_hosts.emplace(state->address, std::move(state));
+        return true;
+    }
+
+    /// <summary>
+    /// Fills the shard's window. Called on the shard's thread to prime the
+    /// scan, from every completion handler, from the pacing timer and when
+    /// the consumer drains a full result buffer or the scan resumes. A new
+    /// host is only opened while the result buffer has room, which is how a
+    /// slow consumer pushes back. With a rate limit a probe that finds a
+    /// bucket empty is held and the shard's pacing timer is armed for when a
+    /// token will be available.
+    /// </summary>
+    void launchProbes(ShardJob& shard) {
+        ScanJob& job = shard.job;
+        for (;;) {
+            ProbeTask task;
+            uint32_t timeout_ms;
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                if (shard.paced) {
+                    if (job.stopped || shard.paused || shard.in_flight >= shard.window()) {
+                        return;
+                    }
+                    task = *shard.paced;
+                    shard.paced.reset();
+                } else if (!nextTask(shard, task)) {
+                    return;
+                }
+
+                if (job.limiter.enabled()) {
+                    Transport::Clock::duration wait;
+                    {
+                        std::lock_guard<std::mutex> limiter_lock(job.limiter_mutex);
+                        wait = job.limiter.acquire(task.host->address, shard.transport.now());
+                    }
+                    if (wait > Transport::Clock::duration::zero()) {
+                        shard.paced = task;
+                        armPacing(shard, wait);
+                        return;
+                    }
+                }
+                // Progress rates are wall-clock rates, whatever the transport's clock
+                shard.sent_rate.add(std::chrono::steady_clock::now());
+
+                timeout_ms = job.settings.adaptive_timeout
+                    ? shard.timeouts.timeoutFor(task.host->address, task.host->rtt)
+                    : job.timeout_ms;
+                ++shard.in_flight;
+            }
+
+            startProbe(shard, task, timeout_ms);
+        }
+    }
+
+    /// <summary>
+    /// Makes room in the shard's transport for its window and fills the
+    /// window, on the shard's own thread.
+    /// </summary>
+    void prime(ShardJob& shard) {
+        asio::post(shard.io, [this, &shard, lease = shard.job.shared_from_this()]() {
+            shard.transport.reserveSlots(shard.max_in_flight);
+            launchProbes(shard);
+        });
+    }
 
-    void initThreadPool(size_t num_threads) {
-        work_guard = std::make_unique<asio::io_context::work>(io_context);
-        
-        for (size_t i = 0; i < num_threads; ++i) {
-            thread_pool.emplace_back([this]() {
-                io_context.run();
+    /// <summary>
+    /// Runs launchProbes on the shard's own thread.
+    /// </summary>
+    void kick(ShardJob& shard) {
+        asio::post(shard.io, [this, &shard, lease = shard.job.shared_from_this()]() {
+            launchProbes(shard);
+        });
+    }
+
+    /// <summary>
+    /// Arms the shard's pacing timer unless it is already pending. Called
+    /// with the shard lock held.
+    /// </summary>
+    void armPacing(ShardJob& shard, Transport::Clock::duration wait) {
+        if (shard.pacing_armed) {
+            return;
+        }
+        shard.pacing_armed = true;
+        // Not called back if cancelled at the end of the scan
+        shard.pacing_timer->wait(wait, [this, &shard, lease = shard.job.shared_from_this()]() {
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                shard.pacing_armed = false;
+            }
+            launchProbes(shard);
+        });
+    }
+
+    void startProbe(ShardJob& shard, const ProbeTask& task, uint32_t timeout_ms) {
+        const ScanJob& job = shard.job;
+#ifdef __linux__
+        if (task.kind == ProbeKind::Echo) {
+            auto probe = std::make_shared<EchoProbe>(shard.io, shard.job.shared_from_this(), task);
+            if (!trackProbe(shard, *probe, task)) {
+                return;
+            }
+            asio::dispatch(shard.io, [this, &shard, probe, timeout_ms]() {
+                sendEcho(shard, probe, timeout_ms);
             });
+            return;
+        }
+#endif
+
+        const uint16_t port = task.kind == ProbeKind::Port
+            ? job.settings.ports[task.index]
+            : job.settings.discovery_ports[task.index];
+
+        // Only the shard's thread launches probes, so free slots and pooled
+        // probes can be taken here; once the primary transport runs out the
+        // Asio sockets take over
+        Transport& transport = shard.transport.freeSlots() > 0 ? shard.transport : shard.overflow;
+        TcpProbe& probe = takeProbe(shard);
+        probe.reset(transport, task, port);
+        if (!trackProbe(shard, probe, task)) {
+            shard.free_probes.push_back(&probe);
+            return;
+        }
+        probe.started = transport.now();
+        probe.slot = transport.connect(probe, task.host->address, port, timeout_ms);
+        probe.connected = true;
+    }
+
+    /// <summary>
+    /// Takes a probe from the shard's pool, which holds one for every probe
+    /// the window allows in flight; it only grows should that ever change.
+    /// </summary>
+    TcpProbe& takeProbe(ShardJob& shard) {
+        if (shard.free_probes.empty()) {
+            shard.probe_pool.push_back(std::make_unique<TcpProbe>(*this, shard));
+            return static_cast<TcpProbe&>(*shard.probe_pool.back());
+        }
+        InFlightProbe* probe = shard.free_probes.back();
+        shard.free_probes.pop_back();
+        return static_cast<TcpProbe&>(*probe);
+    }
+
+    /// <summary>
+    /// Allocates the shard's probes for its whole window.
+    /// </summary>
+    void fillProbePool(ShardJob& shard) {
+        shard.probe_pool.reserve(shard.max_in_flight);
+        shard.free_probes.reserve(shard.max_in_flight);
+        while (shard.probe_pool.size() < shard.max_in_flight) {
+            shard.probe_pool.push_back(std::make_unique<TcpProbe>(*this, shard));
+            shard.free_probes.push_back(shard.probe_pool.back().get());
+        }
+    }
+
+    void probeConnected(ShardJob& shard, TcpProbe& probe, const asio::error_code& ec) {
+        if (probe.aborted) {
+            closeProbe(probe);
+            abandonProbe(shard, probe, probe.task);
+            return;
+        }
+
+        probe.signal = ec ? classifyConnectError(ec) : ProbeSignal::Answered;
+
+        // Both an accepted and a refused connect measure one round trip
+        const bool refused = probe.signal == ProbeSignal::Refused;
+        if (refused || probe.signal == ProbeSignal::Answered) {
+            probe.connect_rtt_ms = std::chrono::duration<double, std::milli>(
+                probe.transport->now() - probe.started).count();
+        }
+
+        if (ec || probe.task.kind == ProbeKind::TcpPing) {
+            closeProbe(probe);
+            if (probe.signal == ProbeSignal::LocalError && retryProbe(shard, probe, probe.task, probe.signal)) {
+                return;
+            }
+            if (probe.task.kind == ProbeKind::TcpPing) {
+                finishPing(shard, probe, probe.task, probe.signal, probe.connect_rtt_ms);
+                return;
+            }
+            finishProbe(shard, probe, refused ? ProbeOutcome::Closed : ProbeOutcome::Filtered);
+            return;
+        }
+
+        // Capture a service banner on the connection that just opened, under
+        // its own deadline. The port is reported open whatever the outcome.
+        if (!BannerGrabber::needsRead(probe.port)) {
+            probeReceived(shard, probe, asio::error_code(), 0);
+            return;
+        }
+        probe.transport->exchange(probe.slot, BannerGrabber::requestFor(probe.port), probe.banner_buffer.data(),
+                                  probe.banner_buffer.size(),
+                                  BannerGrabber::clampTimeout(shard.job.timeout_ms / 2));
+    }
+
+    void probeReceived(ShardJob& shard, TcpProbe& probe, const asio::error_code& ec, size_t bytes) {
+        closeProbe(probe);
+        if (probe.aborted) {
+            abandonProbe(shard, probe, probe.task);
+            return;
+        }
+
+        std::string banner;
+        try {
+            banner = BannerGrabber::parseBanner(probe.port,
+                                                std::string_view(probe.banner_buffer.data(), ec ? 0 : bytes));
+        } catch (...) {
+            // Banner parsing failed, but port is still open
+        }
+
+        finishProbe(shard, probe, ProbeOutcome::Open, std::move(banner));
+    }
+
+    static void closeProbe(TcpProbe& probe) {
+        if (!probe.closed) {
+            probe.closed = true;
+            probe.transport->close(probe.slot);
+        }
+    }
+
+#ifdef __linux__
+    void sendEcho(ShardJob& shard, const std::shared_ptr<EchoProbe>& probe, uint32_t timeout_ms) {
+        if (probe->aborted) {
+            abandonProbe(shard, *probe, probe->task);
+            return;
+        }
+
+        sockaddr_in target{};
+        target.sin_family = AF_INET;
+        target.sin_addr.s_addr = htonl(probe->task.host->address);
+        const asio::generic::datagram_protocol::endpoint endpoint(&target, sizeof(target));
+
+        asio::error_code ec;
+        probe->socket.open(EchoProbe::protocol(), ec);
+        if (!ec) {
+            probe->socket.connect(endpoint, ec);
+        }
+        if (ec) {
+            const ProbeSignal signal = classifyConnectError(ec);
+            if (signal == ProbeSignal::LocalError && retryProbe(shard, *probe, probe->task, signal)) {
+                return;
+            }
+            finishPing(shard, *probe, probe->task, signal, -1.0);
+            return;
+        }
+
+        // Echo request: type 8, code 0; identifier and checksum are the kernel's
+        static constexpr unsigned char request[16] = { 8, 0, 0, 0, 0, 0, 0, 1, 'N', 'e', 't', 'L', 'e', 'n', 's', 0 };
+
+        probe->started = std::chrono::steady_clock::now();
+        armDeadline(probe, timeout_ms);
+        probe->socket.async_send(asio::buffer(request),
+            [this, &shard, probe](const asio::error_code& send_ec, size_t) {
+                if (send_ec) {
+                    completeEcho(shard, *probe, false);
+                    return;
+                }
+                probe->socket.async_receive(asio::buffer(probe->buffer),
+                    [this, &shard, probe](const asio::error_code& receive_ec, size_t bytes) {
+                        completeEcho(shard, *probe, !receive_ec && bytes >= 8 && probe->buffer[0] == 0);
+                    });
+            });
+    }
+
+    void completeEcho(ShardJob& shard, EchoProbe& probe, bool replied) {
+        disarmDeadline(probe);
+        asio::error_code ignore_ec;
+        probe.socket.close(ignore_ec);
+        if (probe.aborted) {
+            abandonProbe(shard, probe, probe.task);
+            return;
+        }
+
+        const double rtt_ms = replied
+            ? std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - probe.started).count()
+            : -1.0;
+        const ProbeSignal signal = replied ? ProbeSignal::Answered
+            : probe.timed_out ? ProbeSignal::TimedOut : ProbeSignal::Other;
+        finishPing(shard, probe, probe.task, signal, rtt_ms);
+    }
+#endif
+
+    /// <summary>
+    /// Releases the window slot of a probe the local stack turned away and
+    /// queues it to be sent again. Failures while the window is still
+    /// shrinking towards its cut size are not held against the probe; once
+    /// it has failed MAX_LOCAL_ATTEMPTS times with the window settled,
+    /// returns false and the probe is reported as unanswered.
+    /// </summary>
+    bool retryProbe(ShardJob& shard, InFlightProbe& probe, const ProbeTask& task, ProbeSignal signal) {
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.congestion.onProbeComplete(signal);
+            const bool shrinking = shard.in_flight > shard.window();
+            const unsigned attempts = shrinking ? task.attempts : task.attempts + 1;
+            if (attempts > MAX_LOCAL_ATTEMPTS) {
+                return false;
+            }
+            shard.untrack(probe);
+            shard.sockets_freed = 0;
+            ProbeTask retry = task;
+            retry.attempts = attempts;
+            shard.retries.push_back(retry);
+            releaseInFlight(shard);
+        }
+
+        launchProbes(shard);
+        return true;
+    }
+
+    /// <summary>
+    /// Gives back a window slot. A shard of a stopped scan is marked quiet
+    /// once nothing is left in flight on it. Called with the shard lock held.
+    /// </summary>
+    void releaseInFlight(ShardJob& shard) {
+        --shard.in_flight;
+        if (shard.in_flight == 0 && shard.job.stopped) {
+            markQuiet(shard);
+        }
+    }
+
+    /// <summary>
+    /// Counts a stopped shard as drained, waking the consumer with the last
+    /// one. Called with the shard lock held.
+    /// </summary>
+    void markQuiet(ShardJob& shard) {
+        if (shard.quiet) {
+            return;
+        }
+        shard.quiet = true;
+        ScanJob& job = shard.job;
+        std::lock_guard<std::mutex> lock(job.mutex);
+        ++job.quiet_shards;
+        if (job.drained()) {
+            job.ready_cv.notify_one();
+        }
+    }
+
+    /// <summary>
+    /// Links a probe into the shard's list of probes in flight. If the scan
+    /// was paused or cancelled since its task was taken, the task is handed
+    /// back instead and false is returned.
+    /// </summary>
+    bool trackProbe(ShardJob& shard, InFlightProbe& probe, const ProbeTask& task) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.paused || shard.job.cancelled) {
+            releaseAbandoned(shard, task);
+            return false;
+        }
+        shard.track(probe);
+        return true;
+    }
+
+    /// <summary>
+    /// Releases the window slot of a probe closed by a pause or a cancel.
+    /// After a pause its task is queued to be sent first on resume; after a
+    /// cancel it is dropped. Called with the shard lock held.
+    /// </summary>
+    void releaseAbandoned(ShardJob& shard, const ProbeTask& task) {
+        if (!shard.job.cancelled) {
+            shard.requeued.push_back(task);
+        }
+        releaseInFlight(shard);
+    }
+
+    /// <summary>
+    /// Hands back a probe whose socket a pause or cancel closed. If the scan
+    /// was resumed before the probe got here, refills the window.
+    /// </summary>
+    void abandonProbe(ShardJob& shard, InFlightProbe& probe, const ProbeTask& task) {
+        bool resumed;
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.untrack(probe);
+            releaseAbandoned(shard, task);
+            resumed = !shard.paused && !shard.job.stopped;
+        }
+        if (resumed) {
+            launchProbes(shard);
         }
     }
 
-    void stopThreadPool() {
-        work_guard.reset();
-        io_context.stop();
-        
-        for (auto& thread : thread_pool) {
-            if (thread.joinable()) {
-                thread.join();
+    /// <summary>
+    /// Pauses or resumes dispatch on every shard. A pause closes every probe
+    /// in flight, freeing the window; their tasks are sent again on resume.
+    /// </summary>
+    void setPaused(ScanJob& job, bool paused) {
+        for (auto& shard : job.shards) {
+            {
+                std::lock_guard<std::mutex> lock(shard->mutex);
+                if (shard->paused == paused) {
+                    continue;
+                }
+                shard->paused = paused;
+                if (paused) {
+                    shard->abortInFlight();
+                }
+            }
+            if (!paused) {
+                kick(*shard);
             }
         }
-        thread_pool.clear();
     }
 
-    void updateProgress(const std::string& current_ip) {
-        if (!progress_callback) return;
+    /// <summary>
+    /// Stops dispatch for good. A cancel also closes every probe in flight
+    /// and the pacing timers; after a failing sink the probes in flight
+    /// drain. The consumer is woken once every shard is quiet and the
+    /// completed hosts are delivered.
+    /// </summary>
+    void stop(ScanJob& job, bool cancel) {
+        if (cancel) {
+            job.cancelled = true;
+        }
+        job.stopped = true;
+        for (auto& shard : job.shards) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            if (cancel) {
+                shard->requeued.clear();
+                shard->retries.clear();
+                shard->paced.reset();
+                shard->pacing_timer->cancel();
+                shard->abortInFlight();
+            }
+            if (shard->in_flight == 0) {
+                markQuiet(*shard);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Unlinks a completed probe and feeds its signal and round trip to the
+    /// shard's controllers. Its window slot is given back once its host is
+    /// settled, so a stopped shard is never quiet before its last host is
+    /// handed over. Called with the shard lock held.
+    /// </summary>
+    void releaseSlot(ShardJob& shard, InFlightProbe& probe, HostState& host, ProbeSignal signal, double rtt_ms) {
+        shard.untrack(probe);
+        if (signal != ProbeSignal::LocalError) {
+            // Local errors were already recorded by retryProbe
+            ++shard.sockets_freed;
+            shard.congestion.onProbeComplete(signal);
+        }
+        if (rtt_ms >= 0.0) {
+            shard.timeouts.addSample(host.address, host.rtt, rtt_ms);
+        }
+    }
+
+    /// <summary>
+    /// Hands a host to the consumer once its pings and ports are all
+    /// resolved. Returns true if it completed. Called with the shard lock held.
+    /// </summary>
+    bool completeHostIfDone(ShardJob& shard, HostState& host) {
+        if (host.ports_remaining != 0 || host.pings_remaining != 0) {
+            return false;
+        }
+
+        // The address string is only produced once the host is emitted
+        host.result.address = IpRange::toString(host.address);
+        host.result.is_alive = host.result.liveness != Liveness::None;
+        std::sort(host.open_ports.begin(), host.open_ports.end(),
+                  [](const auto& a, const auto& b) { return a.first < b.first; });
+        host.result.ports.reserve(host.open_ports.size());
+        for (auto& entry : host.open_ports) {
+            host.result.ports.push_back(std::move(entry.second));
+        }
+        const uint32_t address = host.address;
+        shard.timeouts.removeHost(address);
+        auto it = shard.active_hosts.find(address);
+        std::unique_ptr<HostState> completed = std::move(it->second);
+        shard.active_hosts.erase(it);
+
+        ScanJob& job = shard.job;
+        {
+            std::lock_guard<std::mutex> lock(job.mutex);
+            job.last_completed = address;
+            ++job.finished_hosts;
+            job.ready.push_back(std::move(completed));
+        }
+        job.ready_cv.notify_one();
+        return true;
+    }
+
+    /// <summary>
+    /// Counts a completed host outside the shard lock and refills the window.
+    /// </summary>
+    void afterCompletion(ShardJob& shard, bool host_completed) {
+        if (host_completed) {
+            shard.job.progress.addHosts(t_progress_stripe, 1);
+        }
 
-        std::lock_guard<std::mutex> lock(progress_mutex);
-        current_progress.current_ip = current_ip;
-        current_progress.completed_hosts = completed_hosts.load();
-        current_progress.completed_ports = completed_ports.load();
-        progress_callback(current_progress);
+        launchProbes(shard);
+    }
+
+    /// <summary>
+    /// Records a discovery ping. The first answer starts the host's port
+    /// sweep; a host none of whose pings were answered completes without
+    /// its ports being probed.
+    /// </summary>
+    void finishPing(ShardJob& shard, InFlightProbe& probe, const ProbeTask& task, ProbeSignal signal, double rtt_ms) {
+        HostState& host = *task.host;
+        const bool answered = signal == ProbeSignal::Answered || signal == ProbeSignal::Refused;
+        const size_t port_count = shard.job.settings.ports.size();
+
+        bool host_completed;
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            releaseSlot(shard, probe, host, signal, rtt_ms);
+            --host.pings_remaining;
+
+            if (answered && !host.sweeping) {
+                host.sweeping = true;
+                host.result.liveness = task.kind == ProbeKind::Echo ? Liveness::EchoReply : Liveness::TcpReply;
+                shard.sweeping.push_back(&host);
+            } else if (host.pings_remaining == 0 && !host.sweeping) {
+                host.result.filtered_ports = static_cast<uint32_t>(port_count);
+                host.ports_remaining = 0;
+                shard.job.progress.addPorts(t_progress_stripe, port_count);
+            }
+            host_completed = completeHostIfDone(shard, host);
+            releaseInFlight(shard);
+        }
+
+        afterCompletion(shard, host_completed);
+    }
+
+    /// <summary>
+    /// Records a port outcome, releases its window slot, hands the host to
+    /// the consumer when it is complete and refills the window.
+    /// </summary>
+    void finishProbe(ShardJob& shard, TcpProbe& probe, ProbeOutcome outcome, std::string banner = {}) {
+        HostState& host = *probe.task.host;
+        shard.job.progress.addPorts(t_progress_stripe, 1);
+
+        bool host_completed;
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            releaseSlot(shard, probe, host, probe.signal, probe.connect_rtt_ms);
+            switch (outcome) {
+                case ProbeOutcome::Open:
+                    if (host.result.liveness == Liveness::None) {
+                        host.result.liveness = Liveness::OpenPort;
+                    }
+                    host.open_ports.emplace_back(probe.task.index,
+                                                 PortResult(probe.port, true, std::move(banner)));
+                    break;
+                case ProbeOutcome::Closed:
+                    ++host.result.closed_ports;
+                    break;
+                case ProbeOutcome::Filtered:
+                    ++host.result.filtered_ports;
+                    break;
+            }
+            --host.ports_remaining;
+            host_completed = completeHostIfDone(shard, host);
+            releaseInFlight(shard);
+        }
+
+        afterCompletion(shard, host_completed);
     }
 };
 
-AsyncScanEngine::AsyncScanEngine()
+AsyncScanEngine::AsyncScanEngine(const EngineOptions& options)
     : m_impl(std::make_unique<Impl>())
 {
 #ifdef _WIN32
@@ -80,223 +1317,183 @@ AsyncScanEngine::AsyncScanEngine()
     WSADATA wsaData;
     WSAStartup(MAKEWORD(2, 2), &wsaData);
 #endif
+
+    m_impl->startShards(options);
 }
 
 AsyncScanEngine::~AsyncScanEngine() {
     if (m_impl) {
-        m_impl->stopThreadPool();
+        m_impl->stopShards();
     }
 #ifdef _WIN32
     WSACleanup();
 #endif
 }
 
-ScanResult AsyncScanEngine::executeScan(const ScanSettings& settings, ProgressCallback progressCallback) {
-    // Setup progress tracking
-    m_impl->progress_callback = progressCallback;
-    m_impl->current_progress = ScanProgress();
-    m_impl->completed_hosts.store(0);
-    m_impl->completed_ports.store(0);
-
-    // Enumerate IP addresses
-    std::vector<std::string> addresses;
+ScanSummary AsyncScanEngine::executeScan(const ScanSettings& settings, const HostSink& sink,
+                                         ProgressCallback progressCallback, ScanControl* control) {
+    // Resolve the targets; addresses are produced lazily while dispatching
+    IntervalSet targets;
     try {
-        addresses = IpRange::enumerate(settings.start_ip, settings.end_ip);
+        targets = TargetSpec::resolve(settings);
     } catch (const IpRangeException& e) {
         throw std::runtime_error(std::string("IP range error: ") + e.what());
     }
 
-    m_impl->current_progress.total_hosts = addresses.size();
-    m_impl->current_progress.total_ports = settings.ports.size() * addresses.size();
+    auto job_owner = std::make_shared<ScanJob>(settings, std::move(targets), m_impl->shards.size());
+    ScanJob& job = *job_owner;
+    ScanSummary summary;
 
-    // Determine thread pool size
-    size_t num_threads = std::min(
-        static_cast<size_t>(std::thread::hardware_concurrency()),
-        static_cast<size_t>(8)
-    );
-    if (num_threads == 0) num_threads = 4;
+    const size_t host_count = static_cast<size_t>(job.host_count);
+    const size_t port_count = settings.ports.size();
+    summary.total_hosts = host_count;
 
-    // Initialize thread pool
-    m_impl->initThreadPool(num_threads);
+    if (host_count == 0 || port_count == 0) {
+        return summary;
+    }
 
-    // Prepare result
-    ScanResult result(settings);
-    result.hosts.resize(addresses.size());
+    // Clamp timeout
+    job.timeout_ms = std::max(static_cast<uint32_t>(Impl::MIN_TIMEOUT_MS),
+                              std::min(static_cast<uint32_t>(Impl::MAX_TIMEOUT_MS), settings.timeout_ms));
 
-    // Determine concurrency limits
-    size_t max_concurrent_hosts = settings.max_concurrency;
-    if (max_concurrent_hosts == 0 || max_concurrent_hosts > addresses.size()) {
-        max_concurrent_hosts = addresses.size();
+    // One window of outstanding connects for the whole scan, split between
+    // the shards below
+    size_t max_in_flight = settings.max_concurrency;
+    if (max_in_flight == 0) {
+        max_in_flight = Impl::DEFAULT_MAX_IN_FLIGHT;
     }
+    max_in_flight = std::min(max_in_flight, port_count * host_count);
 
-    // Semaphore for host-level concurrency
-    std::mutex host_semaphore_mutex;
-    std::condition_variable host_semaphore_cv;
-    std::atomic<size_t> active_hosts{0};
+    // The adaptive window moves between the user's bounds
+    size_t min_in_flight = settings.min_concurrency;
+    if (min_in_flight == 0) {
+        min_in_flight = Impl::DEFAULT_MIN_IN_FLIGHT;
+    }
 
-    // Scan hosts with concurrency control
-    for (size_t i = 0; i < addresses.size(); ++i) {
-        const std::string& ip = addresses[i];
-        HostResult& host_result = result.hosts[i];
-        host_result.address = ip;
-        host_result.is_alive = false;
+    // Host discovery: TCP pings, then one echo request where permitted
+    if (settings.host_discovery == HostDiscovery::Ping) {
+#ifdef __linux__
+        job.echo = settings.discovery_echo && !m_impl->simulated &&
+                   EchoProbe::available(m_impl->shards.front()->io);
+#endif
+        job.ping_count = settings.discovery_ports.size() + (job.echo ? 1 : 0);
+        job.discovery = job.ping_count > 0;
+    }
 
-        // Wait for slot if at max concurrent hosts
-        {
-            std::unique_lock<std::mutex> lock(host_semaphore_mutex);
-            host_semaphore_cv.wait(lock, [&]() {
-                return active_hosts.load() < max_concurrent_hosts;
-            });
-            active_hosts++;
-            m_impl->pending_operations++;
+    // Random order: hosts follow a keyed permutation of the whole target
+    // set and as many hosts as a shard's window holds are swept side by side
+    if (settings.probe_order == ProbeOrder::Random) {
+        job.random_order = true;
+        job.seed = settings.random_seed;
+        if (job.seed == 0) {
+            std::random_device rd;
+            job.seed = (static_cast<uint64_t>(rd()) << 32) | rd();
         }
+        job.host_order = Permutation(job.host_count, job.seed);
+    }
 
-        // Post host scan to io_context
-        asio::post(m_impl->io_context, [this, &settings, ip, &host_result, 
-                                        &host_semaphore_mutex, &host_semaphore_cv, 
-                                        &active_hosts]() {
-            try {
-                scanHost(ip, settings.ports, settings.timeout_ms, host_result);
-                m_impl->completed_hosts++;
-                m_impl->updateProgress(ip);
-            } catch (...) {
-                // Handle errors gracefully
-            }
-
-            // Release semaphore slot
-            {
-                std::lock_guard<std::mutex> lock(host_semaphore_mutex);
-                active_hosts--;
-                m_impl->pending_operations--;
-            }
-            host_semaphore_cv.notify_one();
-            m_impl->completion_cv.notify_one();
-        });
+    // Bound the hosts held in memory, in progress or awaiting delivery
+    job.max_buffered_hosts = settings.max_buffered_hosts;
+    if (job.max_buffered_hosts == 0) {
+        job.max_buffered_hosts = max_in_flight + Impl::DEFAULT_RESULT_BUFFER_HOSTS;
     }
 
-    // Wait for all operations to complete
-    {
-        std::unique_lock<std::mutex> lock(host_semaphore_mutex);
-        m_impl->completion_cv.wait(lock, [this]() {
-            return m_impl->pending_operations.load() == 0;
-        });
+    // Shards: at most one per MIN_SHARD_WINDOW probes of the window and one
+    // per host, starting where the previous scan's shards ended so that
+    // concurrent scans spread over the engine's threads. Each owns an equal
+    // share of the targets, handed out in blocks small enough to steal. A
+    // simulated scan keeps to one shard, so one virtual clock orders all of
+    // its events.
+    const size_t engine_shards = m_impl->shards.size();
+    const size_t shard_count = m_impl->simulated ? 1 : std::max<size_t>(1, std::min({ engine_shards,
+        max_in_flight / EngineOptions::MIN_SHARD_WINDOW, host_count }));
+    const uint64_t block_size = std::clamp<uint64_t>(job.host_count / (shard_count * Impl::BLOCKS_PER_SHARD),
+                                                     1, Impl::MAX_BLOCK_HOSTS);
+    job.blocks = std::make_unique<TargetBlocks>(job.host_count, shard_count, block_size);
+
+    const size_t first_shard = m_impl->next_shard.fetch_add(shard_count) % engine_shards;
+    for (size_t i = 0; i < shard_count; ++i) {
+        Impl::Shard& engine_shard = *m_impl->shards[(first_shard + i) % engine_shards];
+        auto shard = std::make_unique<ShardJob>(job, i, engine_shard.io, engine_shard.primary(),
+                                                engine_shard.sockets);
+        shard->max_in_flight = max_in_flight / shard_count + (i < max_in_flight % shard_count ? 1 : 0);
+        shard->congestion = CongestionController(std::max<size_t>(1, min_in_flight / shard_count),
+                                                 shard->max_in_flight);
+        shard->timeouts = AdaptiveTimeout(static_cast<uint32_t>(Impl::MIN_TIMEOUT_MS), job.timeout_ms);
+        shard->sweep_width = shard->max_in_flight;
+        m_impl->fillProbePool(*shard);
+        job.shards.push_back(std::move(shard));
     }
 
-    // Stop thread pool
-    m_impl->stopThreadPool();
+    // Snapshots are sampled off the io threads at the configured interval
+    ProgressReporter reporter(progressCallback, std::chrono::milliseconds(settings.progress_interval_ms),
+                              job.progress, host_count, port_count * host_count,
+                              [&job](ScanProgress& progress) { Impl::sampleProgress(job, progress); });
 
-    return result;
-}
+    // Each shard primes its window on its own thread. A control may pause
+    // or cancel the job from here until its subscription is reset.
+    ControlSubscription subscription(control,
+        [this, &job](bool paused) { m_impl->setPaused(job, paused); },
+        [this, &job]() { m_impl->stop(job, true); });
+    for (auto& shard : job.shards) {
+        m_impl->prime(*shard);
+    }
 
-void AsyncScanEngine::scanHost(const std::string& ip, const std::vector<uint16_t>& ports,
-                                uint32_t timeout_ms, HostResult& result) {
-    // Clamp timeout
-    timeout_ms = std::max(static_cast<uint32_t>(Impl::MIN_TIMEOUT_MS),
-                         std::min(static_cast<uint32_t>(Impl::MAX_TIMEOUT_MS), timeout_ms));
-
-    // Prepare port results
-    std::vector<PortResult> port_results(ports.size());
-    std::atomic<size_t> completed_ports{0};
-    std::mutex port_mutex;
-    std::condition_variable port_cv;
-
-    // Limit concurrent ports per host
-    size_t max_concurrent_ports = std::min(ports.size(), Impl::DEFAULT_MAX_PORTS_PER_HOST);
-    std::atomic<size_t> active_ports{0};
-
-    // Scan each port
-    for (size_t i = 0; i < ports.size(); ++i) {
-        uint16_t port = ports[i];
-        PortResult& port_result = port_results[i];
-        port_result.port = port;
-        port_result.is_open = false;
-
-        // Wait for slot
+    // Deliver hosts on the calling thread as they complete
+    std::exception_ptr sink_error;
+    std::deque<std::unique_ptr<HostState>> batch;
+    for (;;) {
         {
-            std::unique_lock<std::mutex> lock(port_mutex);
-            port_cv.wait(lock, [&]() {
-                return active_ports.load() < max_concurrent_ports;
+            std::unique_lock<std::mutex> lock(job.mutex);
+            job.ready_cv.wait(lock, [&job]() {
+                return !job.ready.empty() || job.drained();
             });
-            active_ports++;
-        }
-
-        // Create socket and endpoint
-        auto socket = std::make_shared<asio::ip::tcp::socket>(m_impl->io_context);
-        auto timer = std::make_shared<asio::steady_timer>(m_impl->io_context);
-        auto endpoint = asio::ip::tcp::endpoint(
-            asio::ip::make_address(ip), port);
-
-        // Shared state for timeout handling
-        auto timed_out = std::make_shared<std::atomic<bool>>(false);
-        auto completed = std::make_shared<std::atomic<bool>>(false);
-
-        // Set up timeout
-        timer->expires_after(std::chrono::milliseconds(timeout_ms));
-        timer->async_wait([socket, timed_out, completed](const asio::error_code& ec) {
-            if (!ec && !completed->load()) {
-                timed_out->store(true);
-                asio::error_code ignore_ec;
-                socket->close(ignore_ec);
+            if (job.ready.empty()) {
+                break;
             }
-        });
-
-        // Async connect
-        socket->async_connect(endpoint, 
-            [this, socket, timer, timed_out, completed, &port_result, ip, port, timeout_ms,
-             &port_mutex, &port_cv, &active_ports, &completed_ports]
-            (const asio::error_code& ec) {
-                completed->store(true);
-                timer->cancel();
-
-                if (!ec && !timed_out->load()) {
-                    port_result.is_open = true;
-                    
-                    // Attempt banner grabbing for open ports
-                    try {
-                        asio::error_code close_ec;
-                        socket->close(close_ec);
-                        
-                        // Grab banner on a separate connection (synchronous)
-                        port_result.banner = BannerGrabber::grabBanner(ip, port, timeout_ms / 2);
-                    } catch (...) {
-                        // Banner grabbing failed, but port is still open
-                    }
-                } else {
-                    asio::error_code ignore_ec;
-                    socket->close(ignore_ec);
-                }
+            batch.swap(job.ready);
+        }
 
-                // Update progress
-                m_impl->completed_ports++;
+        const size_t delivered = batch.size();
+        for (auto& host : batch) {
+            if (sink_error) {
+                break;
+            }
+            summary.alive_hosts += host->result.is_alive ? 1 : 0;
+            summary.open_ports += host->result.ports.size();
+            try {
+                sink(host->address, std::move(host->result));
+            } catch (...) {
+                // Stop dispatching; in-flight probes drain before rethrowing
+                sink_error = std::current_exception();
+                m_impl->stop(job, false);
+            }
+        }
+        batch.clear();
 
-                // Release slot
-                {
-                    std::lock_guard<std::mutex> lock(port_mutex);
-                    active_ports--;
-                    completed_ports++;
-                }
-                port_cv.notify_one();
-            });
+        // Shards only wait on the consumer when the buffer was full
+        if (job.buffered_hosts.fetch_sub(delivered) >= job.max_buffered_hosts) {
+            for (auto& shard : job.shards) {
+                m_impl->kick(*shard);
+            }
+        }
     }
 
-    // Wait for all ports to complete
-    {
-        std::unique_lock<std::mutex> lock(port_mutex);
-        port_cv.wait(lock, [&]() {
-            return completed_ports.load() == ports.size();
-        });
+    // Handlers still running hold their own reference to the job; only the
+    // pacing timers may still be pending
+    subscription.reset();
+    for (auto& shard : job.shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->pacing_timer->cancel();
     }
+    summary.cancelled = job.cancelled;
+    reporter.stop();
 
-    // Store results
-    result.ports = std::move(port_results);
-
-    // Determine if host is alive
-    for (const auto& pr : result.ports) {
-        if (pr.is_open) {
-            result.is_alive = true;
-            break;
-        }
+    if (sink_error) {
+        std::rethrow_exception(sink_error);
     }
+
+    return summary;
 }
 
 } // namespace netlens::internal
@@ -5,34 +5,34 @@
 
 #pragma once
 
-#include <netlens/Scanner.h>
+#include "ScanEngine.h"
+#include <netlens/EngineOptions.h>
 #include <memory>
-#include <vector>
-#include <string>
-
-// Forward declarations to avoid exposing Asio in header
-namespace asio {
-    class io_context;
-    class thread_pool;
-}
 
 namespace netlens::internal {
 
 /// <summary>
 /// Internal asynchronous scanning engine using Asio.
-/// Manages concurrent TCP port scanning across multiple hosts and ports.
+/// Drives every (host, port) probe as a non-blocking state machine. The
+/// engine is sharded: one io_context per thread, each run by that thread
+/// alone, so a probe's handlers never need a strand. A scan is split over
+/// several shards, each owning a share of its targets and of its in-flight
+/// window; a shard that runs out of targets steals blocks of hosts from
+/// the others. The shards are started once and serve every scan until the
+/// engine is destroyed; several scans may run at once.
 /// </summary>
-class AsyncScanEngine {
+class AsyncScanEngine : public ScanEngine {
 public:
     /// <summary>
-    /// Constructs the async scan engine.
+    /// Constructs the async scan engine and starts its shards.
     /// </summary>
-    AsyncScanEngine();
+    /// <param name="options">Thread count, pinning and socket backend</param>
+    explicit AsyncScanEngine(const EngineOptions& options = EngineOptions());
 
     /// <summary>
-    /// Destroys the engine and cleans up resources.
+    /// Drains and stops the shards. No scan may be running.
     /// </summary>
-    ~AsyncScanEngine();
+    ~AsyncScanEngine() override;
 
     // Non-copyable, non-movable
     AsyncScanEngine(const AsyncScanEngine&) = delete;
@@ -40,21 +40,27 @@ public:
     AsyncScanEngine(AsyncScanEngine&&) = delete;
     AsyncScanEngine& operator=(AsyncScanEngine&&) = delete;
 
+    using ScanEngine::executeScan;
+
     /// <summary>
-    /// Executes a scan based on settings.
-    /// Blocks until scan is complete.
+    /// Executes a scan and streams each host to the sink as soon as its last
+    /// probe completes. The io threads themselves never block. While the sink
+    /// is busy, at most max_buffered_hosts hosts are held and no new hosts
+    /// are started. If the sink throws, dispatch stops, in-flight probes
+    /// drain and the exception is rethrown. A pause or cancel closes every
+    /// probe in flight; after a pause they are sent again on resume.
     /// </summary>
     /// <param name="settings">Scan configuration</param>
+    /// <param name="sink">Receives completed hosts, in completion order</param>
     /// <param name="progressCallback">Optional progress callback</param>
-    /// <returns>Complete scan results</returns>
-    ScanResult executeScan(const ScanSettings& settings, netlens::ProgressCallback progressCallback);
+    /// <param name="control">Optional cancel and pause control</param>
+    /// <returns>Totals for the scan</returns>
+    ScanSummary executeScan(const ScanSettings& settings, const HostSink& sink,
+                            netlens::ProgressCallback progressCallback, ScanControl* control) override;
 
 private:
     struct Impl;
     std::unique_ptr<Impl> m_impl;
-
-    void scanHost(const std::string& ip, const std::vector<uint16_t>& ports,
-                  uint32_t timeout_ms, HostResult& result);
 };
 
 } // namespace netlens::internal
@@ -4,69 +4,59 @@
 // See the LICENSE file in the project root for details.
 
 #include "BannerGrabber.h"
-
-#define WIN32_LEAN_AND_MEAN
-#define NOMINMAX
-#include <winsock2.h>
-#include <ws2tcpip.h>
 #include <algorithm>
 #include <sstream>
-#include <cstring>
-
-#pragma comment(lib, "ws2_32.lib")
 
 namespace netlens::internal {
 
-std::string BannerGrabber::grabBanner(const std::string& ip, uint16_t port, uint32_t timeout_ms) {
-    // Clamp timeout
-    if (timeout_ms < MIN_BANNER_TIMEOUT_MS) timeout_ms = MIN_BANNER_TIMEOUT_MS;
-    if (timeout_ms > MAX_BANNER_TIMEOUT_MS) timeout_ms = MAX_BANNER_TIMEOUT_MS;
+namespace {
 
-    // Create socket
-    SOCKET sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
-    if (sock == INVALID_SOCKET) {
-        return "";
+bool isHttpPort(uint16_t port) {
+    switch (port) {
+        case 80:
+        case 8000:
+        case 8080:
+        case 8443:
+            return true;
+        default:
+            return false;
     }
+}
 
-    // Set timeout
-    DWORD timeout = timeout_ms;
-    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
-    setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
-
-    // Setup target address
-    sockaddr_in addr = {};
-    addr.sin_family = AF_INET;
-    addr.sin_port = htons(port);
-    if (inet_pton(AF_INET, ip.c_str(), &addr.sin_addr) != 1) {
-        closesocket(sock);
-        return "";
-    }
+} // namespace
 
-    // Connect
-    if (connect(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == SOCKET_ERROR) {
-        closesocket(sock);
-        return "";
+std::string_view BannerGrabber::requestFor(uint16_t port) {
+    if (isHttpPort(port)) {
+        return "GET / HTTP/1.0\r\nHost: scan\r\nUser-Agent: NetLens/1.0\r\n\r\n";
     }
+    return {};
+}
+
+bool BannerGrabber::needsRead(uint16_t port) {
+    return port != 443;
+}
 
+uint32_t BannerGrabber::clampTimeout(uint32_t timeout_ms) {
+    if (timeout_ms < MIN_BANNER_TIMEOUT_MS) return MIN_BANNER_TIMEOUT_MS;
+    if (timeout_ms > MAX_BANNER_TIMEOUT_MS) return MAX_BANNER_TIMEOUT_MS;
+    return timeout_ms;
+}
+
+std::string BannerGrabber::parseBanner(uint16_t port, std::string_view data) {
     std::string banner;
-    char buffer[MAX_BANNER_SIZE];
 
-    // Protocol-specific banner grabbing
+    // Protocol-specific banner parsing
     switch (port) {
         case 22: // SSH
         case 21: // FTP
         case 25: // SMTP
             // These services send banner first
-            {
-                int received = recv(sock, buffer, sizeof(buffer) - 1, 0);
-                if (received > 0) {
-                    buffer[received] = '\0';
-                    banner = std::string(buffer, received);
-                    // Extract first line
-                    size_t newline = banner.find_first_of("\r\n");
-                    if (newline != std::string::npos) {
-                        banner = banner.substr(0, newline);
-                    }
+            if (!data.empty()) {
+                banner = std::string(data);
+                // Extract first line
+                size_t newline = banner.find_first_of("\r\n");
+                if (newline != std::string::npos) {
+                    banner = banner.substr(0, newline);
                 }
             }
             break;
@@ -75,38 +65,31 @@ std::string BannerGrabber::grabBanner(const std::string& ip, uint16_t port, uint
         case 8000:
         case 8080:
         case 8443:
-            // HTTP - send request first
-            {
-                const char* request = "GET / HTTP/1.0\r\nHost: scan\r\nUser-Agent: NetLens/1.0\r\n\r\n";
-                send(sock, request, static_cast<int>(std::strlen(request)), 0);
-
-                int received = recv(sock, buffer, sizeof(buffer) - 1, 0);
-                if (received > 0) {
-                    buffer[received] = '\0';
-                    std::string response(buffer, received);
-                    
-                    // Parse HTTP response
-                    std::istringstream iss(response);
-                    std::string http_version, status_code;
-                    iss >> http_version >> status_code;
-
-                    banner = http_version + " " + status_code;
-
-                    // Look for Server header
-                    size_t server_pos = response.find("Server:");
-                    if (server_pos == std::string::npos) {
-                        server_pos = response.find("server:");
-                    }
-                    if (server_pos != std::string::npos) {
-                        size_t line_end = response.find("\r\n", server_pos);
-                        if (line_end != std::string::npos) {
-                            std::string server_line = response.substr(server_pos + 7, line_end - server_pos - 7);
-                            // Trim whitespace
-                            server_line.erase(0, server_line.find_first_not_of(" \t"));
-                            server_line.erase(server_line.find_last_not_of(" \t\r\n") + 1);
-                            if (!server_line.empty()) {
-                                banner += " (" + server_line + ")";
-                            }
+            // HTTP - response to the GET sent by the engine
+            if (!data.empty()) {
+                std::string response(data);
+
+                // Parse HTTP response
+                std::istringstream iss(response);
+                std::string http_version, status_code;
+                iss >> http_version >> status_code;
+
+                banner = http_version + " " + status_code;
+
+                // Look for Server header
+                size_t server_pos = response.find("Server:");
+                if (server_pos == std::string::npos) {
+                    server_pos = response.find("server:");
+                }
+                if (server_pos != std::string::npos) {
+                    size_t line_end = response.find("\r\n", server_pos);
+                    if (line_end != std::string::npos) {
+                        std::string server_line = response.substr(server_pos + 7, line_end - server_pos - 7);
+                        // Trim whitespace
+                        server_line.erase(0, server_line.find_first_not_of(" \t"));
+                        server_line.erase(server_line.find_last_not_of(" \t\r\n") + 1);
+                        if (!server_line.empty()) {
+                            banner += " (" + server_line + ")";
                         }
                     }
                 }
@@ -118,27 +101,22 @@ std::string BannerGrabber::grabBanner(const std::string& ip, uint16_t port, uint
             break;
 
         default:
-            // Try to read any data
-            {
-                int received = recv(sock, buffer, sizeof(buffer) - 1, 0);
-                if (received > 0) {
-                    buffer[received] = '\0';
-                    banner = std::string(buffer, received);
-                    // Limit length
-                    if (banner.length() > 100) {
-                        banner = banner.substr(0, 100) + "...";
-                    }
-                    // Extract first line
-                    size_t newline = banner.find_first_of("\r\n");
-                    if (newline != std::string::npos) {
-                        banner = banner.substr(0, newline);
-                    }
+            // Use whatever the service sent
+            if (!data.empty()) {
+                banner = std::string(data);
+                // Limit length
+                if (banner.length() > 100) {
+                    banner = banner.substr(0, 100) + "...";
+                }
+                // Extract first line
+                size_t newline = banner.find_first_of("\r\n");
+                if (newline != std::string::npos) {
+                    banner = banner.substr(0, newline);
                 }
             }
             break;
     }
 
-    closesocket(sock);
     return banner;
 }
 
@@ -6,29 +6,53 @@
 #pragma once
 
 #include <string>
+#include <string_view>
+#include <cstddef>
 #include <cstdint>
 
 namespace netlens::internal {
 
 /// <summary>
 /// Service-specific banner grabbing for common protocols.
+/// Holds only the protocol knowledge; the I/O runs asynchronously on the
+/// connection the scan engine already opened.
 /// </summary>
 class BannerGrabber {
 public:
     /// <summary>
-    /// Attempts to grab a service banner from a target host:port.
-    /// Creates a new connection, grabs banner, and closes.
+    /// Maximum number of bytes read from a service when grabbing a banner.
+    /// </summary>
+    static constexpr size_t MAX_BANNER_SIZE = 1024;
+
+    /// <summary>
+    /// Returns the request that must be sent before the service answers
+    /// (e.g. an HTTP GET), or an empty view for services that speak first.
+    /// </summary>
+    /// <param name="port">Target port number</param>
+    static std::string_view requestFor(uint16_t port);
+
+    /// <summary>
+    /// Returns true if the banner requires reading from the connection.
+    /// Services identified by port alone (e.g. TLS) are not read.
     /// </summary>
-    /// <param name="ip">Target IP address</param>
     /// <param name="port">Target port number</param>
-    /// <param name="timeout_ms">Operation timeout in milliseconds</param>
-    /// <returns>Banner string if successful, empty string otherwise</returns>
-    static std::string grabBanner(const std::string& ip, 
-                                   uint16_t port, 
-                                   uint32_t timeout_ms);
+    static bool needsRead(uint16_t port);
+
+    /// <summary>
+    /// Turns the bytes received from a service into a display banner.
+    /// </summary>
+    /// <param name="port">Target port number</param>
+    /// <param name="data">Bytes received (may be empty)</param>
+    /// <returns>Banner string if recognized, empty string otherwise</returns>
+    static std::string parseBanner(uint16_t port, std::string_view data);
+
+    /// <summary>
+    /// Clamps a banner read deadline to the supported range.
+    /// </summary>
+    /// <param name="timeout_ms">Requested timeout in milliseconds</param>
+    static uint32_t clampTimeout(uint32_t timeout_ms);
 
 private:
-    static constexpr size_t MAX_BANNER_SIZE = 1024;
     static constexpr uint32_t MIN_BANNER_TIMEOUT_MS = 100;
     static constexpr uint32_t MAX_BANNER_TIMEOUT_MS = 5000;
 };
@@ -0,0 +1,118 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "CongestionController.h"
+#include <algorithm>
+#include <cmath>
+
+namespace netlens::internal {
+
+CongestionController::CongestionController(size_t min_window, size_t max_window)
+    : m_min_window(std::max<size_t>(1, std::min(min_window, max_window)))
+    , m_max_window(std::max<size_t>(1, max_window))
+    , m_window(std::clamp(INITIAL_WINDOW, m_min_window, m_max_window))
+    , m_ssthresh(m_max_window) {}
+
+void CongestionController::onProbeComplete(ProbeSignal signal) {
+    // A probe the local stack refused never reached the network
+    if (signal != ProbeSignal::LocalError) {
+        ++m_epoch_probes;
+    }
+    switch (signal) {
+        case ProbeSignal::Answered:
+            ++m_stats.answered;
+            ++m_epoch_answers;
+            break;
+        case ProbeSignal::Refused:
+            ++m_stats.refused;
+            ++m_epoch_refusals;
+            break;
+        case ProbeSignal::TimedOut:
+            ++m_stats.timeouts;
+            ++m_epoch_timeouts;
+            break;
+        case ProbeSignal::LocalError:
+            ++m_stats.local_errors;
+            if (!m_epoch_decreased) {
+                decrease();
+                m_epoch_decreased = true;
+            }
+            break;
+        case ProbeSignal::Other:
+            break;
+    }
+
+    if (m_epoch_probes >= m_window) {
+        endEpoch();
+    }
+}
+
+bool CongestionController::significantChange(double change, double share, double baseline, double probes) {
+    // Small epochs are noisy: the change must also stand out from the
+    // binomial spread expected around the baseline
+    const double p = std::clamp(baseline, NOISE_FLOOR, 1.0 - NOISE_FLOOR);
+    const double spread = NOISE_SIGMAS * std::sqrt(p * (1.0 - p) / probes);
+    return change > std::max(share, spread);
+}
+
+void CongestionController::decrease() {
+    m_window = std::max(m_min_window, static_cast<size_t>(m_window * DECREASE_FACTOR));
+    m_ssthresh = m_window;
+    ++m_stats.decreases;
+}
+
+void CongestionController::endEpoch() {
+    const double probes = static_cast<double>(m_epoch_probes);
+    const double timeout_rate = m_epoch_timeouts / probes;
+    const double refusal_rate = m_epoch_refusals / probes;
+    const double answer_rate = m_epoch_answers / probes;
+
+    bool loss = false;
+    if (m_has_baseline) {
+        // A quarter of the probes that used to be answered now time out
+        loss = loss || significantChange(timeout_rate - m_timeout_baseline,
+                                         LOSS_SHARE * (1.0 - m_timeout_baseline),
+                                         m_timeout_baseline, probes);
+
+        // A jump in refusals is only suspicious when it displaces accepted
+        // connects; refusals replacing timeouts just mean hosts came into range
+        loss = loss || (refusal_rate > m_refusal_baseline &&
+                        m_answer_baseline >= NOISE_FLOOR &&
+                        significantChange(m_answer_baseline - answer_rate,
+                                          LOSS_SHARE * m_answer_baseline,
+                                          m_answer_baseline, probes));
+    }
+
+    // The baselines follow every epoch, so a lasting shift in the target
+    // mix is absorbed after a few epochs instead of pinning the window
+    if (!m_has_baseline) {
+        m_timeout_baseline = timeout_rate;
+        m_refusal_baseline = refusal_rate;
+        m_answer_baseline = answer_rate;
+        m_has_baseline = true;
+    } else {
+        m_timeout_baseline += BASELINE_WEIGHT * (timeout_rate - m_timeout_baseline);
+        m_refusal_baseline += BASELINE_WEIGHT * (refusal_rate - m_refusal_baseline);
+        m_answer_baseline += BASELINE_WEIGHT * (answer_rate - m_answer_baseline);
+    }
+
+    if (m_epoch_decreased) {
+        // Already cut for a local error during this epoch
+    } else if (loss) {
+        decrease();
+    } else if (m_window < m_ssthresh) {
+        m_window = std::min(m_window * 2, m_ssthresh);
+    } else {
+        m_window = std::min(m_window + ADDITIVE_STEP, m_max_window);
+    }
+
+    m_epoch_probes = 0;
+    m_epoch_timeouts = 0;
+    m_epoch_refusals = 0;
+    m_epoch_answers = 0;
+    m_epoch_decreased = false;
+}
+
+} // namespace netlens::internal
@@ -0,0 +1,102 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace netlens::internal {
+
+/// <summary>
+/// How a completed probe should be read by the congestion controller.
+/// </summary>
+enum class ProbeSignal {
+    /// <summary>Connection accepted.</summary>
+    Answered,
+    /// <summary>Connection actively refused (RST).</summary>
+    Refused,
+    /// <summary>No answer before the deadline.</summary>
+    TimedOut,
+    /// <summary>The local stack ran out of resources (descriptors, buffers, ports).</summary>
+    LocalError,
+    /// <summary>Any other failure; carries no congestion information.</summary>
+    Other
+};
+
+/// <summary>
+/// Running totals of the signals seen by the controller.
+/// </summary>
+struct CongestionStats {
+    uint64_t answered = 0;
+    uint64_t refused = 0;
+    uint64_t timeouts = 0;
+    uint64_t local_errors = 0;
+    uint64_t decreases = 0;
+};
+
+/// <summary>
+/// AIMD controller for the in-flight connect window.
+/// Completions are grouped into epochs of one window each, roughly one
+/// round trip. At the end of an epoch the window doubles while below the
+/// slow-start threshold and grows additively above it, unless the epoch
+/// shows loss: a quarter of the probes that used to be answered now timing
+/// out (firewalled ports time out by design, so only a rise over the
+/// smoothed baseline counts), or refusals taking a quarter of the accepted
+/// connects, as overloaded middleboxes answer with resets. Loss halves the
+/// window and sets the threshold. A local resource error halves it at once,
+/// at most once per epoch, since every probe sent meanwhile would fail too.
+/// The window stays within [min_window, max_window]. Not thread-safe;
+/// callers serialize access.
+/// </summary>
+class CongestionController {
+public:
+    CongestionController(size_t min_window, size_t max_window);
+
+    /// <summary>
+    /// Current number of probes allowed in flight.
+    /// </summary>
+    size_t window() const { return m_window; }
+
+    /// <summary>
+    /// Records one completed probe.
+    /// </summary>
+    void onProbeComplete(ProbeSignal signal);
+
+    const CongestionStats& stats() const { return m_stats; }
+
+private:
+    static constexpr size_t INITIAL_WINDOW = 64;
+    static constexpr size_t ADDITIVE_STEP = 8;
+    static constexpr double DECREASE_FACTOR = 0.5;
+    static constexpr double BASELINE_WEIGHT = 0.25;
+    static constexpr double LOSS_SHARE = 0.25;
+    static constexpr double NOISE_SIGMAS = 4.0;
+    static constexpr double NOISE_FLOOR = 0.05;
+
+    void decrease();
+    void endEpoch();
+    static bool significantChange(double change, double share, double baseline, double probes);
+
+    size_t m_min_window;
+    size_t m_max_window;
+    size_t m_window;
+    size_t m_ssthresh;
+
+    size_t m_epoch_probes = 0;
+    size_t m_epoch_timeouts = 0;
+    size_t m_epoch_refusals = 0;
+    size_t m_epoch_answers = 0;
+    bool m_epoch_decreased = false;
+
+    bool m_has_baseline = false;
+    double m_timeout_baseline = 0.0;
+    double m_refusal_baseline = 0.0;
+    double m_answer_baseline = 0.0;
+
+    CongestionStats m_stats;
+};
+
+} // namespace netlens::internal
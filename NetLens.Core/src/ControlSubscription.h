@@ -0,0 +1,52 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#pragma once
+
+#include <netlens/ScanControl.h>
+#include <functional>
+#include <optional>
+#include <stop_token>
+
+namespace netlens::internal {
+
+/// <summary>
+/// Connects an engine's pause and cancel handlers to a ScanControl for the
+/// lifetime of one scan. The pause handler is called at once with the
+/// current state; the cancel handler at once if already cancelled. Once
+/// reset or destroyed, neither handler is running or will run again.
+/// </summary>
+class ControlSubscription {
+public:
+    ControlSubscription(ScanControl* control, ScanControl::PauseListener onPause, std::function<void()> onCancel)
+        : m_control(control) {
+        if (!m_control) {
+            return;
+        }
+        m_listener = m_control->addPauseListener(std::move(onPause));
+        m_on_cancel.emplace(m_control->stopToken(), std::move(onCancel));
+    }
+
+    ~ControlSubscription() { reset(); }
+
+    ControlSubscription(const ControlSubscription&) = delete;
+    ControlSubscription& operator=(const ControlSubscription&) = delete;
+
+    void reset() {
+        if (!m_control) {
+            return;
+        }
+        m_on_cancel.reset();
+        m_control->removePauseListener(m_listener);
+        m_control = nullptr;
+    }
+
+private:
+    ScanControl* m_control;
+    size_t m_listener = 0;
+    std::optional<std::stop_callback<std::function<void()>>> m_on_cancel;
+};
+
+} // namespace netlens::internal
@@ -0,0 +1,244 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "DeltaScan.h"
+#include "IpRange.h"
+#include "Permutation.h"
+#include "TargetSpec.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <string_view>
+
+namespace netlens::internal {
+
+namespace {
+
+struct PortState {
+    uint16_t port;
+    std::string_view banner;
+};
+
+} // namespace
+
+DeltaScan::DeltaScan(const ScanSettings& settings, const ScanBaseline& baseline, const DeltaOptions& options)
+    : m_baseline(baseline.results())
+    , m_options(options)
+    , m_range_mask(0)
+    , m_pass(Pass::Primary)
+    , m_hosts_scanned(0) {
+    const unsigned prefix = std::min<unsigned>(options.range_prefix, 32);
+    m_range_mask = prefix == 0 ? 0 : ~uint32_t{ 0 } << (32 - prefix);
+
+    // Ports the baseline did not probe cannot be compared; an export
+    // without settings is assumed to have probed the same ports
+    m_ports = settings.ports;
+    std::sort(m_ports.begin(), m_ports.end());
+    m_ports.erase(std::unique(m_ports.begin(), m_ports.end()), m_ports.end());
+    std::vector<uint16_t> baseline_ports = m_baseline.settings().ports;
+    if (!baseline_ports.empty()) {
+        std::sort(baseline_ports.begin(), baseline_ports.end());
+        std::vector<uint16_t> common;
+        std::set_intersection(m_ports.begin(), m_ports.end(), baseline_ports.begin(), baseline_ports.end(),
+                              std::back_inserter(common));
+        m_ports = std::move(common);
+    }
+
+    const IntervalSet targets = TargetSpec::resolve(settings);
+    if (options.dead_ranges == DeadRangePolicy::Probe) {
+        m_primary = targets;
+        return;
+    }
+
+    // A range is dead when the baseline holds hosts in it and none is alive;
+    // only those recorded hosts are treated as dead, the rest of the range
+    // is unknown and scanned first
+    std::vector<IpRange> dead;
+    const auto hosts = m_baseline.hosts();
+    for (size_t begin = 0; begin < hosts.size();) {
+        const uint32_t range = rangeOf(hosts[begin].address);
+        size_t end = begin;
+        bool alive = false;
+        while (end < hosts.size() && rangeOf(hosts[end].address) == range) {
+            alive = alive || hosts[end].is_alive;
+            ++end;
+        }
+        if (!alive) {
+            for (size_t i = begin; i < end; ++i) {
+                dead.emplace_back(hosts[i].address, hosts[i].address);
+            }
+        }
+        begin = end;
+    }
+
+    const IntervalSet dead_targets = targets.intersect(IntervalSet::fromRanges(std::move(dead)));
+    m_primary = targets.subtract(dead_targets);
+    if (options.dead_ranges == DeadRangePolicy::Deprioritize) {
+        m_dead = dead_targets;
+        return;
+    }
+
+    // Sample evenly spaced hosts of each dead range, starting at an offset
+    // derived from the range so repeated runs probe the same hosts
+    const double ratio = std::clamp(options.sample_ratio, 0.0, 1.0);
+    std::vector<IpRange> sample;
+    std::vector<uint32_t> members;
+    auto flush = [&]() {
+        if (members.empty()) {
+            return;
+        }
+        const size_t count = std::clamp<size_t>(
+            static_cast<size_t>(std::ceil(members.size() * ratio)), 1, members.size());
+        const size_t stride = members.size() / count;
+        const size_t offset = static_cast<size_t>(Permutation::mix(rangeOf(members.front())) % stride);
+        for (size_t i = 0; i < members.size(); ++i) {
+            if (i % stride == offset && i / stride < count) {
+                sample.emplace_back(members[i], members[i]);
+            } else {
+                m_unsampled.push_back(members[i]);
+            }
+        }
+        members.clear();
+    };
+    for (uint32_t address : dead_targets) {
+        if (!members.empty() && rangeOf(address) != rangeOf(members.front())) {
+            flush();
+        }
+        members.push_back(address);
+    }
+    flush();
+    m_dead = IntervalSet::fromRanges(std::move(sample));
+}
+
+std::optional<IntervalSet> DeltaScan::nextPass() {
+    for (;;) {
+        switch (m_pass) {
+        case Pass::Primary:
+            m_pass = Pass::Dead;
+            if (!m_primary.empty()) {
+                return m_primary;
+            }
+            break;
+
+        case Pass::Dead:
+            m_pass = m_options.dead_ranges == DeadRangePolicy::Sample ? Pass::Escalation : Pass::Done;
+            if (!m_dead.empty()) {
+                return m_dead;
+            }
+            break;
+
+        case Pass::Escalation: {
+            m_pass = Pass::Done;
+            std::sort(m_answered_ranges.begin(), m_answered_ranges.end());
+            std::vector<IpRange> rest;
+            std::vector<uint32_t> skipped;
+            for (uint32_t address : m_unsampled) {
+                if (std::binary_search(m_answered_ranges.begin(), m_answered_ranges.end(), rangeOf(address))) {
+                    rest.emplace_back(address, address);
+                } else {
+                    skipped.push_back(address);
+                }
+            }
+            m_unsampled = std::move(skipped);
+            if (!rest.empty()) {
+                return IntervalSet::fromRanges(std::move(rest));
+            }
+            break;
+        }
+
+        case Pass::Done:
+            return std::nullopt;
+        }
+    }
+}
+
+bool DeltaScan::comparable(uint16_t port) const {
+    return std::binary_search(m_ports.begin(), m_ports.end(), port);
+}
+
+void DeltaScan::record(uint32_t address, const HostResult& host) {
+    ++m_hosts_scanned;
+    if (host.is_alive) {
+        m_answered_ranges.push_back(rangeOf(address));
+    }
+
+    std::vector<PortState> before;
+    bool was_alive = false;
+    if (const auto index = m_baseline.findHost(address)) {
+        was_alive = m_baseline.hostAt(*index).is_alive;
+        for (const CompactPort& port : m_baseline.openPorts(*index)) {
+            if (comparable(port.port)) {
+                before.push_back({ port.port, m_baseline.banner(port.banner) });
+            }
+        }
+    }
+
+    std::vector<PortState> after;
+    for (const auto& port : host.ports) {
+        if (port.is_open && comparable(port.port)) {
+            after.push_back({ port.port, port.banner });
+        }
+    }
+
+    const auto by_port = [](const PortState& a, const PortState& b) { return a.port < b.port; };
+    std::sort(before.begin(), before.end(), by_port);
+    std::sort(after.begin(), after.end(), by_port);
+
+    const std::string ip = IpRange::toString(address);
+    const auto emit = [&](ChangeKind kind, uint16_t port, std::string_view previous, std::string_view now) {
+        ScanChange change;
+        change.kind = kind;
+        change.address = ip;
+        change.port = port;
+        change.previous_banner = previous;
+        change.banner = now;
+        m_changes.emplace_back(address, std::move(change));
+    };
+
+    if (host.is_alive && !was_alive) {
+        emit(ChangeKind::HostAppeared, 0, {}, {});
+    } else if (!host.is_alive && was_alive) {
+        emit(ChangeKind::HostVanished, 0, {}, {});
+    }
+
+    // Merge the two port lists, both sorted
+    size_t i = 0;
+    size_t j = 0;
+    while (i < before.size() || j < after.size()) {
+        if (j == after.size() || (i < before.size() && before[i].port < after[j].port)) {
+            emit(ChangeKind::PortClosed, before[i].port, before[i].banner, {});
+            ++i;
+        } else if (i == before.size() || after[j].port < before[i].port) {
+            emit(ChangeKind::PortOpened, after[j].port, {}, after[j].banner);
+            ++j;
+        } else {
+            // A banner that is missing on one side is usually a slow or
+            // failed grab, not a change of service
+            if (!before[i].banner.empty() && !after[j].banner.empty() && before[i].banner != after[j].banner) {
+                emit(ChangeKind::BannerChanged, after[j].port, before[i].banner, after[j].banner);
+            }
+            ++i;
+            ++j;
+        }
+    }
+}
+
+ScanDelta DeltaScan::finish() {
+    // Each host is recorded once, so a stable sort keeps its changes in
+    // emission order: host change first, then ports ascending
+    std::stable_sort(m_changes.begin(), m_changes.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    ScanDelta delta;
+    delta.changes.reserve(m_changes.size());
+    for (auto& change : m_changes) {
+        delta.changes.push_back(std::move(change.second));
+    }
+    delta.hosts_scanned = m_hosts_scanned;
+    delta.hosts_skipped = m_unsampled.size();
+    return delta;
+}
+
+} // namespace netlens::internal
@@ -0,0 +1,66 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#pragma once
+
+#include <netlens/ScanDelta.h>
+#include <netlens/ScanSettings.h>
+#include "IntervalSet.h"
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace netlens::internal {
+
+/// <summary>
+/// Plans the passes of a delta scan and diffs each scanned host against
+/// the baseline. The first pass covers live and unknown ranges; dead
+/// ranges follow in full or sampled according to the options, and under
+/// Sample a last pass completes every dead range in which a sample
+/// answered.
+/// </summary>
+class DeltaScan {
+public:
+    DeltaScan(const ScanSettings& settings, const ScanBaseline& baseline, const DeltaOptions& options);
+
+    /// <summary>
+    /// Targets of the next pass, or nullopt when the scan is done. Empty
+    /// passes are skipped.
+    /// </summary>
+    std::optional<IntervalSet> nextPass();
+
+    /// <summary>
+    /// Compares a scanned host with the baseline.
+    /// </summary>
+    void record(uint32_t address, const HostResult& host);
+
+    /// <summary>
+    /// Returns the changes, ordered by address.
+    /// </summary>
+    ScanDelta finish();
+
+private:
+    enum class Pass { Primary, Dead, Escalation, Done };
+
+    uint32_t rangeOf(uint32_t address) const { return address & m_range_mask; }
+    bool comparable(uint16_t port) const;
+
+    const ScanResultStore& m_baseline;
+    DeltaOptions m_options;
+    uint32_t m_range_mask;
+    std::vector<uint16_t> m_ports;          // Probed by both scans, sorted
+
+    Pass m_pass;
+    IntervalSet m_primary;
+    IntervalSet m_dead;                     // Baseline-dead hosts in dead ranges
+    std::vector<uint32_t> m_unsampled;      // Dead hosts left out of the sample, ascending
+    std::vector<uint32_t> m_answered_ranges;
+
+    std::vector<std::pair<uint32_t, ScanChange>> m_changes;
+    size_t m_hosts_scanned;
+};
+
+} // namespace netlens::internal
@@ -0,0 +1,117 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "IntervalSet.h"
+#include <algorithm>
+
+namespace netlens::internal {
+
+IntervalSet::IntervalSet(std::vector<IpRange> normalized)
+    : m_ranges(std::move(normalized))
+{
+    m_offsets.reserve(m_ranges.size() + 1);
+    uint64_t offset = 0;
+    for (const auto& range : m_ranges) {
+        m_offsets.push_back(offset);
+        offset += range.size();
+    }
+    m_offsets.push_back(offset);
+}
+
+IntervalSet IntervalSet::fromRanges(std::vector<IpRange> ranges) {
+    std::sort(ranges.begin(), ranges.end(), [](const IpRange& a, const IpRange& b) {
+        return a.first() < b.first();
+    });
+
+    std::vector<IpRange> merged;
+    merged.reserve(ranges.size());
+    for (const auto& range : ranges) {
+        // Merge overlapping and adjacent intervals
+        if (!merged.empty() &&
+            static_cast<uint64_t>(range.first()) <= static_cast<uint64_t>(merged.back().last()) + 1) {
+            if (range.last() > merged.back().last()) {
+                merged.back() = IpRange(merged.back().first(), range.last());
+            }
+        } else {
+            merged.push_back(range);
+        }
+    }
+
+    return IntervalSet(std::move(merged));
+}
+
+IntervalSet IntervalSet::subtract(const IntervalSet& other) const {
+    std::vector<IpRange> result;
+    result.reserve(m_ranges.size());
+
+    // Both sides are sorted, so one linear sweep suffices
+    size_t j = 0;
+    for (const auto& range : m_ranges) {
+        uint64_t start = range.first();
+        const uint64_t last = range.last();
+
+        while (j < other.m_ranges.size() && other.m_ranges[j].last() < start) {
+            ++j;
+        }
+
+        size_t k = j;
+        while (start <= last && k < other.m_ranges.size() && other.m_ranges[k].first() <= last) {
+            const IpRange& hole = other.m_ranges[k];
+            if (hole.first() > start) {
+                result.emplace_back(static_cast<uint32_t>(start), hole.first() - 1);
+            }
+            start = std::max<uint64_t>(start, static_cast<uint64_t>(hole.last()) + 1);
+            ++k;
+        }
+
+        if (start <= last) {
+            result.emplace_back(static_cast<uint32_t>(start), static_cast<uint32_t>(last));
+        }
+    }
+
+    return IntervalSet(std::move(result));
+}
+
+IntervalSet IntervalSet::intersect(const IntervalSet& other) const {
+    std::vector<IpRange> result;
+
+    size_t i = 0;
+    size_t j = 0;
+    while (i < m_ranges.size() && j < other.m_ranges.size()) {
+        const IpRange& a = m_ranges[i];
+        const IpRange& b = other.m_ranges[j];
+        const uint32_t first = std::max(a.first(), b.first());
+        const uint32_t last = std::min(a.last(), b.last());
+        if (first <= last) {
+            result.emplace_back(first, last);
+        }
+        // Advance whichever interval ends first
+        if (a.last() < b.last()) {
+            ++i;
+        } else {
+            ++j;
+        }
+    }
+
+    return IntervalSet(std::move(result));
+}
+
+bool IntervalSet::contains(uint32_t address) const {
+    auto it = std::upper_bound(m_ranges.begin(), m_ranges.end(), address,
+                               [](uint32_t a, const IpRange& r) { return a < r.first(); });
+    if (it == m_ranges.begin()) {
+        return false;
+    }
+    return address <= std::prev(it)->last();
+}
+
+uint32_t IntervalSet::at(uint64_t index) const {
+    // Last offset not greater than index identifies the interval
+    auto it = std::upper_bound(m_offsets.begin(), m_offsets.end() - 1, index);
+    const size_t interval = static_cast<size_t>(it - m_offsets.begin()) - 1;
+    return m_ranges[interval].at(index - m_offsets[interval]);
+}
+
+} // namespace netlens::internal
@@ -0,0 +1,116 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#pragma once
+
+#include "IpRange.h"
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <vector>
+
+namespace netlens::internal {
+
+/// <summary>
+/// A normalized set of IPv4 addresses stored as sorted, non-overlapping,
+/// non-adjacent intervals. Overlapping inputs collapse so every address is
+/// visited once. Membership and indexed access are O(log n) in the number
+/// of intervals; iteration is lazy and O(1) per address.
+/// </summary>
+class IntervalSet {
+public:
+    /// <summary>
+    /// Forward iterator yielding each address in ascending order.
+    /// </summary>
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = uint32_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const uint32_t*;
+        using reference = uint32_t;
+
+        iterator() : m_set(nullptr), m_interval(0), m_value(0) {}
+        iterator(const IntervalSet* set, size_t interval, uint64_t value)
+            : m_set(set), m_interval(interval), m_value(value) {}
+
+        uint32_t operator*() const { return static_cast<uint32_t>(m_value); }
+
+        iterator& operator++() {
+            if (m_value < m_set->m_ranges[m_interval].last()) {
+                ++m_value;
+            } else if (++m_interval < m_set->m_ranges.size()) {
+                m_value = m_set->m_ranges[m_interval].first();
+            } else {
+                m_value = 0;
+            }
+            return *this;
+        }
+
+        iterator operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+
+        bool operator==(const iterator& other) const {
+            return m_interval == other.m_interval && m_value == other.m_value;
+        }
+        bool operator!=(const iterator& other) const { return !(*this == other); }
+
+    private:
+        const IntervalSet* m_set;
+        size_t m_interval;
+        uint64_t m_value;
+    };
+
+    IntervalSet() = default;
+
+    /// <summary>
+    /// Builds a normalized set from arbitrary, possibly overlapping ranges.
+    /// </summary>
+    static IntervalSet fromRanges(std::vector<IpRange> ranges);
+
+    /// <summary>
+    /// Returns the addresses of this set that are not in other.
+    /// </summary>
+    IntervalSet subtract(const IntervalSet& other) const;
+
+    /// <summary>
+    /// Returns the addresses in both this set and other.
+    /// </summary>
+    IntervalSet intersect(const IntervalSet& other) const;
+
+    /// <summary>
+    /// Total number of addresses (up to 2^32).
+    /// </summary>
+    uint64_t size() const { return m_offsets.empty() ? 0 : m_offsets.back(); }
+
+    bool empty() const { return m_ranges.empty(); }
+
+    /// <summary>
+    /// Returns true if the address belongs to the set.
+    /// </summary>
+    bool contains(uint32_t address) const;
+
+    /// <summary>
+    /// Returns the index-th address in ascending order. index must be below size().
+    /// </summary>
+    uint32_t at(uint64_t index) const;
+
+    /// <summary>
+    /// The normalized intervals, sorted ascending.
+    /// </summary>
+    std::span<const IpRange> intervals() const { return m_ranges; }
+
+    iterator begin() const { return m_ranges.empty() ? end() : iterator(this, 0, m_ranges.front().first()); }
+    iterator end() const { return iterator(this, m_ranges.size(), 0); }
+
+private:
+    explicit IntervalSet(std::vector<IpRange> normalized);
+
+    std::vector<IpRange> m_ranges;
+    // m_offsets[i] is the number of addresses before interval i; the last
+    // entry is the total size
+    std::vector<uint64_t> m_offsets;
+};
+
+} // namespace netlens::internal
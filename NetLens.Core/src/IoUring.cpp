@@ -0,0 +1,190 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "IoUring.h"
+
+#ifdef NETLENS_HAS_IO_URING
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+#include <vector>
+
+namespace netlens::internal {
+
+namespace {
+
+int setup(unsigned entries, io_uring_params& params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+}
+
+int enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+int registerOp(int fd, unsigned opcode, const void* arg, unsigned count) {
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, count));
+}
+
+template <typename T>
+T* at(void* base, unsigned offset) {
+    return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+}
+
+} // namespace
+
+IoUring::IoUring(unsigned entries, unsigned completion_entries)
+    : m_fd(-1)
+    , m_sq_ring(MAP_FAILED)
+    , m_sq_ring_size(0)
+    , m_cq_ring(MAP_FAILED)
+    , m_cq_ring_size(0)
+    , m_sqes(static_cast<io_uring_sqe*>(MAP_FAILED))
+    , m_sqes_size(0)
+    , m_sqe_tail(0) {
+    io_uring_params params{};
+    params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_SUBMIT_ALL | IORING_SETUP_SINGLE_ISSUER;
+    params.cq_entries = completion_entries;
+    m_fd = setup(entries, params);
+    if (m_fd < 0 && errno == EINVAL) {
+        // Kernels before 6.0 know neither flag
+        params = io_uring_params{};
+        params.flags = IORING_SETUP_CQSIZE;
+        params.cq_entries = completion_entries;
+        m_fd = setup(entries, params);
+    }
+    if (m_fd < 0) {
+        throw std::system_error(errno, std::system_category(), "io_uring_setup");
+    }
+
+    m_sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    m_cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+        m_sq_ring_size = m_cq_ring_size = std::max(m_sq_ring_size, m_cq_ring_size);
+    }
+
+    m_sq_ring = mmap(nullptr, m_sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                     m_fd, IORING_OFF_SQ_RING);
+    m_cq_ring = single_mmap ? m_sq_ring
+        : mmap(nullptr, m_cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+               m_fd, IORING_OFF_CQ_RING);
+    m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    m_sqes = static_cast<io_uring_sqe*>(mmap(nullptr, m_sqes_size, PROT_READ | PROT_WRITE,
+                                             MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES));
+    if (m_sq_ring == MAP_FAILED || m_cq_ring == MAP_FAILED || m_sqes == MAP_FAILED) {
+        const int error = errno;
+        release();
+        throw std::system_error(error, std::system_category(), "io_uring mmap");
+    }
+
+    m_sq_entries = params.sq_entries;
+    m_sq_head = at<unsigned>(m_sq_ring, params.sq_off.head);
+    m_sq_tail = at<unsigned>(m_sq_ring, params.sq_off.tail);
+    m_sq_mask = at<unsigned>(m_sq_ring, params.sq_off.ring_mask);
+    m_sq_array = at<unsigned>(m_sq_ring, params.sq_off.array);
+    m_sqe_tail = *m_sq_tail;
+
+    m_cq_head = at<unsigned>(m_cq_ring, params.cq_off.head);
+    m_cq_tail = at<unsigned>(m_cq_ring, params.cq_off.tail);
+    m_cq_mask = at<unsigned>(m_cq_ring, params.cq_off.ring_mask);
+    m_cqes = at<io_uring_cqe>(m_cq_ring, params.cq_off.cqes);
+}
+
+IoUring::~IoUring() {
+    release();
+}
+
+void IoUring::release() {
+    if (m_sqes != MAP_FAILED) {
+        munmap(m_sqes, m_sqes_size);
+        m_sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+    }
+    if (m_cq_ring != MAP_FAILED && m_cq_ring != m_sq_ring) {
+        munmap(m_cq_ring, m_cq_ring_size);
+    }
+    m_cq_ring = MAP_FAILED;
+    if (m_sq_ring != MAP_FAILED) {
+        munmap(m_sq_ring, m_sq_ring_size);
+        m_sq_ring = MAP_FAILED;
+    }
+    if (m_fd >= 0) {
+        close(m_fd);
+        m_fd = -1;
+    }
+}
+
+bool IoUring::supportsOps(std::initializer_list<uint8_t> ops) {
+    io_uring_params params{};
+    const int fd = setup(4, params);
+    if (fd < 0) {
+        return false;
+    }
+
+    constexpr unsigned PROBE_OPS = 256;
+    std::vector<unsigned char> buffer(sizeof(io_uring_probe) + PROBE_OPS * sizeof(io_uring_probe_op));
+    auto* probe = reinterpret_cast<io_uring_probe*>(buffer.data());
+    const bool probed = registerOp(fd, IORING_REGISTER_PROBE, probe, PROBE_OPS) == 0;
+    close(fd);
+    if (!probed) {
+        return false;
+    }
+    for (uint8_t op : ops) {
+        if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int IoUring::registerSparseFiles(unsigned count) {
+    io_uring_rsrc_register files{};
+    files.nr = count;
+    files.flags = IORING_RSRC_REGISTER_SPARSE;
+    return registerOp(m_fd, IORING_REGISTER_FILES2, &files, sizeof(files)) < 0 ? -errno : 0;
+}
+
+int IoUring::registerEventFd(int event_fd) {
+    return registerOp(m_fd, IORING_REGISTER_EVENTFD, &event_fd, 1) < 0 ? -errno : 0;
+}
+
+unsigned IoUring::freeEntries() const {
+    const unsigned head = std::atomic_ref<unsigned>(*m_sq_head).load(std::memory_order_acquire);
+    return m_sq_entries - (m_sqe_tail - head);
+}
+
+io_uring_sqe* IoUring::nextEntry() {
+    if (freeEntries() == 0) {
+        return nullptr;
+    }
+    const unsigned index = m_sqe_tail & *m_sq_mask;
+    m_sq_array[index] = index;
+    ++m_sqe_tail;
+    io_uring_sqe* entry = &m_sqes[index];
+    std::memset(entry, 0, sizeof(*entry));
+    return entry;
+}
+
+int IoUring::submit() {
+    std::atomic_ref<unsigned>(*m_sq_tail).store(m_sqe_tail, std::memory_order_release);
+    const unsigned head = std::atomic_ref<unsigned>(*m_sq_head).load(std::memory_order_acquire);
+    const unsigned pending = m_sqe_tail - head;
+    if (pending == 0) {
+        return 0;
+    }
+    int submitted;
+    do {
+        submitted = enter(m_fd, pending, 0, 0);
+    } while (submitted < 0 && errno == EINTR);
+    return submitted < 0 ? -errno : submitted;
+}
+
+} // namespace netlens::internal
+
+#endif // NETLENS_HAS_IO_URING
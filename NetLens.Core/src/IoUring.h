@@ -0,0 +1,120 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#pragma once
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+// IORING_OP_SOCKET and direct descriptors arrived with this constant
+#ifdef IORING_FILE_INDEX_ALLOC
+#define NETLENS_HAS_IO_URING 1
+#endif
+#endif
+
+#ifdef NETLENS_HAS_IO_URING
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+namespace netlens::internal {
+
+/// <summary>
+/// Minimal io_uring instance driven through the raw system calls: the
+/// submission and completion rings mapped into user space, sparse fixed
+/// file registration and completion notification through an eventfd.
+/// Not thread-safe; one thread submits and reaps.
+/// </summary>
+class IoUring {
+public:
+    /// <summary>
+    /// Sets up a ring with the given queue sizes.
+    /// </summary>
+    /// <exception cref="std::system_error">Thrown if the kernel refuses the ring</exception>
+    IoUring(unsigned entries, unsigned completion_entries);
+
+    ~IoUring();
+
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    /// <summary>
+    /// True if the running kernel supports every listed opcode.
+    /// </summary>
+    static bool supportsOps(std::initializer_list<uint8_t> ops);
+
+    /// <summary>
+    /// Registers a table of count empty fixed file slots.
+    /// </summary>
+    /// <returns>0, or a negative errno</returns>
+    int registerSparseFiles(unsigned count);
+
+    /// <summary>
+    /// Has the kernel signal the eventfd whenever completions are posted.
+    /// </summary>
+    /// <returns>0, or a negative errno</returns>
+    int registerEventFd(int event_fd);
+
+    /// <summary>
+    /// Submission queue entries that can be taken before the next submit.
+    /// </summary>
+    unsigned freeEntries() const;
+
+    /// <summary>
+    /// Takes a zeroed submission queue entry; null if the queue is full.
+    /// </summary>
+    io_uring_sqe* nextEntry();
+
+    /// <summary>
+    /// Hands every entry taken since the last call to the kernel.
+    /// </summary>
+    /// <returns>Entries consumed, or a negative errno</returns>
+    int submit();
+
+    /// <summary>
+    /// Calls f for each completion posted so far, then releases them.
+    /// </summary>
+    template <typename F>
+    unsigned reap(F&& f) {
+        unsigned head = *m_cq_head;
+        const unsigned tail = std::atomic_ref<unsigned>(*m_cq_tail).load(std::memory_order_acquire);
+        unsigned count = 0;
+        while (head != tail) {
+            f(m_cqes[head & *m_cq_mask]);
+            ++head;
+            ++count;
+        }
+        std::atomic_ref<unsigned>(*m_cq_head).store(head, std::memory_order_release);
+        return count;
+    }
+
+private:
+    void release();
+
+    int m_fd;
+    void* m_sq_ring;
+    size_t m_sq_ring_size;
+    void* m_cq_ring;
+    size_t m_cq_ring_size;
+    io_uring_sqe* m_sqes;
+    size_t m_sqes_size;
+
+    unsigned m_sq_entries;
+    unsigned* m_sq_head;
+    unsigned* m_sq_tail;
+    unsigned* m_sq_mask;
+    unsigned* m_sq_array;
+    unsigned m_sqe_tail;
+
+    unsigned* m_cq_head;
+    unsigned* m_cq_tail;
+    unsigned* m_cq_mask;
+    io_uring_cqe* m_cqes;
+};
+
+} // namespace netlens::internal
+
+#endif // NETLENS_HAS_IO_URING
@@ -4,8 +4,10 @@
 // See the LICENSE file in the project root for details.
 
 #include "IpRange.h"
+#include <charconv>
 #include <sstream>
 #include <regex>
+#include <system_error>
 
 namespace netlens::internal {
 
@@ -29,36 +31,38 @@ uint32_t IpRange::parse(const std::string& ip) {
 }
 
 std::string IpRange::toString(uint32_t ip) {
-    std::ostringstream oss;
-    oss << ((ip >> 24) & 0xFF) << '.'
-        << ((ip >> 16) & 0xFF) << '.'
-        << ((ip >> 8) & 0xFF) << '.'
-        << (ip & 0xFF);
-    return oss.str();
+    // Called once per emitted host, so format directly rather than via a
+    // stream. Every write is bounded, though 15 bytes always suffice.
+    char buffer[16];
+    char* const end = buffer + sizeof(buffer);
+    char* out = buffer;
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        const auto [next, ec] = std::to_chars(out, end, (ip >> shift) & 0xFF);
+        if (ec != std::errc()) {
+            throw IpRangeException("Cannot format IPv4 address");
+        }
+        out = next;
+        if (shift != 0) {
+            if (out == end) {
+                throw IpRangeException("Cannot format IPv4 address");
+            }
+            *out++ = '.';
+        }
+    }
+    return std::string(buffer, out);
 }
 
-std::vector<std::string> IpRange::enumerate(const std::string& start_ip, const std::string& end_ip) {
-    uint32_t start = parse(start_ip);
-    uint32_t end = parse(end_ip);
-
-    if (start > end) {
+IpRange::IpRange(uint32_t first, uint32_t last)
+    : m_first(first)
+    , m_last(last)
+{
+    if (first > last) {
         throw IpRangeException("Start IP must be less than or equal to end IP");
     }
+}
 
-    // Prevent enormous ranges that could cause memory issues
-    const uint32_t max_range = 65536; // 256 * 256
-    if (end - start + 1 > max_range) {
-        throw IpRangeException("IP range too large (maximum " + std::to_string(max_range) + " addresses)");
-    }
-
-    std::vector<std::string> addresses;
-    addresses.reserve(static_cast<size_t>(end - start + 1));
-
-    for (uint32_t ip = start; ip <= end; ++ip) {
-        addresses.push_back(toString(ip));
-    }
-
-    return addresses;
+IpRange IpRange::fromStrings(const std::string& start_ip, const std::string& end_ip) {
+    return IpRange(parse(start_ip), parse(end_ip));
 }
 
 bool IpRange::isValid(const std::string& ip) {
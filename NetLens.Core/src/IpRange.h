@@ -5,8 +5,10 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <string>
-#include <vector>
 #include <stdexcept>
 
 namespace netlens::internal {
@@ -21,10 +23,66 @@ public:
 };
 
 /// <summary>
-/// Utility for handling IPv4 address ranges.
+/// An inclusive range of IPv4 addresses, iterated lazily as 32-bit host-order
+/// integers. Memory use is constant whatever the size of the range.
 /// </summary>
 class IpRange {
 public:
+    /// <summary>
+    /// Forward iterator yielding each address in the range.
+    /// </summary>
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = uint32_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const uint32_t*;
+        using reference = uint32_t;
+
+        iterator() : m_value(0) {}
+        explicit iterator(uint64_t value) : m_value(value) {}
+
+        uint32_t operator*() const { return static_cast<uint32_t>(m_value); }
+        iterator& operator++() { ++m_value; return *this; }
+        iterator operator++(int) { iterator tmp = *this; ++m_value; return tmp; }
+        bool operator==(const iterator& other) const { return m_value == other.m_value; }
+        bool operator!=(const iterator& other) const { return m_value != other.m_value; }
+
+    private:
+        // 64-bit so the end iterator of a range ending at 255.255.255.255 is representable
+        uint64_t m_value;
+    };
+
+    /// <summary>
+    /// Constructs the range [first, last].
+    /// </summary>
+    /// <exception cref="IpRangeException">Thrown if first is greater than last</exception>
+    IpRange(uint32_t first, uint32_t last);
+
+    /// <summary>
+    /// Parses a range from two dotted IPv4 address strings (inclusive).
+    /// </summary>
+    /// <param name="start_ip">Starting IPv4 address string</param>
+    /// <param name="end_ip">Ending IPv4 address string</param>
+    /// <exception cref="IpRangeException">Thrown if the range is invalid</exception>
+    static IpRange fromStrings(const std::string& start_ip, const std::string& end_ip);
+
+    uint32_t first() const { return m_first; }
+    uint32_t last() const { return m_last; }
+
+    /// <summary>
+    /// Number of addresses in the range (up to 2^32).
+    /// </summary>
+    uint64_t size() const { return static_cast<uint64_t>(m_last) - m_first + 1; }
+
+    /// <summary>
+    /// Returns the address at the given offset from the start of the range.
+    /// </summary>
+    uint32_t at(uint64_t index) const { return static_cast<uint32_t>(m_first + index); }
+
+    iterator begin() const { return iterator(m_first); }
+    iterator end() const { return iterator(static_cast<uint64_t>(m_last) + 1); }
+
     /// <summary>
     /// Parses an IPv4 address string into a 32-bit integer.
     /// </summary>
@@ -40,21 +98,16 @@ public:
     /// <returns>IPv4 address in dotted notation</returns>
     static std::string toString(uint32_t ip);
 
-    /// <summary>
-    /// Generates all IPv4 addresses in a range from start to end (inclusive).
-    /// </summary>
-    /// <param name="start_ip">Starting IPv4 address string</param>
-    /// <param name="end_ip">Ending IPv4 address string</param>
-    /// <returns>Vector of IPv4 address strings</returns>
-    /// <exception cref="IpRangeException">Thrown if the range is invalid</exception>
-    static std::vector<std::string> enumerate(const std::string& start_ip, const std::string& end_ip);
-
     /// <summary>
     /// Validates that a string is a valid IPv4 address.
     /// </summary>
     /// <param name="ip">String to validate</param>
     /// <returns>True if valid, false otherwise</returns>
     static bool isValid(const std::string& ip);
+
+private:
+    uint32_t m_first;
+    uint32_t m_last;
 };
 
 } // namespace netlens::internal
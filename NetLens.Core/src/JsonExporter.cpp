@@ -4,78 +4,216 @@
 // See the LICENSE file in the project root for details.
 
 #include "netlens/JsonExporter.h"
+#include "JsonWriter.h"
 #include <json.hpp>
+#include <algorithm>
 #include <fstream>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 using json = nlohmann::json;
+using netlens::internal::JsonWriter;
 
 namespace netlens {
 
-std::string JsonExporter::toJson(const ScanResult& result, bool pretty) {
-    json j;
+namespace {
 
-    // Export settings
-    j["settings"] = {
-        {"startIp", result.settings.start_ip},
-        {"endIp", result.settings.end_ip},
-        {"ports", result.settings.ports},
-        {"timeoutMs", result.settings.timeout_ms},
-        {"maxConcurrency", result.settings.max_concurrency}
-    };
+// Host lists shorter than this are not worth a thread per slice
+constexpr size_t PARALLEL_MIN_HOSTS = 4096;
+constexpr size_t MAX_SLICES = 8;
 
-    // Export hosts
-    j["hosts"] = json::array();
-    for (const auto& host : result.hosts) {
-        json host_obj = {
-            {"ip", host.address},
-            {"isAlive", host.is_alive},
-            {"ports", json::array()}
-        };
-
-        for (const auto& port : host.ports) {
-            json port_obj = {
-                {"port", port.port},
-                {"isOpen", port.is_open}
-            };
-
-            if (!port.banner.empty()) {
-                port_obj["banner"] = port.banner;
-            }
+// Depth of the elements of the top-level "hosts" array
+constexpr size_t HOSTS_DEPTH = 2;
+
+// Rough serialized size of a host without ports and of a port, used to
+// reserve the output once
+constexpr size_t HOST_BYTES_ESTIMATE = 80;
+constexpr size_t PORT_BYTES_ESTIMATE = 64;
 
-            host_obj["ports"].push_back(port_obj);
+// Keys are written in sorted order, as nlohmann's std::map-backed objects
+// dump them, so the output is unchanged from the DOM-based exporter
+void writeHost(JsonWriter& writer, const HostResult& host) {
+    writer.beginObject();
+    writer.key("ip");
+    writer.value(host.address);
+    writer.key("isAlive");
+    writer.value(host.is_alive);
+    writer.key("ports");
+    writer.beginArray();
+    for (const auto& port : host.ports) {
+        writer.beginObject();
+        if (!port.banner.empty()) {
+            writer.key("banner");
+            writer.value(port.banner);
         }
+        writer.key("isOpen");
+        writer.value(port.is_open);
+        writer.key("port");
+        writer.value(port.port);
+        writer.endObject();
+    }
+    writer.endArray();
+    writer.endObject();
+}
+
+size_t estimateSize(const std::vector<HostResult>& hosts, size_t begin, size_t end) {
+    size_t bytes = 0;
+    for (size_t i = begin; i < end; ++i) {
+        bytes += HOST_BYTES_ESTIMATE + hosts[i].ports.size() * PORT_BYTES_ESTIMATE;
+    }
+    return bytes;
+}
 
-        j["hosts"].push_back(host_obj);
+void writeHosts(JsonWriter& writer, const std::vector<HostResult>& hosts, bool pretty) {
+    size_t slices = std::min(static_cast<size_t>(std::thread::hardware_concurrency()), MAX_SLICES);
+    if (hosts.size() < PARALLEL_MIN_HOSTS || slices < 2) {
+        for (const auto& host : hosts) {
+            writeHost(writer, host);
+        }
+        return;
     }
 
+    // Each slice is serialized into its own buffer as a continuation of the
+    // hosts array, then the buffers are appended in order
+    const size_t per_slice = (hosts.size() + slices - 1) / slices;
+    std::vector<std::future<std::string>> parts;
+    for (size_t begin = 0; begin < hosts.size(); begin += per_slice) {
+        const size_t end = std::min(begin + per_slice, hosts.size());
+        parts.push_back(std::async(std::launch::async, [&hosts, pretty, begin, end]() {
+            std::string text;
+            text.reserve(estimateSize(hosts, begin, end));
+            JsonWriter slice(text, pretty);
+            slice.resumeArray(HOSTS_DEPTH, begin);
+            for (size_t i = begin; i < end; ++i) {
+                writeHost(slice, hosts[i]);
+            }
+            return text;
+        }));
+    }
+
+    size_t begin = 0;
+    for (auto& part : parts) {
+        const std::string text = part.get();
+        const size_t count = std::min(per_slice, hosts.size() - begin);
+        writer.appendElements(text, count);
+        begin += count;
+    }
+}
+
+} // namespace
+
+std::string JsonExporter::toJson(const ScanResult& result, bool pretty) {
+    std::string out;
+    toJson(result, out, pretty);
+    return out;
+}
+
+void JsonExporter::toJson(const ScanResult& result, std::string& out, bool pretty) {
+    out.clear();
+    out.reserve(estimateSize(result.hosts, 0, result.hosts.size()) + 512);
+
+    size_t alive_hosts = 0;
+    for (const auto& host : result.hosts) {
+        alive_hosts += host.is_alive ? 1 : 0;
+    }
+
+    JsonWriter writer(out, pretty);
+    writer.beginObject();
+
+    // Export hosts
+    writer.key("hosts");
+    writer.beginArray();
+    writeHosts(writer, result.hosts, pretty);
+    writer.endArray();
+
     // Export metadata
-    j["metadata"] = {
-        {"version", "1.0"},
-        {"tool", "NetLens"},
-        {"totalHosts", result.hosts.size()},
-        {"aliveHosts", std::count_if(result.hosts.begin(), result.hosts.end(), 
-                                       [](const HostResult& h) { return h.is_alive; })}
-    };
-
-    return pretty ? j.dump(2) : j.dump();
+    writer.key("metadata");
+    writer.beginObject();
+    writer.key("aliveHosts");
+    writer.value(static_cast<uint64_t>(alive_hosts));
+    writer.key("tool");
+    writer.value("NetLens");
+    writer.key("totalHosts");
+    writer.value(static_cast<uint64_t>(result.hosts.size()));
+    writer.key("version");
+    writer.value("1.0");
+    writer.endObject();
+
+    // Export settings
+    writer.key("settings");
+    writer.beginObject();
+    writer.key("endIp");
+    writer.value(result.settings.end_ip);
+    writer.key("maxConcurrency");
+    writer.value(result.settings.max_concurrency);
+    writer.key("ports");
+    writer.beginArray();
+    for (uint16_t port : result.settings.ports) {
+        writer.value(port);
+    }
+    writer.endArray();
+    writer.key("startIp");
+    writer.value(result.settings.start_ip);
+    writer.key("timeoutMs");
+    writer.value(result.settings.timeout_ms);
+    writer.endObject();
+
+    writer.endObject();
 }
 
 bool JsonExporter::saveToFile(const ScanResult& result, const std::string& filepath, bool pretty) {
     try {
-        std::string json_str = toJson(result, pretty);
+        std::string json_str;
+        toJson(result, json_str, pretty);
         std::ofstream file(filepath);
-        
+
         if (!file.is_open()) {
             return false;
         }
 
-        file << json_str;
+        file.write(json_str.data(), static_cast<std::streamsize>(json_str.size()));
         file.close();
-        return true;
+        return static_cast<bool>(file);
     }
     catch (...) {
         return false;
     }
 }
 
+ScanResult JsonExporter::loadFromFile(const std::string& filepath) {
+    std::ifstream file(filepath, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open " + filepath);
+    }
+
+    try {
+        const json j = json::parse(file);
+
+        const json& settings = j.at("settings");
+        ScanResult result;
+        result.settings.start_ip = settings.value("startIp", std::string());
+        result.settings.end_ip = settings.value("endIp", std::string());
+        result.settings.ports = settings.value("ports", std::vector<uint16_t>());
+        result.settings.timeout_ms = settings.value("timeoutMs", result.settings.timeout_ms);
+        result.settings.max_concurrency = settings.value("maxConcurrency", result.settings.max_concurrency);
+
+        result.hosts.reserve(j.at("hosts").size());
+        for (const auto& host_obj : j.at("hosts")) {
+            HostResult host(host_obj.at("ip").get<std::string>(), host_obj.at("isAlive").get<bool>());
+            for (const auto& port_obj : host_obj.at("ports")) {
+                host.ports.emplace_back(port_obj.at("port").get<uint16_t>(),
+                                        port_obj.at("isOpen").get<bool>(),
+                                        port_obj.value("banner", std::string()));
+            }
+            result.hosts.push_back(std::move(host));
+        }
+        return result;
+    }
+    catch (const json::exception& e) {
+        throw std::runtime_error("Not a NetLens JSON export: " + filepath + " (" + e.what() + ")");
+    }
+}
+
 } // namespace netlens
@@ -0,0 +1,250 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "JsonWriter.h"
+#include <bit>
+#include <charconv>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NETLENS_JSON_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace netlens::internal {
+
+namespace {
+
+constexpr size_t INDENT = 2;
+
+/// <summary>
+/// Length of the plain prefix of text: bytes that are copied unchanged,
+/// i.e. printable ASCII other than quote and backslash.
+/// </summary>
+size_t plainPrefix(const char* text, size_t size) {
+    size_t i = 0;
+#ifdef NETLENS_JSON_SSE2
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i space = _mm_set1_epi8(0x20);
+    for (; i + 16 <= size; i += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+        // Signed compare: bytes >= 0x80 are negative and land in the control
+        // test, sending them to the UTF-8 check
+        const __m128i special = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+            _mm_cmpgt_epi8(space, chunk));
+        const int mask = _mm_movemask_epi8(special);
+        if (mask != 0) {
+            return i + static_cast<size_t>(std::countr_zero(static_cast<unsigned>(mask)));
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        const auto c = static_cast<unsigned char>(text[i]);
+        if (c < 0x20 || c >= 0x80 || c == '"' || c == '\\') {
+            break;
+        }
+    }
+    return i;
+}
+
+/// <summary>
+/// Length of the well-formed UTF-8 sequence starting at text, or 0 if it is
+/// malformed (overlong, surrogate, beyond U+10FFFF or truncated). For a
+/// malformed sequence, malformed is set to the bytes one U+FFFD replaces:
+/// the lead byte and the continuation bytes valid so far, so the byte that
+/// broke the sequence starts the next one, as nlohmann's decoder re-reads it.
+/// </summary>
+size_t utf8Sequence(const unsigned char* text, size_t size, size_t& malformed) {
+    const unsigned char lead = text[0];
+    size_t length;
+    unsigned char low = 0x80;
+    unsigned char high = 0xBF;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        if (lead == 0xE0) low = 0xA0;
+        if (lead == 0xED) high = 0x9F;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        if (lead == 0xF0) low = 0x90;
+        if (lead == 0xF4) high = 0x8F;
+    } else {
+        malformed = 1;
+        return 0;
+    }
+
+    size_t i = 1;
+    while (i < length && i < size && text[i] >= low && text[i] <= high) {
+        ++i;
+        low = 0x80;
+        high = 0xBF;
+    }
+    if (i < length) {
+        malformed = i;
+        return 0;
+    }
+    return length;
+}
+
+} // namespace
+
+void JsonWriter::escape(std::string& out, std::string_view text, bool replace_invalid) {
+    static constexpr char HEX[] = "0123456789abcdef";
+
+    out += '"';
+    const char* data = text.data();
+    size_t size = text.size();
+    while (size > 0) {
+        const size_t plain = plainPrefix(data, size);
+        out.append(data, plain);
+        data += plain;
+        size -= plain;
+        if (size == 0) {
+            break;
+        }
+
+        const auto c = static_cast<unsigned char>(*data);
+        if (c >= 0x80) {
+            size_t malformed = 0;
+            const size_t length = utf8Sequence(reinterpret_cast<const unsigned char*>(data), size, malformed);
+            if (length == 0) {
+                if (!replace_invalid) {
+                    throw std::invalid_argument("String is not valid UTF-8");
+                }
+                out += "\xEF\xBF\xBD";   // U+FFFD
+                data += malformed;
+                size -= malformed;
+                continue;
+            }
+            out.append(data, length);
+            data += length;
+            size -= length;
+            continue;
+        }
+
+        switch (c) {
+        case '"':  out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\b': out += "\\b"; break;
+        case '\f': out += "\\f"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default: {
+            const char unicode[] = { '\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0xF] };
+            out.append(unicode, sizeof(unicode));
+            break;
+        }
+        }
+        ++data;
+        --size;
+    }
+    out += '"';
+}
+
+void JsonWriter::newline(size_t depth) {
+    m_out += '\n';
+    m_out.append(depth * INDENT, ' ');
+}
+
+void JsonWriter::beforeValue() {
+    if (m_after_key) {
+        m_after_key = false;
+        return;
+    }
+    if (m_counts.empty()) {
+        return;
+    }
+    if (m_counts.back()++ > 0) {
+        m_out += ',';
+    }
+    if (m_pretty) {
+        newline(m_depth);
+    }
+}
+
+void JsonWriter::beginObject() {
+    beforeValue();
+    m_out += '{';
+    m_counts.push_back(0);
+    ++m_depth;
+}
+
+void JsonWriter::endObject() {
+    --m_depth;
+    if (m_counts.back() > 0 && m_pretty) {
+        newline(m_depth);
+    }
+    m_counts.pop_back();
+    m_out += '}';
+}
+
+void JsonWriter::beginArray() {
+    beforeValue();
+    m_out += '[';
+    m_counts.push_back(0);
+    ++m_depth;
+}
+
+void JsonWriter::endArray() {
+    --m_depth;
+    if (m_counts.back() > 0 && m_pretty) {
+        newline(m_depth);
+    }
+    m_counts.pop_back();
+    m_out += ']';
+}
+
+void JsonWriter::key(std::string_view name) {
+    if (m_counts.back()++ > 0) {
+        m_out += ',';
+    }
+    if (m_pretty) {
+        newline(m_depth);
+    }
+    escape(m_out, name, m_replace_invalid);
+    m_out += m_pretty ? ": " : ":";
+    m_after_key = true;
+}
+
+void JsonWriter::value(std::string_view text) {
+    beforeValue();
+    escape(m_out, text, m_replace_invalid);
+}
+
+void JsonWriter::value(bool flag) {
+    beforeValue();
+    m_out += flag ? "true" : "false";
+}
+
+void JsonWriter::value(uint64_t number) {
+    beforeValue();
+    char digits[20];
+    const auto end = std::to_chars(digits, digits + sizeof(digits), number).ptr;
+    m_out.append(digits, end);
+}
+
+void JsonWriter::value(int64_t number) {
+    beforeValue();
+    char digits[20];
+    const auto end = std::to_chars(digits, digits + sizeof(digits), number).ptr;
+    m_out.append(digits, end);
+}
+
+void JsonWriter::resumeArray(size_t depth, size_t count) {
+    m_depth = depth;
+    m_counts.assign(1, count);
+    m_after_key = false;
+}
+
+void JsonWriter::appendElements(std::string_view text, size_t count) {
+    m_out.append(text);
+    m_counts.back() += count;
+}
+
+} // namespace netlens::internal
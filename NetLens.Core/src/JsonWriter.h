@@ -0,0 +1,81 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace netlens::internal {
+
+/// <summary>
+/// Appends JSON text to a caller-owned buffer without building a document.
+/// Output is byte for byte what nlohmann::json::dump produces for the same
+/// values (dump(2) when pretty, dump() otherwise), provided the caller
+/// writes object keys in sorted order as nlohmann's std::map does. With
+/// replace_invalid, strings are escaped as dump(..., error_handler_t::replace)
+/// does instead of failing on invalid UTF-8.
+/// </summary>
+class JsonWriter {
+public:
+    JsonWriter(std::string& out, bool pretty, bool replace_invalid = false)
+        : m_out(out), m_pretty(pretty), m_replace_invalid(replace_invalid), m_depth(0), m_after_key(false) {}
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+
+    /// <summary>
+    /// Writes an object key; the next call writes its value.
+    /// </summary>
+    void key(std::string_view name);
+
+    void value(std::string_view text);
+    void value(const char* text) { value(std::string_view(text)); }
+    void value(bool flag);
+    void value(uint64_t number);
+    void value(int64_t number);
+    void value(uint32_t number) { value(static_cast<uint64_t>(number)); }
+    void value(uint16_t number) { value(static_cast<uint64_t>(number)); }
+
+    /// <summary>
+    /// Continues an array opened by another writer at the given nesting
+    /// depth, after count elements. Lets slices of a large array be
+    /// serialized independently and concatenated.
+    /// </summary>
+    void resumeArray(size_t depth, size_t count);
+
+    /// <summary>
+    /// Appends count array elements serialized by a resumed writer.
+    /// </summary>
+    void appendElements(std::string_view text, size_t count);
+
+    /// <summary>
+    /// Appends text as a JSON string literal, escaped as nlohmann does:
+    /// quote, backslash and control characters are escaped, everything else
+    /// is copied. Runs of plain bytes are found 16 at a time with SSE2 where
+    /// available. With replace_invalid, each malformed sequence becomes one
+    /// U+FFFD, as nlohmann's replace handler does.
+    /// </summary>
+    /// <exception cref="std::invalid_argument">Thrown if text is not valid UTF-8 and replace_invalid is false</exception>
+    static void escape(std::string& out, std::string_view text, bool replace_invalid = false);
+
+private:
+    void beforeValue();
+    void newline(size_t depth);
+
+    std::string& m_out;
+    bool m_pretty;
+    bool m_replace_invalid;
+    size_t m_depth;
+    bool m_after_key;
+    std::vector<size_t> m_counts;   // Elements written at each open level
+};
+
+} // namespace netlens::internal
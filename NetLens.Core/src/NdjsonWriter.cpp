@@ -0,0 +1,216 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "netlens/NdjsonWriter.h"
+#include "JsonWriter.h"
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using netlens::internal::JsonWriter;
+
+namespace netlens {
+
+namespace {
+
+// Lines are written as nlohmann's dump() wrote them: keys in sorted order,
+// compact. Host lines replace invalid UTF-8 in banners rather than fail
+
+void writeStrings(JsonWriter& writer, const std::vector<std::string>& values) {
+    writer.beginArray();
+    for (const auto& value : values) {
+        writer.value(value);
+    }
+    writer.endArray();
+}
+
+} // namespace
+
+NdjsonWriter::NdjsonWriter(const std::string& filepath, const ScanSettings& settings,
+                           size_t flush_bytes, std::chrono::milliseconds flush_interval)
+    : m_flush_bytes(flush_bytes)
+    , m_flush_interval(flush_interval)
+    , m_file(filepath, std::ios::binary | std::ios::trunc)
+    , m_buffer()
+    , m_last_flush(std::chrono::steady_clock::now())
+    , m_hosts_written(0)
+    , m_stopping(false) {
+    if (!m_file.is_open()) {
+        throw std::runtime_error("Cannot open " + filepath + " for writing");
+    }
+    m_buffer.reserve(m_flush_bytes);
+
+    JsonWriter writer(m_buffer, false);
+    writer.beginObject();
+    writer.key("endIp");
+    writer.value(settings.end_ip);
+    writer.key("excludes");
+    writeStrings(writer, settings.excludes);
+    writer.key("maxConcurrency");
+    writer.value(settings.max_concurrency);
+    writer.key("ports");
+    writer.beginArray();
+    for (uint16_t port : settings.ports) {
+        writer.value(port);
+    }
+    writer.endArray();
+    writer.key("startIp");
+    writer.value(settings.start_ip);
+    writer.key("targets");
+    writeStrings(writer, settings.targets);
+    writer.key("timeoutMs");
+    writer.value(settings.timeout_ms);
+    writer.key("type");
+    writer.value("settings");
+    writer.endObject();
+    m_buffer += '\n';
+    flushLocked();  // Tailing readers see the scan start right away
+
+    // Without an interval every host is flushed as it is written
+    if (m_flush_interval.count() > 0) {
+        m_flusher = std::thread([this]() { run(); });
+    }
+}
+
+NdjsonWriter::~NdjsonWriter() {
+    stopFlusher();
+    try {
+        if (m_file.is_open()) {
+            flushLocked();
+        }
+    }
+    catch (...) {
+    }
+}
+
+void NdjsonWriter::write(const HostResult& host) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_error) {
+        std::rethrow_exception(m_error);
+    }
+
+    JsonWriter writer(m_buffer, false, true);
+    writer.beginObject();
+    writer.key("closedPorts");
+    writer.value(host.closed_ports);
+    writer.key("filteredPorts");
+    writer.value(host.filtered_ports);
+    writer.key("ip");
+    writer.value(host.address);
+    writer.key("isAlive");
+    writer.value(host.is_alive);
+    writer.key("ports");
+    writer.beginArray();
+    for (const auto& port : host.ports) {
+        writer.beginObject();
+        if (!port.banner.empty()) {
+            writer.key("banner");
+            writer.value(port.banner);
+        }
+        writer.key("isOpen");
+        writer.value(port.is_open);
+        writer.key("port");
+        writer.value(port.port);
+        writer.endObject();
+    }
+    writer.endArray();
+    writer.key("type");
+    writer.value("host");
+    writer.endObject();
+    m_buffer += '\n';
+    ++m_hosts_written;
+
+    if (m_buffer.size() >= m_flush_bytes || m_flush_interval.count() <= 0) {
+        flushLocked();
+    }
+}
+
+void NdjsonWriter::finish(const ScanSummary& summary) {
+    stopFlusher();
+    if (m_error) {
+        std::rethrow_exception(m_error);
+    }
+
+    JsonWriter writer(m_buffer, false);
+    writer.beginObject();
+    writer.key("aliveHosts");
+    writer.value(static_cast<uint64_t>(summary.alive_hosts));
+    writer.key("hostsWritten");
+    writer.value(static_cast<uint64_t>(m_hosts_written));
+    writer.key("openPorts");
+    writer.value(static_cast<uint64_t>(summary.open_ports));
+    writer.key("tool");
+    writer.value("NetLens");
+    writer.key("totalHosts");
+    writer.value(static_cast<uint64_t>(summary.total_hosts));
+    writer.key("type");
+    writer.value("summary");
+    writer.key("version");
+    writer.value("1.0");
+    writer.endObject();
+    m_buffer += '\n';
+    flushLocked();
+    m_file.close();
+}
+
+void NdjsonWriter::flush() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_error) {
+        std::rethrow_exception(m_error);
+    }
+    flushLocked();
+}
+
+size_t NdjsonWriter::hostsWritten() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hosts_written;
+}
+
+void NdjsonWriter::run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stopping) {
+        // Size-triggered flushes move the deadline along
+        m_wake.wait_until(lock, m_last_flush + m_flush_interval, [this]() { return m_stopping; });
+        if (m_stopping) {
+            break;
+        }
+        if (std::chrono::steady_clock::now() >= m_last_flush + m_flush_interval) {
+            try {
+                flushLocked();
+            } catch (...) {
+                // Reported by the next write, flush or finish
+                m_error = std::current_exception();
+                break;
+            }
+        }
+    }
+}
+
+void NdjsonWriter::stopFlusher() {
+    if (!m_flusher.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_flusher.join();
+}
+
+void NdjsonWriter::flushLocked() {
+    m_last_flush = std::chrono::steady_clock::now();
+    if (!m_buffer.empty()) {
+        m_file.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+        m_buffer.clear();
+    }
+    m_file.flush();
+
+    if (!m_file) {
+        throw std::runtime_error("Writing scan results failed");
+    }
+}
+
+} // namespace netlens
@@ -0,0 +1,123 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "NetworkModel.h"
+#include "Permutation.h"
+#include <algorithm>
+#include <cmath>
+
+namespace netlens::internal {
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+} // namespace
+
+NetworkModel::NetworkModel(uint64_t seed)
+    : m_seed(seed) {}
+
+void NetworkModel::addHosts(const IpRange& range, SimulatedHost host) {
+    std::sort(host.open_ports.begin(), host.open_ports.end());
+    std::sort(host.filtered_ports.begin(), host.filtered_ports.end());
+    const size_t rule = m_rules.size();
+    m_rules.push_back({ std::move(host), rule });
+
+    const uint32_t first = range.first();
+    const uint32_t last = range.last();
+
+    // Cut back a segment reaching into the range from below
+    auto it = m_segments.upper_bound(first);
+    if (it != m_segments.begin()) {
+        auto previous = std::prev(it);
+        if (previous->second.last >= first) {
+            const Segment tail = previous->second;
+            if (previous->first == first) {
+                m_segments.erase(previous);
+            } else {
+                previous->second.last = first - 1;
+            }
+            if (tail.last > last) {
+                m_segments.emplace(last + 1, Segment{ tail.last, tail.rule });
+            }
+        }
+    }
+
+    // Drop the segments starting inside the range, keeping what sticks out
+    it = m_segments.lower_bound(first);
+    while (it != m_segments.end() && it->first <= last) {
+        const Segment covered = it->second;
+        it = m_segments.erase(it);
+        if (covered.last > last) {
+            m_segments.emplace(last + 1, covered);
+            break;
+        }
+    }
+
+    m_segments.emplace(first, Segment{ last, rule });
+}
+
+const NetworkModel::Rule* NetworkModel::find(uint32_t address) const {
+    auto it = m_segments.upper_bound(address);
+    if (it == m_segments.begin()) {
+        return nullptr;
+    }
+    --it;
+    return it->second.last >= address ? &m_rules[it->second.rule] : nullptr;
+}
+
+PortState NetworkModel::portState(const Rule& rule, uint16_t port) {
+    const SimulatedHost& host = rule.host;
+    if (std::binary_search(host.open_ports.begin(), host.open_ports.end(), port)) {
+        return PortState::Open;
+    }
+    if (std::binary_search(host.filtered_ports.begin(), host.filtered_ports.end(), port)) {
+        return PortState::Filtered;
+    }
+    return host.other_ports;
+}
+
+double NetworkModel::uniform(uint32_t address, uint16_t port, Draw draw) const {
+    const uint64_t key = (static_cast<uint64_t>(address) << 16 | port) * 8 + static_cast<uint64_t>(draw);
+    const uint64_t bits = Permutation::mix(m_seed ^ Permutation::mix(key));
+    return static_cast<double>((bits >> 11) + 1) * 0x1p-53;
+}
+
+std::chrono::nanoseconds NetworkModel::latency(const Rule& rule, uint32_t address, uint16_t port, Draw draw) const {
+    const LatencyModel& model = rule.host.latency;
+    double ms = model.rtt_ms;
+    if (model.distribution != LatencyDistribution::Constant && model.spread_ms > 0.0) {
+        const double u = uniform(address, port, draw);
+        if (model.distribution == LatencyDistribution::Uniform) {
+            ms += model.spread_ms * (2.0 * u - 1.0);
+        } else {
+            // Box-Muller, with the second uniform drawn one salt further
+            const double v = uniform(address, port, static_cast<Draw>(static_cast<uint64_t>(draw) + 1));
+            const double z = std::sqrt(-2.0 * std::log(u)) * std::cos(2.0 * PI * v);
+            if (model.distribution == LatencyDistribution::Normal) {
+                ms += model.spread_ms * z;
+            } else if (model.rtt_ms > 0.0) {
+                const double sigma = std::log1p(model.spread_ms / model.rtt_ms);
+                ms = model.rtt_ms * std::exp(sigma * z - sigma * sigma / 2.0);
+            }
+        }
+    }
+    return std::chrono::nanoseconds(static_cast<int64_t>(std::max(0.0, ms) * 1e6));
+}
+
+SimulationStats NetworkModel::stats() const {
+    SimulationStats result;
+    result.connects = connects.load(std::memory_order_relaxed);
+    result.accepted = accepted.load(std::memory_order_relaxed);
+    result.refused = refused.load(std::memory_order_relaxed);
+    result.dropped = dropped.load(std::memory_order_relaxed);
+    result.lost = lost.load(std::memory_order_relaxed);
+    result.rate_limited = rate_limited.load(std::memory_order_relaxed);
+    result.banners = banners.load(std::memory_order_relaxed);
+    result.virtual_time = std::chrono::nanoseconds(virtual_ns.load(std::memory_order_relaxed));
+    return result;
+}
+
+} // namespace netlens::internal
@@ -0,0 +1,92 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#pragma once
+
+#include <netlens/SimulatedNetwork.h>
+#include "IpRange.h"
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <map>
+
+namespace netlens::internal {
+
+/// <summary>
+/// The hosts of a SimulatedNetwork and its counters. Host lookups and
+/// draws are read-only and may run on any number of engine threads at
+/// once; the counters are atomic.
+/// </summary>
+class NetworkModel {
+public:
+    /// <summary>
+    /// A SimulatedHost with its port lists sorted for lookup. Its index
+    /// identifies the range's firewall.
+    /// </summary>
+    struct Rule {
+        SimulatedHost host;
+        size_t index;
+    };
+
+    /// <summary>
+    /// Independent draws of a probe, each seeded differently.
+    /// </summary>
+    enum class Draw : uint64_t {
+        Loss = 1,
+        ConnectLatency = 2,
+        ReceiveLatency = 4
+    };
+
+    explicit NetworkModel(uint64_t seed);
+
+    uint64_t seed() const { return m_seed; }
+
+    /// <summary>
+    /// Adds a rule for the range, overriding earlier rules where they overlap.
+    /// </summary>
+    void addHosts(const IpRange& range, SimulatedHost host);
+
+    /// <summary>
+    /// Rule of the host at address, or null if there is none.
+    /// </summary>
+    const Rule* find(uint32_t address) const;
+
+    static PortState portState(const Rule& rule, uint16_t port);
+
+    /// <summary>
+    /// Uniform draw in (0, 1] for a probe of (address, port). The same
+    /// arguments always draw the same value.
+    /// </summary>
+    double uniform(uint32_t address, uint16_t port, Draw draw) const;
+
+    /// <summary>
+    /// Round-trip time of a probe of (address, port) under the rule's latency model.
+    /// </summary>
+    std::chrono::nanoseconds latency(const Rule& rule, uint32_t address, uint16_t port, Draw draw) const;
+
+    SimulationStats stats() const;
+
+    // Updated by the transports
+    std::atomic<uint64_t> connects{0};
+    std::atomic<uint64_t> accepted{0};
+    std::atomic<uint64_t> refused{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> lost{0};
+    std::atomic<uint64_t> rate_limited{0};
+    std::atomic<uint64_t> banners{0};
+    std::atomic<int64_t> virtual_ns{0};
+
+private:
+    struct Segment {
+        uint32_t last;
+        size_t rule;
+    };
+
+    uint64_t m_seed;
+    std::deque<Rule> m_rules;
+    std::map<uint32_t, Segment> m_segments;     // Disjoint, keyed by first address
+};
+
+} // namespace netlens::internal
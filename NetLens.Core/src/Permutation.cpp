@@ -0,0 +1,68 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "Permutation.h"
+
+namespace netlens::internal {
+
+Permutation::Permutation()
+    : m_size(0)
+    , m_half_bits(1)
+    , m_half_mask(1)
+    , m_keys{} {}
+
+Permutation::Permutation(uint64_t size, uint64_t seed)
+    : m_size(size)
+    , m_half_bits(1)
+    , m_keys{} {
+    // Smallest balanced domain 2^(2 * half_bits) >= size, so cycle-walking
+    // takes fewer than four steps on average
+    while (m_half_bits < 32 && (uint64_t{1} << (2 * m_half_bits)) < size) {
+        ++m_half_bits;
+    }
+    m_half_mask = (uint64_t{1} << m_half_bits) - 1;
+
+    uint64_t key = seed;
+    for (auto& round_key : m_keys) {
+        key = mix(key + 0x9e3779b97f4a7c15ull);
+        round_key = key;
+    }
+}
+
+uint64_t Permutation::mix(uint64_t value) {
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ull;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebull;
+    value ^= value >> 31;
+    return value;
+}
+
+uint64_t Permutation::encrypt(uint64_t value) const {
+    uint64_t left = value >> m_half_bits;
+    uint64_t right = value & m_half_mask;
+    for (uint64_t round_key : m_keys) {
+        const uint64_t next = left ^ (mix(right ^ round_key) & m_half_mask);
+        left = right;
+        right = next;
+    }
+    return (left << m_half_bits) | right;
+}
+
+uint64_t Permutation::operator()(uint64_t index) const {
+    if (m_size <= 1) {
+        return index;
+    }
+
+    // The domain is a bijection onto itself, so walking the cycle from an
+    // in-range value always comes back into range
+    uint64_t value = encrypt(index);
+    while (value >= m_size) {
+        value = encrypt(value);
+    }
+    return value;
+}
+
+} // namespace netlens::internal
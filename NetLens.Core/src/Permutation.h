@@ -0,0 +1,53 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace netlens::internal {
+
+/// <summary>
+/// Keyed pseudo-random bijection on [0, size). A balanced Feistel network
+/// runs over the smallest even number of bits covering size, and
+/// cycle-walking maps values outside the range back into it. Indexing is
+/// O(1) in time and memory whatever the size; the same seed always yields
+/// the same order.
+/// </summary>
+class Permutation {
+public:
+    /// <summary>
+    /// Identity permutation of an empty range.
+    /// </summary>
+    Permutation();
+
+    Permutation(uint64_t size, uint64_t seed);
+
+    uint64_t size() const { return m_size; }
+
+    /// <summary>
+    /// Returns the element at position index. index must be below size().
+    /// </summary>
+    uint64_t operator()(uint64_t index) const;
+
+    /// <summary>
+    /// Scrambles a 64-bit value (SplitMix64 finalizer). Also used to derive
+    /// sub-keys, e.g. one port order per host.
+    /// </summary>
+    static uint64_t mix(uint64_t value);
+
+private:
+    static constexpr int ROUNDS = 4;
+
+    uint64_t encrypt(uint64_t value) const;
+
+    uint64_t m_size;
+    unsigned m_half_bits;
+    uint64_t m_half_mask;
+    std::array<uint64_t, ROUNDS> m_keys;
+};
+
+} // namespace netlens::internal
@@ -0,0 +1,121 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "ProgressReporter.h"
+#include <algorithm>
+
+namespace netlens::internal {
+
+ProgressCounters::ProgressCounters(size_t stripes)
+    : m_stripes(std::make_unique<Stripe[]>(std::max<size_t>(stripes, 1)))
+    , m_count(std::max<size_t>(stripes, 1)) {}
+
+uint64_t ProgressCounters::hosts() const {
+    uint64_t total = 0;
+    for (size_t i = 0; i < m_count; ++i) {
+        total += m_stripes[i].hosts.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t ProgressCounters::ports() const {
+    uint64_t total = 0;
+    for (size_t i = 0; i < m_count; ++i) {
+        total += m_stripes[i].ports.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+ProgressReporter::ProgressReporter(ProgressCallback callback, std::chrono::milliseconds interval,
+                                   const ProgressCounters& counters, size_t total_hosts, size_t total_ports,
+                                   Sampler sampler)
+    : m_callback(std::move(callback))
+    , m_interval(interval.count() > 0 ? interval : std::chrono::milliseconds(DEFAULT_INTERVAL_MS))
+    , m_counters(counters)
+    , m_sampler(std::move(sampler))
+    , m_started(Clock::now()) {
+    m_progress.total_hosts = total_hosts;
+    m_progress.total_ports = total_ports;
+    if (m_callback) {
+        m_thread = std::thread([this]() { run(); });
+    }
+}
+
+ProgressReporter::~ProgressReporter() {
+    if (m_thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wake.notify_one();
+        m_thread.join();
+    }
+}
+
+void ProgressReporter::stop() {
+    if (!m_thread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+
+    // Whatever the last tick saw, the caller gets the final counts
+    report(Clock::now(), true);
+}
+
+void ProgressReporter::run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto next = Clock::now() + m_interval;
+    while (!m_wake.wait_until(lock, next, [this]() { return m_stopping; })) {
+        lock.unlock();
+        report(Clock::now(), false);
+        lock.lock();
+        next += m_interval;
+        next = std::max(next, Clock::now());
+    }
+}
+
+void ProgressReporter::report(Clock::time_point now, bool final) {
+    // Each stripe only grows, so successive sums never go back
+    const uint64_t hosts = m_counters.hosts();
+    const uint64_t ports = m_counters.ports();
+    if (!final && hosts == m_last_hosts && ports == m_last_ports) {
+        return;     // Nothing completed since the last snapshot
+    }
+    m_host_rate.add(now, hosts - m_last_hosts);
+    m_port_rate.add(now, ports - m_last_ports);
+    m_last_hosts = hosts;
+    m_last_ports = ports;
+
+    m_progress.completed_hosts = static_cast<size_t>(hosts);
+    m_progress.completed_ports = static_cast<size_t>(ports);
+    m_progress.elapsed_seconds = std::chrono::duration<double>(now - m_started).count();
+    m_progress.host_rate = m_host_rate.rate(now);
+    m_progress.port_rate = m_port_rate.rate(now);
+
+    // The smoothed rate lags for its first second; until then use the mean
+    const double mean_port_rate = m_progress.elapsed_seconds > 0.0
+        ? static_cast<double>(ports) / m_progress.elapsed_seconds : 0.0;
+    const double eta_rate = m_progress.elapsed_seconds < 1.0 ? mean_port_rate : m_progress.port_rate;
+    const size_t remaining = m_progress.total_ports - std::min(m_progress.total_ports, m_progress.completed_ports);
+    m_progress.eta_seconds = remaining == 0 ? 0.0
+        : eta_rate > 0.0 ? static_cast<double>(remaining) / eta_rate : -1.0;
+
+    if (m_sampler) {
+        m_sampler(m_progress);
+    }
+
+    try {
+        m_callback(m_progress);
+    } catch (...) {
+        // A failing progress callback must not stop the scan
+    }
+}
+
+} // namespace netlens::internal
@@ -0,0 +1,133 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#pragma once
+
+#include <netlens/Scanner.h>
+#include "RateLimiter.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace netlens::internal {
+
+/// <summary>
+/// Completed host and port counters, striped so that each io thread bumps
+/// its own cache line. Increments are relaxed; a read sums the stripes and
+/// may trail the increments in flight by a few counts.
+/// </summary>
+class ProgressCounters {
+public:
+    /// <summary>
+    /// Size of the cache line a stripe is padded to.
+    /// </summary>
+    static constexpr size_t CACHE_LINE = 64;
+
+    explicit ProgressCounters(size_t stripes = 1);
+
+    ProgressCounters(const ProgressCounters&) = delete;
+    ProgressCounters& operator=(const ProgressCounters&) = delete;
+
+    size_t stripes() const { return m_count; }
+
+    void addHosts(size_t stripe, uint64_t count) {
+        m_stripes[stripe % m_count].hosts.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    void addPorts(size_t stripe, uint64_t count) {
+        m_stripes[stripe % m_count].ports.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    uint64_t hosts() const;
+    uint64_t ports() const;
+
+private:
+    struct alignas(CACHE_LINE) Stripe {
+        std::atomic<uint64_t> hosts{0};
+        std::atomic<uint64_t> ports{0};
+    };
+
+    std::unique_ptr<Stripe[]> m_stripes;
+    size_t m_count;
+};
+
+/// <summary>
+/// Delivers coalesced progress snapshots from a thread of its own, so the
+/// threads doing the scan never run the user's callback. Every interval,
+/// if anything completed since the last snapshot, the counters are summed,
+/// the sampler fills in the engine's own fields (window, current address,
+/// ...) and the callback gets the snapshot with host and port rates and an
+/// estimate of the time left. A last snapshot is always sent on stop.
+/// Exceptions from the callback are swallowed.
+/// </summary>
+class ProgressReporter {
+public:
+    /// <summary>
+    /// Fills the engine-specific fields of a snapshot.
+    /// </summary>
+    using Sampler = std::function<void(ScanProgress& progress)>;
+
+    /// <summary>
+    /// Starts reporting; does nothing without a callback.
+    /// </summary>
+    /// <param name="callback">User progress callback</param>
+    /// <param name="interval">Time between snapshots</param>
+    /// <param name="counters">Counters bumped by the scan</param>
+    /// <param name="total_hosts">Hosts in the scan</param>
+    /// <param name="total_ports">Probed ports over all hosts</param>
+    /// <param name="sampler">Optional sampler of engine fields</param>
+    ProgressReporter(ProgressCallback callback, std::chrono::milliseconds interval,
+                     const ProgressCounters& counters, size_t total_hosts, size_t total_ports,
+                     Sampler sampler = nullptr);
+
+    /// <summary>
+    /// Stops the thread without a final snapshot if stop was not called.
+    /// </summary>
+    ~ProgressReporter();
+
+    ProgressReporter(const ProgressReporter&) = delete;
+    ProgressReporter& operator=(const ProgressReporter&) = delete;
+
+    /// <summary>
+    /// Sends the final snapshot and joins the thread. Once this returns the
+    /// callback and sampler are not called again.
+    /// </summary>
+    void stop();
+
+    /// <summary>
+    /// Interval used when the settings leave it at 0.
+    /// </summary>
+    static constexpr uint32_t DEFAULT_INTERVAL_MS = 250;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void run();
+    void report(Clock::time_point now, bool final);
+
+    ProgressCallback m_callback;
+    std::chrono::milliseconds m_interval;
+    const ProgressCounters& m_counters;
+    Sampler m_sampler;
+
+    ScanProgress m_progress;
+    Clock::time_point m_started;
+    RateMeter m_host_rate;
+    RateMeter m_port_rate;
+    uint64_t m_last_hosts = 0;
+    uint64_t m_last_ports = 0;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_stopping = false;
+    std::thread m_thread;
+};
+
+} // namespace netlens::internal
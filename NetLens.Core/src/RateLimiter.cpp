@@ -0,0 +1,110 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "RateLimiter.h"
+#include <algorithm>
+#include <cmath>
+
+namespace netlens::internal {
+
+TokenBucket::TokenBucket(double rate_per_second, Clock::time_point now)
+    : m_rate_per_ns(rate_per_second / 1e9)
+    , m_capacity(std::max(1.0, rate_per_second / 1000.0))
+    , m_tokens(1.0)
+    , m_last(now) {}
+
+void TokenBucket::refill(Clock::time_point now) {
+    if (now <= m_last) {
+        return;
+    }
+    const double elapsed_ns = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_last).count());
+    m_tokens = std::min(m_capacity, m_tokens + elapsed_ns * m_rate_per_ns);
+    m_last = now;
+}
+
+TokenBucket::Clock::duration TokenBucket::waitTime(Clock::time_point now) {
+    refill(now);
+    if (m_tokens >= 1.0) {
+        return Clock::duration::zero();
+    }
+    const double wait_ns = std::ceil((1.0 - m_tokens) / m_rate_per_ns);
+    return std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(static_cast<int64_t>(wait_ns)));
+}
+
+bool TokenBucket::full(Clock::time_point now) {
+    refill(now);
+    return m_tokens >= m_capacity;
+}
+
+RateLimiter::RateLimiter(double global_rate, double subnet_rate, unsigned subnet_prefix)
+    : m_global_rate(global_rate)
+    , m_subnet_rate(subnet_rate)
+    , m_subnet_shift(32 - std::min(subnet_prefix, 32u)) {}
+
+RateLimiter::Clock::duration RateLimiter::acquire(uint32_t address, Clock::time_point now) {
+    Clock::duration wait = Clock::duration::zero();
+    if (m_global_rate > 0.0) {
+        // Started on the caller's clock, which may be a virtual one
+        if (!m_global_started) {
+            m_global = TokenBucket(m_global_rate, now);
+            m_global_started = true;
+        }
+        wait = m_global.waitTime(now);
+    }
+
+    TokenBucket* subnet = nullptr;
+    if (m_subnet_rate > 0.0) {
+        const uint32_t key = m_subnet_shift >= 32 ? 0 : address >> m_subnet_shift;
+        auto it = m_subnets.find(key);
+        if (it == m_subnets.end()) {
+            if (m_subnets.size() >= m_sweep_at) {
+                sweep(now);
+            }
+            it = m_subnets.emplace(key, TokenBucket(m_subnet_rate, now)).first;
+        }
+        subnet = &it->second;
+        wait = std::max(wait, subnet->waitTime(now));
+    }
+
+    if (wait > Clock::duration::zero()) {
+        return wait;
+    }
+    if (m_global_rate > 0.0) {
+        m_global.take();
+    }
+    if (subnet) {
+        subnet->take();
+    }
+    return wait;
+}
+
+void RateLimiter::sweep(Clock::time_point now) {
+    for (auto it = m_subnets.begin(); it != m_subnets.end();) {
+        it = it->second.full(now) ? m_subnets.erase(it) : std::next(it);
+    }
+    // Subnets still pacing stay; only sweep again once the map has doubled
+    m_sweep_at = std::max(SWEEP_THRESHOLD, m_subnets.size() * 2);
+}
+
+void RateMeter::add(Clock::time_point now, uint64_t events) {
+    if (m_started) {
+        const double dt = std::chrono::duration<double>(now - m_last).count();
+        m_rate *= std::exp(-std::max(0.0, dt) / TIME_CONSTANT_S);
+    }
+    m_rate += static_cast<double>(events) / TIME_CONSTANT_S;
+    m_last = now;
+    m_started = true;
+}
+
+double RateMeter::rate(Clock::time_point now) const {
+    if (!m_started) {
+        return 0.0;
+    }
+    const double dt = std::chrono::duration<double>(now - m_last).count();
+    return m_rate * std::exp(-std::max(0.0, dt) / TIME_CONSTANT_S);
+}
+
+} // namespace netlens::internal
@@ -0,0 +1,116 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+
+namespace netlens::internal {
+
+/// <summary>
+/// Token bucket refilled continuously at a fixed rate, with nanosecond
+/// accounting so rates well above 1000/s are paced evenly. The bucket holds
+/// at most one millisecond of tokens (and at least one), so the ceiling
+/// holds over any interval longer than that.
+/// </summary>
+class TokenBucket {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    TokenBucket() = default;
+    TokenBucket(double rate_per_second, Clock::time_point now);
+
+    /// <summary>
+    /// Time until a token is available; zero if one is available now.
+    /// </summary>
+    Clock::duration waitTime(Clock::time_point now);
+
+    /// <summary>
+    /// Takes a token. Call only after waitTime returned zero.
+    /// </summary>
+    void take() { m_tokens -= 1.0; }
+
+    /// <summary>
+    /// True if the bucket has refilled completely, i.e. is indistinguishable
+    /// from a new one.
+    /// </summary>
+    bool full(Clock::time_point now);
+
+private:
+    void refill(Clock::time_point now);
+
+    double m_rate_per_ns = 0.0;
+    double m_capacity = 1.0;
+    double m_tokens = 1.0;
+    Clock::time_point m_last;
+};
+
+/// <summary>
+/// Probes-per-second ceiling for a scan: an optional global bucket plus one
+/// bucket per target subnet. Subnet buckets that have refilled are dropped
+/// now and then, so memory follows the subnets probed recently. Buckets
+/// start on the clock of the first acquire that needs them. Not
+/// thread-safe; callers serialize access.
+/// </summary>
+class RateLimiter {
+public:
+    using Clock = TokenBucket::Clock;
+
+    /// <summary>
+    /// Constructs a limiter. A rate of 0 disables that limit.
+    /// </summary>
+    /// <param name="global_rate">Probes per second over the whole scan</param>
+    /// <param name="subnet_rate">Probes per second into any one subnet</param>
+    /// <param name="subnet_prefix">Prefix length of the rate-limited subnets (0 to 32)</param>
+    RateLimiter(double global_rate = 0.0, double subnet_rate = 0.0, unsigned subnet_prefix = 24);
+
+    bool enabled() const { return m_global_rate > 0.0 || m_subnet_rate > 0.0; }
+
+    /// <summary>
+    /// Takes a token for a probe to address and returns zero, or returns how
+    /// long to wait before trying again without taking anything.
+    /// </summary>
+    Clock::duration acquire(uint32_t address, Clock::time_point now);
+
+private:
+    static constexpr size_t SWEEP_THRESHOLD = 4096;
+
+    void sweep(Clock::time_point now);
+
+    double m_global_rate;
+    double m_subnet_rate;
+    unsigned m_subnet_shift;
+    TokenBucket m_global;
+    bool m_global_started = false;
+    std::unordered_map<uint32_t, TokenBucket> m_subnets;
+    size_t m_sweep_at = SWEEP_THRESHOLD;
+};
+
+/// <summary>
+/// Exponentially decaying event rate, in events per second over roughly
+/// the last second. Not thread-safe; callers serialize access.
+/// </summary>
+class RateMeter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    void add(Clock::time_point now, uint64_t events = 1);
+
+    /// <summary>
+    /// Current rate in events per second.
+    /// </summary>
+    double rate(Clock::time_point now) const;
+
+private:
+    static constexpr double TIME_CONSTANT_S = 1.0;
+
+    double m_rate = 0.0;
+    Clock::time_point m_last{};
+    bool m_started = false;
+};
+
+} // namespace netlens::internal
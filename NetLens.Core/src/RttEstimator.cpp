@@ -0,0 +1,74 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "RttEstimator.h"
+#include <algorithm>
+#include <cmath>
+
+namespace netlens::internal {
+
+void RttEstimator::addSample(double rtt_ms) {
+    if (m_samples == 0) {
+        m_srtt = rtt_ms;
+        m_rttvar = rtt_ms / 2.0;
+    } else {
+        m_rttvar = (1.0 - BETA) * m_rttvar + BETA * std::abs(m_srtt - rtt_ms);
+        m_srtt = (1.0 - ALPHA) * m_srtt + ALPHA * rtt_ms;
+    }
+    ++m_samples;
+}
+
+double RttEstimator::timeout() const {
+    return m_srtt + std::max(CLOCK_GRANULARITY_MS, 4.0 * m_rttvar);
+}
+
+AdaptiveTimeout::AdaptiveTimeout(uint32_t min_timeout_ms, uint32_t max_timeout_ms)
+    : m_min_timeout_ms(std::min(min_timeout_ms, max_timeout_ms))
+    , m_max_timeout_ms(max_timeout_ms) {}
+
+uint32_t AdaptiveTimeout::clamp(double timeout_ms) const {
+    return static_cast<uint32_t>(std::clamp(std::ceil(timeout_ms),
+                                            static_cast<double>(m_min_timeout_ms),
+                                            static_cast<double>(m_max_timeout_ms)));
+}
+
+uint32_t AdaptiveTimeout::timeoutFor(uint32_t address, const RttEstimator& host) const {
+    if (host.samples() > 0) {
+        return clamp(host.timeout());
+    }
+
+    auto it = m_subnets.find(address >> 8);
+    if (it != m_subnets.end() && it->second.rtt.samples() >= MIN_FALLBACK_SAMPLES) {
+        return clamp(it->second.rtt.timeout() * SUBNET_MARGIN);
+    }
+
+    if (m_global.samples() >= MIN_FALLBACK_SAMPLES) {
+        return clamp(m_global.timeout() * GLOBAL_MARGIN);
+    }
+
+    return m_max_timeout_ms;
+}
+
+void AdaptiveTimeout::addHost(uint32_t address) {
+    ++m_subnets[address >> 8].active_hosts;
+}
+
+void AdaptiveTimeout::removeHost(uint32_t address) {
+    auto it = m_subnets.find(address >> 8);
+    if (it != m_subnets.end() && --it->second.active_hosts == 0) {
+        m_subnets.erase(it);
+    }
+}
+
+void AdaptiveTimeout::addSample(uint32_t address, RttEstimator& host, double rtt_ms) {
+    host.addSample(rtt_ms);
+    auto it = m_subnets.find(address >> 8);
+    if (it != m_subnets.end()) {
+        it->second.rtt.addSample(rtt_ms);
+    }
+    m_global.addSample(rtt_ms);
+}
+
+} // namespace netlens::internal
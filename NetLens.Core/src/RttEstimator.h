@@ -0,0 +1,102 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+
+namespace netlens::internal {
+
+/// <summary>
+/// Smoothed round-trip time estimator following TCP's retransmission timer
+/// (RFC 6298): SRTT and RTTVAR are exponentially weighted averages and the
+/// timeout is SRTT + max(G, 4 * RTTVAR).
+/// </summary>
+class RttEstimator {
+public:
+    /// <summary>
+    /// Adds a measured round-trip time in milliseconds.
+    /// </summary>
+    void addSample(double rtt_ms);
+
+    uint32_t samples() const { return m_samples; }
+    double srtt() const { return m_srtt; }
+    double rttvar() const { return m_rttvar; }
+
+    /// <summary>
+    /// Retransmission-style timeout in milliseconds. Only meaningful once
+    /// at least one sample has been added.
+    /// </summary>
+    double timeout() const;
+
+private:
+    static constexpr double ALPHA = 1.0 / 8.0;
+    static constexpr double BETA = 1.0 / 4.0;
+    static constexpr double CLOCK_GRANULARITY_MS = 10.0;
+
+    double m_srtt = 0.0;
+    double m_rttvar = 0.0;
+    uint32_t m_samples = 0;
+};
+
+/// <summary>
+/// Chooses per-probe connect timeouts from measured RTTs. The host's own
+/// estimate is preferred, then its /24's, then the scan-wide one; the
+/// broader fallbacks need more samples and get a safety margin because they
+/// mix hosts. The configured timeout is the upper bound and is used until
+/// any estimate exists. A /24's estimate only lives while some of its hosts
+/// are being probed, so memory follows the hosts in flight, not the target
+/// range. Not thread-safe; callers serialize access.
+/// </summary>
+class AdaptiveTimeout {
+public:
+    AdaptiveTimeout(uint32_t min_timeout_ms, uint32_t max_timeout_ms);
+
+    /// <summary>
+    /// Timeout for the next probe to address, given the host's estimator.
+    /// </summary>
+    uint32_t timeoutFor(uint32_t address, const RttEstimator& host) const;
+
+    /// <summary>
+    /// Registers a host about to be probed, creating its /24's estimator.
+    /// </summary>
+    void addHost(uint32_t address);
+
+    /// <summary>
+    /// Unregisters a host whose probes are done; the /24's estimator is
+    /// dropped with its last active host.
+    /// </summary>
+    void removeHost(uint32_t address);
+
+    /// <summary>
+    /// Records an RTT measured from a completed (accepted or refused) connect.
+    /// </summary>
+    void addSample(uint32_t address, RttEstimator& host, double rtt_ms);
+
+    /// <summary>
+    /// Scan-wide estimator.
+    /// </summary>
+    const RttEstimator& global() const { return m_global; }
+
+private:
+    static constexpr uint32_t MIN_FALLBACK_SAMPLES = 3;
+    static constexpr double SUBNET_MARGIN = 2.0;
+    static constexpr double GLOBAL_MARGIN = 4.0;
+
+    uint32_t clamp(double timeout_ms) const;
+
+    uint32_t m_min_timeout_ms;
+    uint32_t m_max_timeout_ms;
+    RttEstimator m_global;
+    struct SubnetEstimate {
+        RttEstimator rtt;
+        uint32_t active_hosts = 0;
+    };
+
+    std::unordered_map<uint32_t, SubnetEstimate> m_subnets;
+};
+
+} // namespace netlens::internal
@@ -0,0 +1,616 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "netlens/ScanArchive.h"
+#include "netlens/JsonExporter.h"
+#include "IpRange.h"
+#include <json.hpp>
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using json = nlohmann::json;
+
+namespace netlens {
+
+namespace {
+
+static_assert(std::endian::native == std::endian::little,
+              "Archive columns are little-endian and mapped in place");
+
+constexpr char MAGIC[8] = { 'N', 'L', 'S', 'C', 'A', 'N', 0x1A, '\n' };
+constexpr uint32_t FORMAT_VERSION = 1;
+constexpr uint64_t SECTION_ALIGNMENT = 8;
+
+/// <summary>
+/// Section kinds. Each host column holds host_count entries and each port
+/// column port_count entries; BannerOffsets holds banner_count + 1 offsets
+/// into BannerData.
+/// </summary>
+enum class Section : uint32_t {
+    Settings = 1,           // JSON object, UTF-8
+    HostAddress,            // uint32_t, ascending
+    HostFirstPort,          // uint32_t, index into the port columns
+    HostOpenCount,          // uint32_t
+    HostClosedCount,        // uint32_t
+    HostFilteredCount,      // uint32_t
+    HostFlags,              // uint8_t: bit 0 alive, bits 1-7 Liveness
+    PortNumber,             // uint16_t, ascending within a host
+    PortBanner,             // uint32_t BannerId
+    BannerOffsets,          // uint64_t
+    BannerData,             // bytes
+    Count_
+};
+
+constexpr size_t SECTION_COUNT = static_cast<size_t>(Section::Count_) - 1;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t section_count;
+    uint64_t host_count;
+    uint64_t port_count;
+    uint64_t banner_count;
+    uint64_t file_size;
+};
+
+struct SectionEntry {
+    uint32_t kind;
+    uint32_t reserved;
+    uint64_t offset;
+    uint64_t size;
+};
+
+static_assert(sizeof(FileHeader) == 48 && sizeof(SectionEntry) == 24);
+
+uint64_t alignUp(uint64_t value) {
+    return (value + SECTION_ALIGNMENT - 1) & ~(SECTION_ALIGNMENT - 1);
+}
+
+json settingsToJson(const ScanSettings& settings) {
+    return {
+        {"startIp", settings.start_ip},
+        {"endIp", settings.end_ip},
+        {"targets", settings.targets},
+        {"excludes", settings.excludes},
+        {"ports", settings.ports},
+        {"timeoutMs", settings.timeout_ms},
+        {"maxConcurrency", settings.max_concurrency}
+    };
+}
+
+ScanSettings settingsFromJson(const json& j) {
+    ScanSettings settings;
+    settings.start_ip = j.value("startIp", std::string());
+    settings.end_ip = j.value("endIp", std::string());
+    settings.targets = j.value("targets", std::vector<std::string>());
+    settings.excludes = j.value("excludes", std::vector<std::string>());
+    settings.ports = j.value("ports", std::vector<uint16_t>());
+    settings.timeout_ms = j.value("timeoutMs", settings.timeout_ms);
+    settings.max_concurrency = j.value("maxConcurrency", settings.max_concurrency);
+    return settings;
+}
+
+/// <summary>
+/// Lays sections out back to back and streams them to the file.
+/// </summary>
+class ArchiveWriter {
+public:
+    explicit ArchiveWriter(const std::string& filepath)
+        : m_file(filepath, std::ios::binary | std::ios::trunc) {
+        if (!m_file.is_open()) {
+            throw std::runtime_error("Cannot open " + filepath + " for writing");
+        }
+    }
+
+    void reserve(Section kind, uint64_t size) {
+        m_entries.push_back(SectionEntry{ static_cast<uint32_t>(kind), 0, 0, size });
+    }
+
+    void writeHeader(uint64_t host_count, uint64_t port_count, uint64_t banner_count) {
+        uint64_t offset = alignUp(sizeof(FileHeader) + m_entries.size() * sizeof(SectionEntry));
+        for (auto& entry : m_entries) {
+            entry.offset = offset;
+            offset = alignUp(offset + entry.size);
+        }
+
+        FileHeader header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = FORMAT_VERSION;
+        header.section_count = static_cast<uint32_t>(m_entries.size());
+        header.host_count = host_count;
+        header.port_count = port_count;
+        header.banner_count = banner_count;
+        header.file_size = offset;
+
+        put(&header, sizeof(header));
+        put(m_entries.data(), m_entries.size() * sizeof(SectionEntry));
+        pad();
+    }
+
+    // Sections are written in reservation order
+    void put(const void* data, size_t size) {
+        m_file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        m_written += size;
+    }
+
+    void pad() {
+        static constexpr char ZEROS[SECTION_ALIGNMENT] = {};
+        put(ZEROS, alignUp(m_written) - m_written);
+    }
+
+    template<typename T>
+    void column(const std::vector<T>& values) {
+        put(values.data(), values.size() * sizeof(T));
+        pad();
+    }
+
+    void close() {
+        m_file.close();
+        if (!m_file) {
+            throw std::runtime_error("Writing scan archive failed");
+        }
+    }
+
+private:
+    std::ofstream m_file;
+    std::vector<SectionEntry> m_entries;
+    uint64_t m_written = 0;
+};
+
+/// <summary>
+/// Read-only mapping of a whole file.
+/// </summary>
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& filepath) {
+#ifdef _WIN32
+        m_file = ::CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                               OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (m_file == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("Cannot open " + filepath);
+        }
+        LARGE_INTEGER size;
+        if (!::GetFileSizeEx(m_file, &size) || size.QuadPart == 0) {
+            release();
+            throw std::runtime_error("Not a scan archive: " + filepath);
+        }
+        m_size = static_cast<size_t>(size.QuadPart);
+        m_mapping = ::CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        m_data = m_mapping ? ::MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (m_data == nullptr) {
+            release();
+            throw std::runtime_error("Cannot map " + filepath);
+        }
+#else
+        const int fd = ::open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open " + filepath);
+        }
+        struct stat st {};
+        if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+            ::close(fd);
+            throw std::runtime_error("Not a scan archive: " + filepath);
+        }
+        m_size = static_cast<size_t>(st.st_size);
+        void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);    // The mapping keeps the file open
+        if (data == MAP_FAILED) {
+            throw std::runtime_error("Cannot map " + filepath);
+        }
+        m_data = data;
+#endif
+    }
+
+    ~MappedFile() { release(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const uint8_t* data() const { return static_cast<const uint8_t*>(m_data); }
+    size_t size() const { return m_size; }
+
+private:
+    void release() {
+#ifdef _WIN32
+        if (m_data) ::UnmapViewOfFile(m_data);
+        if (m_mapping) ::CloseHandle(m_mapping);
+        if (m_file != INVALID_HANDLE_VALUE) ::CloseHandle(m_file);
+        m_data = nullptr;
+        m_mapping = nullptr;
+        m_file = INVALID_HANDLE_VALUE;
+#else
+        if (m_data) ::munmap(m_data, m_size);
+        m_data = nullptr;
+#endif
+    }
+
+#ifdef _WIN32
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#endif
+    void* m_data = nullptr;
+    size_t m_size = 0;
+};
+
+} // namespace
+
+void ScanArchive::save(const ScanResultStore& store, const std::string& filepath) {
+    const size_t host_count = store.hostCount();
+    const BannerTable& banners = store.banners();
+
+    // Hosts are written in address order with their ports regrouped to match
+    std::vector<uint32_t> order(host_count);
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&store](uint32_t a, uint32_t b) {
+        return store.hostAt(a).address < store.hostAt(b).address;
+    });
+
+    std::vector<uint32_t> address(host_count), first_port(host_count), open_count(host_count),
+                          closed_count(host_count), filtered_count(host_count);
+    std::vector<uint8_t> flags(host_count);
+    std::vector<uint16_t> port_number;
+    std::vector<BannerId> port_banner;
+    port_number.reserve(store.openPortCount());
+    port_banner.reserve(store.openPortCount());
+
+    for (size_t i = 0; i < host_count; ++i) {
+        const CompactHost& host = store.hostAt(order[i]);
+        address[i] = host.address;
+        first_port[i] = static_cast<uint32_t>(port_number.size());
+        open_count[i] = host.open_count;
+        closed_count[i] = host.closed_count;
+        filtered_count[i] = host.filtered_count;
+        flags[i] = static_cast<uint8_t>((host.is_alive ? 1 : 0) | (static_cast<uint8_t>(host.liveness) << 1));
+        std::vector<CompactPort> ports(store.openPorts(order[i]).begin(), store.openPorts(order[i]).end());
+        std::sort(ports.begin(), ports.end(),
+                  [](const CompactPort& a, const CompactPort& b) { return a.port < b.port; });
+        for (const CompactPort& port : ports) {
+            port_number.push_back(port.port);
+            port_banner.push_back(port.banner);
+        }
+    }
+
+    std::vector<uint64_t> banner_offsets;
+    banner_offsets.reserve(banners.size() + 1);
+    uint64_t banner_bytes = 0;
+    for (size_t id = 0; id < banners.size(); ++id) {
+        banner_offsets.push_back(banner_bytes);
+        banner_bytes += banners.get(static_cast<BannerId>(id)).size();
+    }
+    banner_offsets.push_back(banner_bytes);
+
+    const std::string settings = settingsToJson(store.settings()).dump();
+
+    ArchiveWriter writer(filepath);
+    writer.reserve(Section::Settings, settings.size());
+    writer.reserve(Section::HostAddress, host_count * sizeof(uint32_t));
+    writer.reserve(Section::HostFirstPort, host_count * sizeof(uint32_t));
+    writer.reserve(Section::HostOpenCount, host_count * sizeof(uint32_t));
+    writer.reserve(Section::HostClosedCount, host_count * sizeof(uint32_t));
+    writer.reserve(Section::HostFilteredCount, host_count * sizeof(uint32_t));
+    writer.reserve(Section::HostFlags, host_count * sizeof(uint8_t));
+    writer.reserve(Section::PortNumber, port_number.size() * sizeof(uint16_t));
+    writer.reserve(Section::PortBanner, port_banner.size() * sizeof(BannerId));
+    writer.reserve(Section::BannerOffsets, banner_offsets.size() * sizeof(uint64_t));
+    writer.reserve(Section::BannerData, banner_bytes);
+    writer.writeHeader(host_count, port_number.size(), banners.size());
+
+    writer.put(settings.data(), settings.size());
+    writer.pad();
+    writer.column(address);
+    writer.column(first_port);
+    writer.column(open_count);
+    writer.column(closed_count);
+    writer.column(filtered_count);
+    writer.column(flags);
+    writer.column(port_number);
+    writer.column(port_banner);
+    writer.column(banner_offsets);
+    for (size_t id = 0; id < banners.size(); ++id) {
+        const std::string_view banner = banners.get(static_cast<BannerId>(id));
+        writer.put(banner.data(), banner.size());
+    }
+    writer.pad();
+    writer.close();
+}
+
+void ScanArchive::save(const ScanResult& result, const std::string& filepath) {
+    ScanResultStore store(result.settings);
+    for (const auto& host : result.hosts) {
+        uint32_t address;
+        try {
+            address = internal::IpRange::parse(host.address);
+        } catch (const internal::IpRangeException& e) {
+            throw std::runtime_error(std::string("Invalid host address: ") + e.what());
+        }
+        store.addHost(address, host);
+    }
+    save(store, filepath);
+}
+
+bool ScanArchive::isArchive(const std::string& filepath) {
+    std::ifstream file(filepath, std::ios::binary);
+    char magic[sizeof(MAGIC)] = {};
+    file.read(magic, sizeof(magic));
+    return file && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+bool ScanArchive::fromJsonFile(const std::string& json_path, const std::string& archive_path) {
+    try {
+        save(JsonExporter::loadFromFile(json_path), archive_path);
+        return true;
+    }
+    catch (...) {
+        return false;
+    }
+}
+
+bool ScanArchive::toJsonFile(const std::string& archive_path, const std::string& json_path, bool pretty) {
+    try {
+        const ScanArchiveReader reader(archive_path);
+        return JsonExporter::saveToFile(reader.toScanResult(), json_path, pretty);
+    }
+    catch (...) {
+        return false;
+    }
+}
+
+struct ScanArchiveReader::Impl {
+    MappedFile file;
+    ScanSettings settings;
+    size_t host_count = 0;
+    size_t port_count = 0;
+    size_t banner_count = 0;
+
+    const uint32_t* address = nullptr;
+    const uint32_t* first_port = nullptr;
+    const uint32_t* open_count = nullptr;
+    const uint32_t* closed_count = nullptr;
+    const uint32_t* filtered_count = nullptr;
+    const uint8_t* flags = nullptr;
+    const uint16_t* port_number = nullptr;
+    const BannerId* port_banner = nullptr;
+    const uint64_t* banner_offsets = nullptr;
+    const char* banner_data = nullptr;
+    uint64_t banner_bytes = 0;
+
+    explicit Impl(const std::string& filepath) : file(filepath) {
+        const auto invalid = [&filepath](const char* reason) {
+            return std::runtime_error("Not a valid scan archive (" + std::string(reason) + "): " + filepath);
+        };
+
+        FileHeader header;
+        if (file.size() < sizeof(header)) {
+            throw invalid("truncated header");
+        }
+        std::memcpy(&header, file.data(), sizeof(header));
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+            throw invalid("bad magic");
+        }
+        if (header.version != FORMAT_VERSION) {
+            throw invalid("unsupported version");
+        }
+        if (header.file_size != file.size() ||
+            header.section_count > (file.size() - sizeof(header)) / sizeof(SectionEntry)) {
+            throw invalid("truncated file");
+        }
+
+        // Locate each section, checking bounds, alignment and column length;
+        // unknown kinds are skipped so later versions can add sections
+        const uint8_t* sections[SECTION_COUNT + 1] = {};
+        uint64_t sizes[SECTION_COUNT + 1] = {};
+        for (uint32_t i = 0; i < header.section_count; ++i) {
+            SectionEntry entry;
+            std::memcpy(&entry, file.data() + sizeof(header) + i * sizeof(SectionEntry), sizeof(entry));
+            if (entry.offset % SECTION_ALIGNMENT != 0 || entry.offset > file.size() ||
+                entry.size > file.size() - entry.offset) {
+                throw invalid("section out of bounds");
+            }
+            if (entry.kind >= 1 && entry.kind <= SECTION_COUNT) {
+                sections[entry.kind] = file.data() + entry.offset;
+                sizes[entry.kind] = entry.size;
+            }
+        }
+
+        // The header's counts are untrusted: bound them by the file size
+        // before multiplying, so a huge count cannot wrap to a small size
+        const auto column = [&](Section kind, uint64_t count, size_t width) {
+            const auto index = static_cast<size_t>(kind);
+            if (count > file.size() / width) {
+                throw invalid("count exceeds file size");
+            }
+            if (sections[index] == nullptr || sizes[index] != count * width) {
+                throw invalid("missing or mis-sized section");
+            }
+            return sections[index];
+        };
+
+        if (header.banner_count == UINT64_MAX) {
+            throw invalid("count exceeds file size");
+        }
+
+        address = reinterpret_cast<const uint32_t*>(column(Section::HostAddress, header.host_count, sizeof(uint32_t)));
+        first_port = reinterpret_cast<const uint32_t*>(column(Section::HostFirstPort, header.host_count, sizeof(uint32_t)));
+        open_count = reinterpret_cast<const uint32_t*>(column(Section::HostOpenCount, header.host_count, sizeof(uint32_t)));
+        closed_count = reinterpret_cast<const uint32_t*>(column(Section::HostClosedCount, header.host_count, sizeof(uint32_t)));
+        filtered_count = reinterpret_cast<const uint32_t*>(column(Section::HostFilteredCount, header.host_count, sizeof(uint32_t)));
+        flags = column(Section::HostFlags, header.host_count, sizeof(uint8_t));
+        port_number = reinterpret_cast<const uint16_t*>(column(Section::PortNumber, header.port_count, sizeof(uint16_t)));
+        port_banner = reinterpret_cast<const BannerId*>(column(Section::PortBanner, header.port_count, sizeof(BannerId)));
+        banner_offsets = reinterpret_cast<const uint64_t*>(
+            column(Section::BannerOffsets, header.banner_count + 1, sizeof(uint64_t)));
+        host_count = static_cast<size_t>(header.host_count);
+        port_count = static_cast<size_t>(header.port_count);
+        banner_count = static_cast<size_t>(header.banner_count);
+
+        const auto data_index = static_cast<size_t>(Section::BannerData);
+        if (sections[data_index] == nullptr) {
+            throw invalid("missing banner data");
+        }
+        banner_data = reinterpret_cast<const char*>(sections[data_index]);
+        banner_bytes = sizes[data_index];
+
+        // One pass over the index columns, so lookups need no guards: every
+        // host's ports lie in the port columns, every banner id is known and
+        // every banner lies in the banner data
+        for (size_t i = 0; i < host_count; ++i) {
+            if (first_port[i] > port_count || open_count[i] > port_count - first_port[i]) {
+                throw invalid("port row out of bounds");
+            }
+        }
+        for (size_t i = 0; i < port_count; ++i) {
+            if (port_banner[i] >= banner_count) {
+                throw invalid("unknown banner id");
+            }
+        }
+        for (size_t id = 0; id < banner_count; ++id) {
+            if (banner_offsets[id] > banner_offsets[id + 1]) {
+                throw invalid("banner offsets out of order");
+            }
+        }
+        if (banner_offsets[banner_count] > banner_bytes) {
+            throw invalid("banner out of bounds");
+        }
+
+        const auto settings_index = static_cast<size_t>(Section::Settings);
+        if (sections[settings_index] != nullptr) {
+            const auto* text = reinterpret_cast<const char*>(sections[settings_index]);
+            try {
+                settings = settingsFromJson(json::parse(text, text + sizes[settings_index]));
+            } catch (const json::exception&) {
+                throw invalid("bad settings");
+            }
+        }
+    }
+};
+
+ScanArchiveReader::ScanArchiveReader(const std::string& filepath)
+    : m_impl(std::make_unique<Impl>(filepath)) {}
+
+ScanArchiveReader::~ScanArchiveReader() = default;
+ScanArchiveReader::ScanArchiveReader(ScanArchiveReader&&) noexcept = default;
+ScanArchiveReader& ScanArchiveReader::operator=(ScanArchiveReader&&) noexcept = default;
+
+const ScanSettings& ScanArchiveReader::settings() const {
+    return m_impl->settings;
+}
+
+size_t ScanArchiveReader::hostCount() const {
+    return m_impl->host_count;
+}
+
+size_t ScanArchiveReader::openPortCount() const {
+    return m_impl->port_count;
+}
+
+CompactHost ScanArchiveReader::hostAt(size_t index) const {
+    const Impl& a = *m_impl;
+    CompactHost host{};
+    host.address = a.address[index];
+    host.first_port = a.first_port[index];
+    host.open_count = a.open_count[index];
+    host.closed_count = a.closed_count[index];
+    host.filtered_count = a.filtered_count[index];
+    host.is_alive = (a.flags[index] & 1) != 0;
+    host.liveness = static_cast<Liveness>(a.flags[index] >> 1);
+    return host;
+}
+
+std::span<const uint16_t> ScanArchiveReader::openPorts(size_t index) const {
+    const Impl& a = *m_impl;
+    return std::span<const uint16_t>(a.port_number + a.first_port[index], a.open_count[index]);
+}
+
+std::span<const BannerId> ScanArchiveReader::openPortBanners(size_t index) const {
+    const Impl& a = *m_impl;
+    return std::span<const BannerId>(a.port_banner + a.first_port[index], a.open_count[index]);
+}
+
+std::string_view ScanArchiveReader::banner(BannerId id) const {
+    const Impl& a = *m_impl;
+    if (id == 0 || id >= a.banner_count) {
+        return {};
+    }
+    const uint64_t begin = a.banner_offsets[id];
+    const uint64_t end = a.banner_offsets[id + 1];
+    return std::string_view(a.banner_data + begin, static_cast<size_t>(end - begin));
+}
+
+std::optional<size_t> ScanArchiveReader::findHost(uint32_t address) const {
+    const Impl& a = *m_impl;
+    const uint32_t* end = a.address + a.host_count;
+    const uint32_t* it = std::lower_bound(a.address, end, address);
+    if (it == end || *it != address) {
+        return std::nullopt;
+    }
+    return static_cast<size_t>(it - a.address);
+}
+
+HostResult ScanArchiveReader::host(size_t index) const {
+    const CompactHost compact = hostAt(index);
+    const auto ports = openPorts(index);
+    const auto banners = openPortBanners(index);
+
+    HostResult result(internal::IpRange::toString(compact.address), compact.is_alive);
+    result.liveness = compact.liveness;
+    result.ports.reserve(settings().ports.size());
+    for (uint16_t port : settings().ports) {
+        const auto it = std::lower_bound(ports.begin(), ports.end(), port);
+        if (it != ports.end() && *it == port) {
+            result.ports.emplace_back(port, true, std::string(banner(banners[it - ports.begin()])));
+        } else {
+            result.ports.emplace_back(port, false);
+        }
+    }
+    return result;
+}
+
+ScanResultStore ScanArchiveReader::toStore() const {
+    ScanResultStore store(settings());
+    for (size_t i = 0; i < hostCount(); ++i) {
+        const CompactHost compact = hostAt(i);
+        const auto ports = openPorts(i);
+        const auto banners = openPortBanners(i);
+
+        HostResult host(std::string(), compact.is_alive);
+        host.liveness = compact.liveness;
+        host.closed_ports = compact.closed_count;
+        host.filtered_ports = compact.filtered_count;
+        host.ports.reserve(ports.size());
+        for (size_t p = 0; p < ports.size(); ++p) {
+            host.ports.emplace_back(ports[p], true, std::string(banner(banners[p])));
+        }
+        store.addHost(compact.address, host);
+    }
+    return store;
+}
+
+ScanResult ScanArchiveReader::toScanResult() const {
+    ScanResult result(settings());
+    result.hosts.reserve(hostCount());
+    for (size_t i = 0; i < hostCount(); ++i) {
+        result.hosts.push_back(host(i));
+    }
+    return result;
+}
+
+} // namespace netlens
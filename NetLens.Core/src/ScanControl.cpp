@@ -0,0 +1,74 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "netlens/ScanControl.h"
+#include <algorithm>
+
+namespace netlens {
+
+ScanControl::ScanControl()
+    : m_stop()
+    , m_forward()
+    , m_paused(false)
+    , m_next_listener(1)
+    , m_listeners() {}
+
+ScanControl::ScanControl(std::stop_token stopToken)
+    : ScanControl() {
+    m_forward.emplace(std::move(stopToken), std::function<void()>([this]() {
+        m_stop.request_stop();
+    }));
+}
+
+ScanControl::~ScanControl() = default;
+
+void ScanControl::cancel() {
+    m_stop.request_stop();
+}
+
+void ScanControl::pause() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_paused) {
+        return;
+    }
+    m_paused = true;
+    for (auto& entry : m_listeners) {
+        entry.second(true);
+    }
+}
+
+void ScanControl::resume() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_paused) {
+        return;
+    }
+    m_paused = false;
+    for (auto& entry : m_listeners) {
+        entry.second(false);
+    }
+}
+
+bool ScanControl::paused() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_paused;
+}
+
+size_t ScanControl::addPauseListener(PauseListener listener) {
+    // Called under the lock, so the listener cannot miss a change
+    std::lock_guard<std::mutex> lock(m_mutex);
+    listener(m_paused);
+    const size_t id = m_next_listener++;
+    m_listeners.emplace_back(id, std::move(listener));
+    return id;
+}
+
+void ScanControl::removePauseListener(size_t id) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_listeners.erase(std::remove_if(m_listeners.begin(), m_listeners.end(),
+                                     [id](const auto& entry) { return entry.first == id; }),
+                      m_listeners.end());
+}
+
+} // namespace netlens
@@ -0,0 +1,36 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "netlens/ScanDelta.h"
+#include "netlens/JsonExporter.h"
+#include "netlens/ScanArchive.h"
+#include "IpRange.h"
+#include <stdexcept>
+
+namespace netlens {
+
+ScanBaseline::ScanBaseline(ScanResultStore results)
+    : m_results(std::move(results)) {
+    m_results.sortByAddress();
+}
+
+ScanBaseline ScanBaseline::load(const std::string& filepath) {
+    if (ScanArchive::isArchive(filepath)) {
+        return ScanBaseline(ScanArchiveReader(filepath).toStore());
+    }
+
+    const ScanResult result = JsonExporter::loadFromFile(filepath);
+    ScanResultStore store(result.settings);
+    for (const auto& host : result.hosts) {
+        try {
+            store.addHost(internal::IpRange::parse(host.address), host);
+        } catch (const internal::IpRangeException& e) {
+            throw std::runtime_error("Invalid host address in " + filepath + ": " + e.what());
+        }
+    }
+    return ScanBaseline(std::move(store));
+}
+
+} // namespace netlens
@@ -0,0 +1,42 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "ScanEngine.h"
+#include "AsyncScanEngine.h"
+#ifdef __linux__
+#include "SynScanEngine.h"
+#endif
+#include <stdexcept>
+
+namespace netlens::internal {
+
+std::unique_ptr<ScanEngine> ScanEngine::create(ScanMode mode, const EngineOptions& options) {
+    switch (mode) {
+        case ScanMode::Connect:
+            return std::make_unique<AsyncScanEngine>(options);
+
+        case ScanMode::Syn:
+#ifdef __linux__
+            return std::make_unique<SynScanEngine>();
+#else
+            throw std::runtime_error("SYN scanning is only supported on Linux");
+#endif
+    }
+    throw std::invalid_argument("Unknown scan mode");
+}
+
+ScanResultStore ScanEngine::executeScan(const ScanSettings& settings, ProgressCallback progressCallback,
+                                        ScanControl* control) {
+    ScanResultStore store(settings);
+    executeScan(settings,
+        [&store](uint32_t address, HostResult&& host) {
+            store.addHost(address, host);
+        },
+        std::move(progressCallback), control);
+    store.sortByAddress();
+    return store;
+}
+
+} // namespace netlens::internal
@@ -0,0 +1,68 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#pragma once
+
+#include <netlens/Scanner.h>
+#include <netlens/ScanResultStore.h>
+#include <netlens/EngineOptions.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace netlens::internal {
+
+/// <summary>
+/// Common interface of the scan engines behind Scanner. Each engine is a
+/// different transport (full TCP connect, raw SYN, ...) producing the same
+/// streamed host results. Engines are long-lived: Scanner keeps one per
+/// mode and may run several scans on it at once, from different threads.
+/// </summary>
+class ScanEngine {
+public:
+    /// <summary>
+    /// Receives each completed host together with its numeric IPv4 address.
+    /// The host lists only its open ports.
+    /// </summary>
+    using HostSink = std::function<void(uint32_t address, HostResult&& host)>;
+
+    virtual ~ScanEngine() = default;
+
+    /// <summary>
+    /// Creates the engine implementing the requested scan mode.
+    /// </summary>
+    /// <param name="mode">Probe transport</param>
+    /// <param name="options">Execution settings; the SYN engine runs its own sender and receiver threads and ignores them</param>
+    /// <exception cref="std::runtime_error">Thrown if the mode is unavailable on this platform</exception>
+    static std::unique_ptr<ScanEngine> create(ScanMode mode, const EngineOptions& options = EngineOptions());
+
+    /// <summary>
+    /// Executes a scan and streams each host to the sink as soon as it
+    /// completes. The sink runs on the calling thread. If the sink throws,
+    /// the scan stops and the exception is rethrown. On cancellation the
+    /// engine closes its pending probes and returns once the hosts completed
+    /// so far are delivered; hosts left unfinished are not emitted.
+    /// </summary>
+    /// <param name="settings">Scan configuration</param>
+    /// <param name="sink">Receives completed hosts, in completion order</param>
+    /// <param name="progressCallback">Optional progress callback</param>
+    /// <param name="control">Optional cancel and pause control</param>
+    /// <returns>Totals for the scan</returns>
+    virtual ScanSummary executeScan(const ScanSettings& settings, const HostSink& sink,
+                                    ProgressCallback progressCallback, ScanControl* control) = 0;
+
+    /// <summary>
+    /// Executes a scan and collects every host.
+    /// Blocks the calling thread until the scan is complete.
+    /// </summary>
+    /// <param name="settings">Scan configuration</param>
+    /// <param name="progressCallback">Optional progress callback</param>
+    /// <param name="control">Optional cancel and pause control</param>
+    /// <returns>Complete scan results in compact form, sorted by address</returns>
+    ScanResultStore executeScan(const ScanSettings& settings, ProgressCallback progressCallback,
+                                ScanControl* control = nullptr);
+};
+
+} // namespace netlens::internal
@@ -0,0 +1,436 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "ScanJournal.h"
+#include "IpRange.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace netlens::internal {
+
+namespace {
+
+constexpr char MAGIC[8] = { 'N', 'L', 'J', 'R', 'N', 'L', 0x1A, '\n' };
+constexpr uint32_t FORMAT_VERSION = 1;
+
+// Header: magic, version, reserved, settings fingerprint
+constexpr size_t HEADER_SIZE = 8 + 4 + 4 + 8;
+
+// Record frame: payload length, CRC-32 of the payload
+constexpr size_t FRAME_SIZE = 4 + 4;
+
+// Longest payload accepted when reading; a larger length is a torn frame
+constexpr uint32_t MAX_PAYLOAD = 64 * 1024 * 1024;
+
+uint32_t crc32(const char* data, size_t size) {
+    static const auto table = []() {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            t[i] = c;
+        }
+        return t;
+    }();
+
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ static_cast<uint8_t>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+template<typename T>
+void put(std::string& out, T value) {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    out.append(bytes, sizeof(T));
+}
+
+/// <summary>
+/// Bounds-checked little-endian reader over a record payload.
+/// </summary>
+class PayloadReader {
+public:
+    PayloadReader(const char* data, size_t size) : m_data(data), m_size(size), m_offset(0) {}
+
+    template<typename T>
+    bool get(T& value) {
+        if (m_size - m_offset < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, m_data + m_offset, sizeof(T));
+        m_offset += sizeof(T);
+        return true;
+    }
+
+    bool get(std::string& text, size_t length) {
+        if (m_size - m_offset < length) {
+            return false;
+        }
+        text.assign(m_data + m_offset, length);
+        m_offset += length;
+        return true;
+    }
+
+private:
+    const char* m_data;
+    size_t m_size;
+    size_t m_offset;
+};
+
+bool decodeHost(const char* data, size_t size, uint32_t& address, HostResult& host) {
+    PayloadReader reader(data, size);
+    uint8_t flags;
+    uint32_t open_count;
+    if (!reader.get(address) || !reader.get(flags) || !reader.get(host.closed_ports) ||
+        !reader.get(host.filtered_ports) || !reader.get(open_count)) {
+        return false;
+    }
+    host.address = IpRange::toString(address);
+    host.is_alive = (flags & 1) != 0;
+    host.liveness = static_cast<Liveness>(flags >> 1);
+
+    for (uint32_t i = 0; i < open_count; ++i) {
+        uint16_t port;
+        uint32_t banner_length;
+        std::string banner;
+        if (!reader.get(port) || !reader.get(banner_length) || !reader.get(banner, banner_length)) {
+            return false;
+        }
+        host.ports.emplace_back(port, true, std::move(banner));
+    }
+    return true;
+}
+
+} // namespace
+
+uint64_t ScanJournal::fingerprint(const ScanSettings& settings) {
+    // FNV-1a over the fields that decide which probes a scan sends; timing,
+    // rate and concurrency may change between runs
+    uint64_t hash = 0xCBF29CE484222325ull;
+    const auto mix = [&hash](const void* data, size_t size) {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+        }
+    };
+    const auto mixString = [&mix](const std::string& text) {
+        const uint64_t length = text.size();
+        mix(&length, sizeof(length));
+        mix(text.data(), text.size());
+    };
+    const auto mixPorts = [&mix](const std::vector<uint16_t>& ports) {
+        const uint64_t count = ports.size();
+        mix(&count, sizeof(count));
+        mix(ports.data(), ports.size() * sizeof(uint16_t));
+    };
+
+    mixString(settings.start_ip);
+    mixString(settings.end_ip);
+    for (const auto* specs : { &settings.targets, &settings.excludes }) {
+        const uint64_t count = specs->size();
+        mix(&count, sizeof(count));
+        for (const auto& spec : *specs) {
+            mixString(spec);
+        }
+    }
+    mixPorts(settings.ports);
+
+    const uint8_t mode[] = {
+        static_cast<uint8_t>(settings.scan_mode),
+        static_cast<uint8_t>(settings.host_discovery),
+        static_cast<uint8_t>(settings.discovery_echo)
+    };
+    mix(mode, sizeof(mode));
+    if (settings.host_discovery == HostDiscovery::Ping) {
+        mixPorts(settings.discovery_ports);
+    }
+    return hash;
+}
+
+ScanJournal::ScanJournal(const std::string& filepath, const ScanSettings& settings, const ReplaySink& replay)
+    : m_path(filepath)
+    , m_last_sync(Clock::now()) {
+    const uint64_t expected = fingerprint(settings);
+
+    // Replay what earlier runs recorded; the valid prefix is kept and
+    // anything after it, such as a torn last record, is cut off
+    std::string contents;
+    {
+        std::ifstream existing(filepath, std::ios::binary);
+        if (existing.is_open()) {
+            contents.assign(std::istreambuf_iterator<char>(existing), std::istreambuf_iterator<char>());
+        }
+    }
+
+    uint64_t valid_end = 0;
+    if (contents.size() >= HEADER_SIZE) {
+        uint32_t version;
+        uint64_t recorded_fingerprint;
+        std::memcpy(&version, contents.data() + 8, sizeof(version));
+        std::memcpy(&recorded_fingerprint, contents.data() + 16, sizeof(recorded_fingerprint));
+        if (std::memcmp(contents.data(), MAGIC, sizeof(MAGIC)) != 0 || version != FORMAT_VERSION) {
+            throw std::runtime_error("Not a scan journal: " + filepath);
+        }
+        if (recorded_fingerprint != expected) {
+            throw std::runtime_error("Journal " + filepath + " belongs to a scan with different targets or ports");
+        }
+
+        size_t offset = HEADER_SIZE;
+        while (contents.size() - offset >= FRAME_SIZE) {
+            uint32_t length;
+            uint32_t checksum;
+            std::memcpy(&length, contents.data() + offset, sizeof(length));
+            std::memcpy(&checksum, contents.data() + offset + 4, sizeof(checksum));
+            const char* payload = contents.data() + offset + FRAME_SIZE;
+            if (length > MAX_PAYLOAD || contents.size() - offset - FRAME_SIZE < length ||
+                crc32(payload, length) != checksum) {
+                break;
+            }
+
+            uint32_t address;
+            HostResult host;
+            if (!decodeHost(payload, length, address, host)) {
+                break;
+            }
+            m_recorded.push_back(address);
+            if (replay) {
+                replay(address, std::move(host));
+            }
+            offset += FRAME_SIZE + length;
+        }
+        valid_end = offset;
+    } else if (!contents.empty() &&
+               std::memcmp(contents.data(), MAGIC, std::min(contents.size(), sizeof(MAGIC))) != 0) {
+        throw std::runtime_error("Not a scan journal: " + filepath);
+    }
+    contents.clear();
+    contents.shrink_to_fit();
+    std::sort(m_recorded.begin(), m_recorded.end());
+
+#ifdef _WIN32
+    HANDLE file = ::CreateFileA(filepath.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                                OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Cannot open journal " + filepath);
+    }
+    LARGE_INTEGER end;
+    end.QuadPart = static_cast<LONGLONG>(valid_end);
+    if (!::SetFilePointerEx(file, end, nullptr, FILE_BEGIN) || !::SetEndOfFile(file)) {
+        ::CloseHandle(file);
+        throw std::runtime_error("Cannot truncate journal " + filepath);
+    }
+    m_file = file;
+#else
+    m_file = ::open(filepath.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+    if (m_file < 0) {
+        throw std::runtime_error("Cannot open journal " + filepath + ": " + std::strerror(errno));
+    }
+    if (::ftruncate(m_file, static_cast<off_t>(valid_end)) != 0 ||
+        ::lseek(m_file, static_cast<off_t>(valid_end), SEEK_SET) < 0) {
+        ::close(m_file);
+        throw std::runtime_error("Cannot truncate journal " + filepath + ": " + std::strerror(errno));
+    }
+#endif
+
+    if (valid_end == 0) {
+        m_buffer.append(MAGIC, sizeof(MAGIC));
+        put(m_buffer, FORMAT_VERSION);
+        put(m_buffer, uint32_t{ 0 });
+        put(m_buffer, expected);
+        try {
+            syncLocked();
+        } catch (...) {
+#ifdef _WIN32
+            ::CloseHandle(m_file);
+#else
+            ::close(m_file);
+#endif
+            throw;
+        }
+    }
+
+    m_flusher = std::thread([this]() { run(); });
+}
+
+ScanJournal::~ScanJournal() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_flusher.join();
+
+    try {
+        syncLocked();
+    } catch (...) {
+    }
+#ifdef _WIN32
+    ::CloseHandle(m_file);
+#else
+    ::close(m_file);
+#endif
+}
+
+void ScanJournal::append(uint32_t address, const HostResult& host) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_error) {
+        std::rethrow_exception(m_error);
+    }
+
+    const size_t frame = m_buffer.size();
+    put(m_buffer, uint32_t{ 0 });   // Length and checksum are filled in below
+    put(m_buffer, uint32_t{ 0 });
+
+    const size_t payload = m_buffer.size();
+    uint32_t open_count = 0;
+    for (const auto& port : host.ports) {
+        open_count += port.is_open ? 1 : 0;
+    }
+    put(m_buffer, address);
+    put(m_buffer, static_cast<uint8_t>((host.is_alive ? 1 : 0) | (static_cast<uint8_t>(host.liveness) << 1)));
+    put(m_buffer, host.closed_ports + static_cast<uint32_t>(host.ports.size() - open_count));
+    put(m_buffer, host.filtered_ports);
+    put(m_buffer, open_count);
+    for (const auto& port : host.ports) {
+        if (port.is_open) {
+            put(m_buffer, port.port);
+            put(m_buffer, static_cast<uint32_t>(port.banner.size()));
+            m_buffer += port.banner;
+        }
+    }
+
+    const auto length = static_cast<uint32_t>(m_buffer.size() - payload);
+    const uint32_t checksum = crc32(m_buffer.data() + payload, length);
+    std::memcpy(&m_buffer[frame], &length, sizeof(length));
+    std::memcpy(&m_buffer[frame + 4], &checksum, sizeof(checksum));
+
+    if (m_buffer.size() >= SYNC_BYTES) {
+        syncLocked();
+    }
+}
+
+void ScanJournal::sync() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_error) {
+        std::rethrow_exception(m_error);
+    }
+    syncLocked();
+}
+
+void ScanJournal::discard(const std::string& filepath) {
+    std::error_code error;
+    std::filesystem::remove(filepath, error);
+    if (error) {
+        throw std::runtime_error("Cannot delete journal " + filepath + ": " + error.message());
+    }
+}
+
+void ScanJournal::requestSync() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_sync_requested = true;
+    }
+    m_wake.notify_one();
+}
+
+void ScanJournal::run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stopping) {
+        // Appends reaching SYNC_BYTES move the deadline along
+        const auto due = m_last_sync + SYNC_INTERVAL;
+        m_wake.wait_until(lock, due, [this]() { return m_stopping || m_sync_requested; });
+        if (m_stopping) {
+            break;
+        }
+        if (m_sync_requested || Clock::now() >= m_last_sync + SYNC_INTERVAL) {
+            m_sync_requested = false;
+            try {
+                syncLocked();
+            } catch (...) {
+                // Reported by the next append or sync
+                m_error = std::current_exception();
+                break;
+            }
+        }
+    }
+}
+
+void ScanJournal::syncLocked() {
+    m_last_sync = Clock::now();
+    if (m_buffer.empty()) {
+        return;
+    }
+    size_t written = 0;
+    try {
+        writeAll(m_buffer.data(), m_buffer.size(), written);
+    } catch (...) {
+        // What reached the file stays there; writing it again would leave a
+        // torn frame mid-file and recovery would stop at it
+        m_buffer.erase(0, written);
+        throw;
+    }
+    m_buffer.clear();
+
+#ifdef _WIN32
+    if (!::FlushFileBuffers(m_file)) {
+        throw std::runtime_error("Cannot sync journal " + m_path);
+    }
+#elif defined(__linux__)
+    if (::fdatasync(m_file) != 0) {
+        throw std::runtime_error("Cannot sync journal " + m_path + ": " + std::strerror(errno));
+    }
+#else
+    if (::fsync(m_file) != 0) {
+        throw std::runtime_error("Cannot sync journal " + m_path + ": " + std::strerror(errno));
+    }
+#endif
+}
+
+void ScanJournal::writeAll(const void* data, size_t size, size_t& written_total) {
+    const auto* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+#ifdef _WIN32
+        DWORD written = 0;
+        const DWORD chunk = static_cast<DWORD>(std::min<size_t>(size, 1u << 30));
+        if (!::WriteFile(m_file, bytes, chunk, &written, nullptr)) {
+            written_total += written;
+            throw std::runtime_error("Cannot write journal " + m_path);
+        }
+#else
+        const ssize_t written = ::write(m_file, bytes, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("Cannot write journal " + m_path + ": " + std::strerror(errno));
+        }
+#endif
+        bytes += written;
+        size -= static_cast<size_t>(written);
+        written_total += static_cast<size_t>(written);
+    }
+}
+
+} // namespace netlens::internal
@@ -0,0 +1,125 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#pragma once
+
+#include <netlens/HostResult.h>
+#include <netlens/ScanSettings.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace netlens::internal {
+
+/// <summary>
+/// Append-only journal of completed hosts, used to resume an interrupted
+/// scan. The file starts with a header carrying a fingerprint of the
+/// settings that define the work (targets, excludes, ports, mode and
+/// discovery), followed by one checksummed record per host. A torn record
+/// at the end, left by a crash mid-write, is dropped when the journal is
+/// reopened. Records are buffered and written with one sync per batch; a
+/// thread of the journal's own syncs what is buffered once SYNC_INTERVAL
+/// has passed, so a crash loses at most that much work even when no host
+/// completes for a while. Thread-safe.
+/// </summary>
+class ScanJournal {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t SYNC_BYTES = 256 * 1024;
+    static constexpr Clock::duration SYNC_INTERVAL = std::chrono::seconds(1);
+
+    /// <summary>
+    /// Receives a host recorded by an earlier run.
+    /// </summary>
+    using ReplaySink = std::function<void(uint32_t address, HostResult&& host)>;
+
+    /// <summary>
+    /// Opens or creates the journal. An existing journal's hosts are passed
+    /// to replay in the order they were recorded.
+    /// </summary>
+    /// <exception cref="std::runtime_error">Thrown if the file cannot be opened or holds a journal of different settings</exception>
+    ScanJournal(const std::string& filepath, const ScanSettings& settings, const ReplaySink& replay);
+
+    /// <summary>
+    /// Stops the background sync and syncs buffered records.
+    /// </summary>
+    ~ScanJournal();
+
+    ScanJournal(const ScanJournal&) = delete;
+    ScanJournal& operator=(const ScanJournal&) = delete;
+
+    /// <summary>
+    /// Addresses of the hosts recorded by earlier runs, ascending.
+    /// </summary>
+    const std::vector<uint32_t>& recorded() const { return m_recorded; }
+
+    /// <summary>
+    /// Appends a completed host. Syncs once SYNC_BYTES are buffered; the
+    /// background sync handles SYNC_INTERVAL.
+    /// </summary>
+    /// <exception cref="std::runtime_error">Thrown if writing fails, here or in the background sync</exception>
+    void append(uint32_t address, const HostResult& host);
+
+    /// <summary>
+    /// Writes and syncs buffered records.
+    /// </summary>
+    /// <exception cref="std::runtime_error">Thrown if writing fails, here or in the background sync</exception>
+    void sync();
+
+    /// <summary>
+    /// Has the background thread sync buffered records now instead of at
+    /// the end of the interval, e.g. when the scan is paused. Returns at once.
+    /// </summary>
+    void requestSync();
+
+    /// <summary>
+    /// Deletes the journal of a scan that ran to completion, so the next
+    /// scan with the same settings starts afresh instead of replaying it.
+    /// A missing file is not an error.
+    /// </summary>
+    /// <exception cref="std::runtime_error">Thrown if the file cannot be deleted</exception>
+    static void discard(const std::string& filepath);
+
+    /// <summary>
+    /// Fingerprint of the settings that define a scan's work.
+    /// </summary>
+    static uint64_t fingerprint(const ScanSettings& settings);
+
+private:
+    void run();
+    void syncLocked();
+    /// <summary>
+    /// Writes size bytes, adding those that reached the file to
+    /// written_total, also when a write fails part-way.
+    /// </summary>
+    void writeAll(const void* data, size_t size, size_t& written_total);
+
+#ifdef _WIN32
+    void* m_file;
+#else
+    int m_file;
+#endif
+    std::string m_path;
+    std::vector<uint32_t> m_recorded;
+
+    std::mutex m_mutex;                 // Guards the members below and the file
+    std::condition_variable m_wake;
+    std::string m_buffer;
+    Clock::time_point m_last_sync;
+    bool m_sync_requested = false;
+    bool m_stopping = false;
+    std::exception_ptr m_error;         // First failure of the background sync
+    std::thread m_flusher;
+};
+
+} // namespace netlens::internal
@@ -0,0 +1,142 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "netlens/ScanResultStore.h"
+#include "IpRange.h"
+#include <algorithm>
+
+namespace netlens {
+
+BannerTable::BannerTable() {
+    m_strings.emplace_back();
+    m_index.emplace(std::string_view(m_strings.front()), 0);
+}
+
+BannerTable::BannerTable(const BannerTable& other)
+    : m_strings(other.m_strings)
+{
+    // Views in the index must point into this table's own strings
+    m_index.reserve(m_strings.size());
+    for (size_t i = 0; i < m_strings.size(); ++i) {
+        m_index.emplace(std::string_view(m_strings[i]), static_cast<BannerId>(i));
+    }
+}
+
+BannerTable& BannerTable::operator=(const BannerTable& other) {
+    if (this != &other) {
+        BannerTable copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+BannerId BannerTable::intern(std::string_view banner) {
+    if (banner.empty()) {
+        return 0;
+    }
+
+    auto it = m_index.find(banner);
+    if (it != m_index.end()) {
+        return it->second;
+    }
+
+    const BannerId id = static_cast<BannerId>(m_strings.size());
+    m_strings.emplace_back(banner);
+    m_index.emplace(std::string_view(m_strings.back()), id);
+    return id;
+}
+
+std::string_view BannerTable::get(BannerId id) const {
+    if (id >= m_strings.size()) {
+        return {};
+    }
+    return m_strings[id];
+}
+
+ScanResultStore::ScanResultStore() = default;
+
+ScanResultStore::ScanResultStore(const ScanSettings& settings)
+    : m_settings(settings) {}
+
+void ScanResultStore::addHost(uint32_t address, const HostResult& host) {
+    CompactHost compact{};
+    compact.address = address;
+    compact.first_port = static_cast<uint32_t>(m_ports.size());
+    compact.closed_count = host.closed_ports;
+    compact.filtered_count = host.filtered_ports;
+    compact.is_alive = host.is_alive;
+    compact.liveness = host.liveness;
+
+    for (const auto& port : host.ports) {
+        if (port.is_open) {
+            m_ports.push_back(CompactPort{ port.port, m_banners.intern(port.banner) });
+            ++compact.open_count;
+        } else {
+            ++compact.closed_count;
+        }
+    }
+
+    m_hosts.push_back(compact);
+}
+
+void ScanResultStore::sortByAddress() {
+    std::sort(m_hosts.begin(), m_hosts.end(),
+              [](const CompactHost& a, const CompactHost& b) { return a.address < b.address; });
+}
+
+std::span<const CompactPort> ScanResultStore::openPorts(size_t index) const {
+    const CompactHost& host = m_hosts[index];
+    return std::span<const CompactPort>(m_ports.data() + host.first_port, host.open_count);
+}
+
+std::optional<size_t> ScanResultStore::findHost(uint32_t address) const {
+    auto it = std::lower_bound(m_hosts.begin(), m_hosts.end(), address,
+                               [](const CompactHost& h, uint32_t a) { return h.address < a; });
+    if (it == m_hosts.end() || it->address != address) {
+        return std::nullopt;
+    }
+    return static_cast<size_t>(it - m_hosts.begin());
+}
+
+size_t ScanResultStore::aliveHostCount() const {
+    return static_cast<size_t>(std::count_if(m_hosts.begin(), m_hosts.end(),
+                                             [](const CompactHost& h) { return h.is_alive; }));
+}
+
+HostResult ScanResultStore::host(size_t index) const {
+    const CompactHost& compact = m_hosts[index];
+    const auto stored = openPorts(index);
+
+    // Sorted by port so each configured port is a binary search, keeping a
+    // full-port scan of a host with many open ports O(ports log open)
+    std::vector<CompactPort> open(stored.begin(), stored.end());
+    std::sort(open.begin(), open.end(),
+              [](const CompactPort& a, const CompactPort& b) { return a.port < b.port; });
+
+    HostResult result(internal::IpRange::toString(compact.address), compact.is_alive);
+    result.liveness = compact.liveness;
+    result.ports.reserve(m_settings.ports.size());
+    for (uint16_t port : m_settings.ports) {
+        auto it = std::lower_bound(open.begin(), open.end(), port,
+                                   [](const CompactPort& p, uint16_t value) { return p.port < value; });
+        if (it != open.end() && it->port == port) {
+            result.ports.emplace_back(port, true, std::string(m_banners.get(it->banner)));
+        } else {
+            result.ports.emplace_back(port, false);
+        }
+    }
+    return result;
+}
+
+ScanResult ScanResultStore::toScanResult() const {
+    ScanResult result(m_settings);
+    result.hosts.reserve(m_hosts.size());
+    for (size_t i = 0; i < m_hosts.size(); ++i) {
+        result.hosts.push_back(host(i));
+    }
+    return result;
+}
+
+} // namespace netlens
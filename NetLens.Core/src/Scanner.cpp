@@ -4,46 +4,234 @@
 // See the LICENSE file in the project root for details.
 
 #include "netlens/Scanner.h"
-#include "AsyncScanEngine.h"
+#include "ScanEngine.h"
+#include "ControlSubscription.h"
+#include "DeltaScan.h"
 #include "IpRange.h"
+#include "ScanJournal.h"
+#include "TargetSpec.h"
+#include <mutex>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace netlens {
 
-Scanner::Scanner() {
-    // Constructor
+namespace {
+
+void validateSettings(const ScanSettings& settings) {
+    const bool has_range = !settings.start_ip.empty() || !settings.end_ip.empty();
+    if (!has_range && settings.targets.empty()) {
+        throw std::invalid_argument("Start IP and End IP or at least one target must be provided");
+    }
+
+    if (settings.ports.empty()) {
+        throw std::invalid_argument("At least one port must be specified");
+    }
+
+    if (has_range) {
+        if (!internal::IpRange::isValid(settings.start_ip)) {
+            throw std::invalid_argument("Invalid start IP address: " + settings.start_ip);
+        }
+
+        if (!internal::IpRange::isValid(settings.end_ip)) {
+            throw std::invalid_argument("Invalid end IP address: " + settings.end_ip);
+        }
+    }
+
+    for (const auto* specs : { &settings.targets, &settings.excludes }) {
+        for (const auto& spec : *specs) {
+            try {
+                internal::TargetSpec::parse(spec);
+            } catch (const internal::IpRangeException& e) {
+                throw std::invalid_argument(e.what());
+            }
+        }
+    }
 }
 
-Scanner::~Scanner() {
-    // Destructor
+/// <summary>
+/// Deletes the journal of a scan that ran to completion. Cancelled and
+/// failed scans keep theirs, to be resumed.
+/// </summary>
+void discardJournal(const ScanSettings& settings, const ScanSummary& summary) {
+    if (!settings.journal_path.empty() && !summary.cancelled) {
+        internal::ScanJournal::discard(settings.journal_path);
+    }
+}
+
+/// <summary>
+/// Runs the scan on the given engine. With a journal, hosts recorded by an
+/// earlier run are replayed to the sink first and excluded from the scan,
+/// and every host the engine completes is recorded before the sink sees it.
+/// Pausing or cancelling the scan syncs the journal without waiting for
+/// its interval.
+/// </summary>
+ScanSummary runScan(internal::ScanEngine& engine, const ScanSettings& settings,
+                    const internal::ScanEngine::HostSink& sink,
+                    ProgressCallback progressCallback, ScanControl* control) {
+    if (settings.journal_path.empty()) {
+        return engine.executeScan(settings, sink, progressCallback, control);
+    }
+
+    ScanSummary replayed;
+    internal::ScanJournal journal(settings.journal_path, settings,
+        [&sink, &replayed](uint32_t address, HostResult&& host) {
+            ++replayed.total_hosts;
+            replayed.alive_hosts += host.is_alive ? 1 : 0;
+            replayed.open_ports += host.ports.size();
+            sink(address, std::move(host));
+        });
+
+    // Recorded hosts are excluded as coalesced ranges
+    std::vector<internal::IpRange> recorded;
+    recorded.reserve(journal.recorded().size());
+    for (uint32_t address : journal.recorded()) {
+        recorded.emplace_back(address, address);
+    }
+    ScanSettings remaining = settings;
+    for (auto& spec : internal::TargetSpec::format(internal::IntervalSet::fromRanges(std::move(recorded)))) {
+        remaining.excludes.push_back(std::move(spec));
+    }
+
+    internal::ControlSubscription subscription(control,
+        [&journal](bool paused) {
+            if (paused) {
+                journal.requestSync();
+            }
+        },
+        [&journal]() { journal.requestSync(); });
+
+    ScanSummary summary = engine.executeScan(remaining,
+        [&sink, &journal](uint32_t address, HostResult&& host) {
+            journal.append(address, host);
+            sink(address, std::move(host));
+        },
+        progressCallback, control);
+    subscription.reset();
+    journal.sync();
+
+    summary.total_hosts += replayed.total_hosts;
+    summary.alive_hosts += replayed.alive_hosts;
+    summary.open_ports += replayed.open_ports;
+    return summary;
 }
 
+} // namespace
+
+struct Scanner::Impl {
+    const EngineOptions options;
+    std::mutex mutex;
+    std::unique_ptr<internal::ScanEngine> connect_engine;
+    std::unique_ptr<internal::ScanEngine> syn_engine;
+
+    explicit Impl(const EngineOptions& engine_options)
+        : options(engine_options) {}
+
+    /// <summary>
+    /// The engine for a scan mode, created on first use.
+    /// </summary>
+    internal::ScanEngine& engine(ScanMode mode) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& engine = mode == ScanMode::Syn ? syn_engine : connect_engine;
+        if (!engine) {
+            engine = internal::ScanEngine::create(mode, options);
+        }
+        return *engine;
+    }
+};
+
+Scanner::Scanner()
+    : Scanner(EngineOptions()) {}
+
+Scanner::Scanner(const EngineOptions& options)
+    : m_impl(std::make_unique<Impl>(options)) {}
+
+Scanner::~Scanner() = default;
+
 ScanResult Scanner::scan(const ScanSettings& settings) {
     // Call overload with null progress callback
     return scan(settings, nullptr);
 }
 
-ScanResult Scanner::scan(const ScanSettings& settings, ProgressCallback progressCallback) {
-    // Validate settings
-    if (settings.start_ip.empty() || settings.end_ip.empty()) {
-        throw std::invalid_argument("Start IP and End IP must be provided");
-    }
+ScanResult Scanner::scan(const ScanSettings& settings, ProgressCallback progressCallback, ScanControl* control) {
+    // Legacy view: every probed port of every host
+    return scanCompact(settings, progressCallback, control).toScanResult();
+}
 
-    if (settings.ports.empty()) {
-        throw std::invalid_argument("At least one port must be specified");
-    }
+ScanResultStore Scanner::scanCompact(const ScanSettings& settings, ProgressCallback progressCallback,
+                                     ScanControl* control) {
+    validateSettings(settings);
+
+    ScanResultStore store(settings);
+    const ScanSummary summary = runScan(m_impl->engine(settings.scan_mode), settings,
+        [&store](uint32_t address, HostResult&& host) {
+            store.addHost(address, host);
+        },
+        progressCallback, control);
+    discardJournal(settings, summary);
+    store.sortByAddress();
+    return store;
+}
+
+ScanSummary Scanner::scanStream(const ScanSettings& settings, HostResultCallback hostCallback,
+                                ProgressCallback progressCallback, ScanControl* control) {
+    validateSettings(settings);
 
-    if (!internal::IpRange::isValid(settings.start_ip)) {
-        throw std::invalid_argument("Invalid start IP address: " + settings.start_ip);
+    if (!hostCallback) {
+        throw std::invalid_argument("A host callback must be provided");
     }
 
-    if (!internal::IpRange::isValid(settings.end_ip)) {
-        throw std::invalid_argument("Invalid end IP address: " + settings.end_ip);
+    const ScanSummary summary = runScan(m_impl->engine(settings.scan_mode), settings,
+        [&hostCallback](uint32_t, HostResult&& host) {
+            hostCallback(std::move(host));
+        },
+        progressCallback, control);
+    discardJournal(settings, summary);
+    return summary;
+}
+
+ScanDelta Scanner::scanDelta(const ScanSettings& settings, const ScanBaseline& baseline,
+                             const DeltaOptions& options, ProgressCallback progressCallback,
+                             ScanControl* control) {
+    validateSettings(settings);
+
+    internal::DeltaScan delta(settings, baseline, options);
+    size_t pass = 0;
+    std::vector<std::string> journals;
+    while (auto targets = delta.nextPass()) {
+        ScanSettings pass_settings = settings;
+        pass_settings.start_ip.clear();
+        pass_settings.end_ip.clear();
+        pass_settings.targets = internal::TargetSpec::format(*targets);
+        pass_settings.excludes.clear();     // Already applied to the pass targets
+        if (pass > 0 && !settings.journal_path.empty()) {
+            pass_settings.journal_path += '.';
+            pass_settings.journal_path += std::to_string(pass);
+        }
+        ++pass;
+
+        const ScanSummary summary = runScan(m_impl->engine(pass_settings.scan_mode), pass_settings,
+            [&delta](uint32_t address, HostResult&& host) {
+                delta.record(address, host);
+            },
+            progressCallback, control);
+        if (summary.cancelled) {
+            ScanDelta partial = delta.finish();
+            partial.cancelled = true;
+            return partial;
+        }
+        if (!pass_settings.journal_path.empty()) {
+            journals.push_back(std::move(pass_settings.journal_path));
+        }
     }
 
-    // Create async scan engine and execute scan
-    internal::AsyncScanEngine engine;
-    return engine.executeScan(settings, progressCallback);
+    // A resumed delta scan replays its finished passes, so their journals
+    // are kept until the last pass is done
+    for (const auto& journal : journals) {
+        internal::ScanJournal::discard(journal);
+    }
+    return delta.finish();
 }
 
 } // namespace netlens
@@ -0,0 +1,34 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include <netlens/SimulatedNetwork.h>
+#include "NetworkModel.h"
+#include "TargetSpec.h"
+#include <stdexcept>
+
+namespace netlens {
+
+SimulatedNetwork::SimulatedNetwork(uint64_t seed)
+    : m_model(std::make_shared<internal::NetworkModel>(seed)) {}
+
+SimulatedNetwork::~SimulatedNetwork() = default;
+
+void SimulatedNetwork::addHosts(const std::string& spec, const SimulatedHost& host) {
+    try {
+        m_model->addHosts(internal::TargetSpec::parse(spec), host);
+    } catch (const internal::IpRangeException& e) {
+        throw std::runtime_error(std::string("IP range error: ") + e.what());
+    }
+}
+
+uint64_t SimulatedNetwork::seed() const {
+    return m_model->seed();
+}
+
+SimulationStats SimulatedNetwork::stats() const {
+    return m_model->stats();
+}
+
+} // namespace netlens
@@ -0,0 +1,267 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "SimulatedTransport.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+
+namespace netlens::internal {
+
+/// <summary>
+/// Pending wait of a SimulatedTimer. The handler and armed generation are
+/// only touched on the transport's thread; cancel bumps the generation
+/// from anywhere, which leaves the queued event stale.
+/// </summary>
+struct SimulatedTransport::TimerState {
+    std::atomic<uint64_t> generation{0};
+    uint64_t armed = 0;
+    std::function<void()> handler;
+};
+
+class SimulatedTransport::SimulatedTimer : public Transport::Timer {
+public:
+    explicit SimulatedTimer(SimulatedTransport& transport)
+        : m_transport(transport)
+        , m_state(std::make_shared<TimerState>()) {}
+
+    void wait(Clock::duration delay, std::function<void()> handler) override {
+        m_state->armed = ++m_state->generation;
+        m_state->handler = std::move(handler);
+        m_transport.push({ m_transport.m_now + delay, 0, EventKind::Timer, 0, m_state->armed, m_state });
+    }
+
+    void cancel() override { ++m_state->generation; }
+
+private:
+    SimulatedTransport& m_transport;
+    std::shared_ptr<TimerState> m_state;
+};
+
+SimulatedTransport::SimulatedTransport(asio::io_context& io, const SimulatedNetwork& network)
+    : m_io(io)
+    , m_model(network.m_model)
+    , m_now()
+    , m_sequence(0)
+    , m_step_posted(false) {}
+
+std::unique_ptr<Transport::Timer> SimulatedTransport::makeTimer() {
+    return std::make_unique<SimulatedTimer>(*this);
+}
+
+size_t SimulatedTransport::freeSlots() const {
+    return std::numeric_limits<size_t>::max();
+}
+
+void SimulatedTransport::reserveSlots(size_t slots) {
+    while (m_free.size() < slots) {
+        m_free.push_back(static_cast<uint32_t>(m_slots.size()));
+        m_slots.emplace_back();
+    }
+    m_free.reserve(m_slots.size());
+}
+
+uint32_t SimulatedTransport::connect(Handler& handler, uint32_t address, uint16_t port,
+                                     uint32_t timeout_ms) {
+    uint32_t index;
+    if (m_free.empty()) {
+        index = static_cast<uint32_t>(m_slots.size());
+        m_slots.emplace_back();
+    } else {
+        index = m_free.back();
+        m_free.pop_back();
+    }
+    Slot& slot = m_slots[index];
+    slot.handler = &handler;
+    slot.rule = m_model->find(address);
+    slot.address = address;
+    slot.port = port;
+    slot.banner = nullptr;
+    m_model->connects.fetch_add(1, std::memory_order_relaxed);
+
+    const Clock::duration timeout = std::chrono::milliseconds(timeout_ms);
+    const NetworkModel::Rule* rule = slot.rule;
+    if (!rule) {
+        m_model->dropped.fetch_add(1, std::memory_order_relaxed);
+        finish(index, EventKind::Connect, timeout, asio::error::timed_out);
+        return index;
+    }
+    if (!admit(*rule)) {
+        m_model->rate_limited.fetch_add(1, std::memory_order_relaxed);
+        finish(index, EventKind::Connect, timeout, asio::error::timed_out);
+        return index;
+    }
+    if (m_model->uniform(address, port, NetworkModel::Draw::Loss) <= rule->host.loss) {
+        m_model->lost.fetch_add(1, std::memory_order_relaxed);
+        finish(index, EventKind::Connect, timeout, asio::error::timed_out);
+        return index;
+    }
+
+    const PortState state = rule->host.tarpit ? PortState::Open : NetworkModel::portState(*rule, port);
+    if (state == PortState::Filtered) {
+        m_model->dropped.fetch_add(1, std::memory_order_relaxed);
+        finish(index, EventKind::Connect, timeout, asio::error::timed_out);
+        return index;
+    }
+
+    const bool open = state == PortState::Open;
+    (open ? m_model->accepted : m_model->refused).fetch_add(1, std::memory_order_relaxed);
+    const Clock::duration rtt = m_model->latency(*rule, address, port, NetworkModel::Draw::ConnectLatency);
+    if (rtt >= timeout) {
+        finish(index, EventKind::Connect, timeout, asio::error::timed_out);
+    } else {
+        finish(index, EventKind::Connect, rtt,
+               open ? asio::error_code() : asio::error_code(asio::error::connection_refused));
+    }
+    return index;
+}
+
+void SimulatedTransport::exchange(uint32_t index, std::string_view request, char* buffer, size_t size,
+                                  uint32_t timeout_ms) {
+    Slot& slot = m_slots[index];
+    slot.buffer = buffer;
+    slot.size = size;
+
+    const Clock::duration timeout = std::chrono::milliseconds(timeout_ms);
+    const SimulatedHost& host = slot.rule->host;
+    auto banner = host.banners.find(slot.port);
+    if (host.tarpit || banner == host.banners.end()) {
+        finish(index, EventKind::Receive, timeout, asio::error::timed_out);
+        return;
+    }
+
+    // A banner the server sends first is already on its way when the connect completes
+    Clock::duration delay = m_model->latency(*slot.rule, slot.address, slot.port, NetworkModel::Draw::ReceiveLatency);
+    if (request.empty()) {
+        delay /= 2;
+    }
+    if (delay >= timeout) {
+        finish(index, EventKind::Receive, timeout, asio::error::timed_out);
+        return;
+    }
+    slot.banner = &banner->second;
+    m_model->banners.fetch_add(1, std::memory_order_relaxed);
+    finish(index, EventKind::Receive, delay, {});
+}
+
+void SimulatedTransport::cancel(uint32_t index) {
+    Slot& slot = m_slots[index];
+    if (!slot.busy) {
+        return;
+    }
+    ++slot.generation;
+    slot.banner = nullptr;
+    finish(index, slot.operation, Clock::duration::zero(), asio::error::operation_aborted);
+}
+
+void SimulatedTransport::close(uint32_t index) {
+    Slot& slot = m_slots[index];
+    ++slot.generation;
+    slot.busy = false;
+    slot.handler = nullptr;
+    slot.rule = nullptr;
+    m_free.push_back(index);
+}
+
+bool SimulatedTransport::admit(const NetworkModel::Rule& rule) {
+    const SimulatedHost& host = rule.host;
+    if (host.firewall_rate <= 0.0) {
+        return true;
+    }
+    const double burst = std::max(1.0, host.firewall_burst);
+    auto [it, created] = m_firewalls.try_emplace(rule.index);
+    Firewall& firewall = it->second;
+    if (created) {
+        firewall.tokens = burst;
+    } else {
+        const double elapsed_s = std::chrono::duration<double>(m_now - firewall.last).count();
+        firewall.tokens = std::min(burst, firewall.tokens + elapsed_s * host.firewall_rate);
+    }
+    firewall.last = m_now;
+    if (firewall.tokens < 1.0) {
+        return false;
+    }
+    firewall.tokens -= 1.0;
+    return true;
+}
+
+void SimulatedTransport::finish(uint32_t index, EventKind operation, Clock::duration delay, asio::error_code result) {
+    Slot& slot = m_slots[index];
+    slot.busy = true;
+    slot.operation = operation;
+    slot.result = result;
+    push({ m_now + delay, 0, operation, index, slot.generation, nullptr });
+}
+
+void SimulatedTransport::push(Event event) {
+    event.sequence = m_sequence++;
+    m_events.push(std::move(event));
+    if (!m_step_posted) {
+        m_step_posted = true;
+        asio::post(m_io, [this]() { step(); });
+    }
+}
+
+void SimulatedTransport::advanceTo(Clock::time_point time) {
+    if (time > m_now) {
+        m_model->virtual_ns.fetch_add(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(time - m_now).count(), std::memory_order_relaxed);
+        m_now = time;
+    }
+}
+
+void SimulatedTransport::step() {
+    m_step_posted = false;
+    while (!m_events.empty()) {
+        Event event = m_events.top();
+        m_events.pop();
+
+        if (event.kind == EventKind::Timer) {
+            TimerState& timer = *event.timer;
+            if (event.generation != timer.armed) {
+                continue;   // Superseded by a later wait
+            }
+            // Fired or cancelled, the wait is over and drops its handler
+            std::function<void()> handler = std::move(timer.handler);
+            timer.handler = nullptr;
+            if (event.generation != timer.generation) {
+                continue;
+            }
+            advanceTo(event.time);
+            handler();
+            break;
+        }
+
+        Slot& slot = m_slots[event.slot];
+        if (event.generation != slot.generation || !slot.busy) {
+            continue;
+        }
+        advanceTo(event.time);
+
+        // The handler may close the slot, or open others and move it
+        slot.busy = false;
+        Handler* handler = slot.handler;
+        const asio::error_code result = slot.result;
+        if (event.kind == EventKind::Connect) {
+            handler->onConnect(result);
+        } else {
+            size_t bytes = 0;
+            if (!result && slot.banner) {
+                bytes = std::min(slot.size, slot.banner->size());
+                std::memcpy(slot.buffer, slot.banner->data(), bytes);
+            }
+            handler->onReceive(result, bytes);
+        }
+        break;
+    }
+
+    if (!m_events.empty() && !m_step_posted) {
+        m_step_posted = true;
+        asio::post(m_io, [this]() { step(); });
+    }
+}
+
+} // namespace netlens::internal
@@ -0,0 +1,106 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#pragma once
+
+#include <netlens/SimulatedNetwork.h>
+#include "NetworkModel.h"
+#include "Transport.h"
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+namespace netlens::internal {
+
+/// <summary>
+/// Transport into a SimulatedNetwork, on a virtual clock. Every answer and
+/// deadline is an event queued at its virtual time; events are run one per
+/// io_context handler, in time order (ties in the order they were queued),
+/// and the clock jumps to each event as it runs. Everything else the
+/// io_context has to do runs in between, at the current virtual time, so
+/// the engine sees the same sequence of events whatever the wall clock
+/// does. Only the io_context's thread may use the transport; timers may be
+/// cancelled from other threads.
+/// </summary>
+class SimulatedTransport : public Transport {
+public:
+    SimulatedTransport(asio::io_context& io, const SimulatedNetwork& network);
+
+    Clock::time_point now() const override { return m_now; }
+    std::unique_ptr<Timer> makeTimer() override;
+    size_t freeSlots() const override;
+    void reserveSlots(size_t slots) override;
+
+    uint32_t connect(Handler& handler, uint32_t address, uint16_t port,
+                     uint32_t timeout_ms) override;
+    void exchange(uint32_t slot, std::string_view request, char* buffer, size_t size,
+                  uint32_t timeout_ms) override;
+    void cancel(uint32_t slot) override;
+    void close(uint32_t slot) override;
+
+private:
+    class SimulatedTimer;
+    struct TimerState;
+
+    enum class EventKind : uint8_t {
+        Connect,
+        Receive,
+        Timer
+    };
+
+    struct Event {
+        Clock::time_point time;
+        uint64_t sequence;
+        EventKind kind;
+        uint32_t slot;
+        uint64_t generation;
+        std::shared_ptr<TimerState> timer;
+
+        // Orders the priority queue earliest first
+        bool operator<(const Event& other) const {
+            return time != other.time ? time > other.time : sequence > other.sequence;
+        }
+    };
+
+    struct Slot {
+        Handler* handler = nullptr;
+        const NetworkModel::Rule* rule = nullptr;
+        uint32_t address = 0;
+        uint16_t port = 0;
+        uint64_t generation = 0;    // Bumped whenever queued events become stale
+        bool busy = false;          // A connect or read is in progress
+        EventKind operation = EventKind::Connect;
+        asio::error_code result;
+        const std::string* banner = nullptr;
+        char* buffer = nullptr;
+        size_t size = 0;
+    };
+
+    /// <summary>
+    /// Token bucket of a range's firewall, on the virtual clock.
+    /// </summary>
+    struct Firewall {
+        double tokens = 0.0;
+        Clock::time_point last;
+    };
+
+    bool admit(const NetworkModel::Rule& rule);
+    void finish(uint32_t slot, EventKind operation, Clock::duration delay, asio::error_code result);
+    void push(Event event);
+    void advanceTo(Clock::time_point time);
+    void step();
+
+    asio::io_context& m_io;
+    std::shared_ptr<NetworkModel> m_model;
+    Clock::time_point m_now;
+    uint64_t m_sequence;
+    bool m_step_posted;
+    std::priority_queue<Event> m_events;
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_free;
+    std::unordered_map<size_t, Firewall> m_firewalls;
+};
+
+} // namespace netlens::internal
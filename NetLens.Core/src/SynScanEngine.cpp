@@ -0,0 +1,678 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#ifdef __linux__
+
+#include "SynScanEngine.h"
+#include "TargetSpec.h"
+#include "IpRange.h"
+#include "Permutation.h"
+#include "RateLimiter.h"
+#include "ControlSubscription.h"
+#include "ProgressReporter.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace netlens::internal {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr uint32_t MIN_TIMEOUT_MS = 50;
+constexpr uint32_t MAX_TIMEOUT_MS = 30000;
+constexpr size_t DEFAULT_MAX_IN_FLIGHT = 500;
+constexpr size_t DEFAULT_RESULT_BUFFER_HOSTS = 256;
+constexpr int RECEIVE_BUFFER_BYTES = 8 * 1024 * 1024;
+constexpr int RECEIVE_POLL_MS = 20;
+constexpr int SEND_RETRY_MS = 1;
+
+constexpr uint8_t TCP_FIN = 0x01;
+constexpr uint8_t TCP_SYN = 0x02;
+constexpr uint8_t TCP_RST = 0x04;
+constexpr uint8_t TCP_ACK = 0x10;
+
+/// <summary>
+/// Owns a file descriptor.
+/// </summary>
+class FileDescriptor {
+public:
+    explicit FileDescriptor(int fd = -1) : m_fd(fd) {}
+    ~FileDescriptor() { if (m_fd >= 0) ::close(m_fd); }
+
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+    int get() const { return m_fd; }
+
+private:
+    int m_fd;
+};
+
+uint64_t mix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+}
+
+/// <summary>
+/// Keyed hash of the connection tuple used as the SYN sequence number.
+/// A reply acknowledging cookie + 1 can only come from the probed tuple.
+/// </summary>
+class SynCookie {
+public:
+    SynCookie() {
+        std::random_device rd;
+        m_key0 = (static_cast<uint64_t>(rd()) << 32) | rd();
+        m_key1 = (static_cast<uint64_t>(rd()) << 32) | rd();
+    }
+
+    uint32_t operator()(uint32_t src, uint32_t dst, uint16_t src_port, uint16_t dst_port) const {
+        uint64_t x = mix64(((static_cast<uint64_t>(src) << 32) | dst) ^ m_key0);
+        x = mix64(x ^ ((static_cast<uint64_t>(src_port) << 16) | dst_port) ^ m_key1);
+        return static_cast<uint32_t>(x ^ (x >> 32));
+    }
+
+private:
+    uint64_t m_key0;
+    uint64_t m_key1;
+};
+
+uint16_t load16(const uint8_t* p) { return static_cast<uint16_t>((p[0] << 8) | p[1]); }
+
+uint32_t load32(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | p[3];
+}
+
+void store16(uint8_t* p, uint16_t v) { p[0] = static_cast<uint8_t>(v >> 8); p[1] = static_cast<uint8_t>(v); }
+
+void store32(uint8_t* p, uint32_t v) {
+    p[0] = static_cast<uint8_t>(v >> 24); p[1] = static_cast<uint8_t>(v >> 16);
+    p[2] = static_cast<uint8_t>(v >> 8);  p[3] = static_cast<uint8_t>(v);
+}
+
+/// <summary>
+/// TCP SYN segment (header plus MSS option). The kernel adds the IP header.
+/// </summary>
+struct SynSegment {
+    static constexpr size_t SIZE = 24;
+    uint8_t bytes[SIZE];
+
+    void build(uint32_t src, uint32_t dst, uint16_t src_port, uint16_t dst_port, uint32_t seq) {
+        std::memset(bytes, 0, SIZE);
+        store16(bytes + 0, src_port);
+        store16(bytes + 2, dst_port);
+        store32(bytes + 4, seq);
+        bytes[12] = static_cast<uint8_t>((SIZE / 4) << 4);
+        bytes[13] = TCP_SYN;
+        store16(bytes + 14, 64240);
+        bytes[20] = 2;      // MSS option
+        bytes[21] = 4;
+        store16(bytes + 22, 1460);
+
+        // Checksum over the pseudo-header and the segment
+        uint32_t sum = (src >> 16) + (src & 0xFFFF) + (dst >> 16) + (dst & 0xFFFF) +
+                       IPPROTO_TCP + static_cast<uint32_t>(SIZE);
+        for (size_t i = 0; i < SIZE; i += 2) {
+            sum += load16(bytes + i);
+        }
+        while (sum >> 16) {
+            sum = (sum & 0xFFFF) + (sum >> 16);
+        }
+        store16(bytes + 16, static_cast<uint16_t>(~sum));
+    }
+};
+
+/// <summary>
+/// Replies collected by the receive loop for one host: whether each port
+/// that answered is open. Retransmitted replies find their port already
+/// there and are dropped.
+/// </summary>
+struct HostReplies {
+    size_t outstanding = 0;
+    size_t open = 0;
+    std::unordered_map<uint16_t, bool> answers;
+};
+
+/// <summary>
+/// Replies keyed by target address, plus the window of unanswered SYNs.
+/// A SYN holds a window slot until its reply arrives or its host is taken
+/// after the reply deadline, so the send rate follows the reply rate.
+/// Replies for hosts that are not being probed, including late ones for
+/// hosts already taken, are dropped.
+/// </summary>
+class ReplyTable {
+public:
+    /// <summary>
+    /// Registers a host before its SYNs go out.
+    /// </summary>
+    void open(uint32_t address) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_replies.try_emplace(address);
+    }
+
+    /// <summary>
+    /// Counts one SYN sent to a registered host.
+    /// </summary>
+    void sent(uint32_t address) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_replies[address].outstanding;
+        ++m_outstanding;
+    }
+
+    /// <summary>
+    /// Releases the slots of a host's unanswered SYNs while keeping it
+    /// registered, for a host with more ports than the window whose
+    /// earlier SYNs have already waited out the timeout.
+    /// </summary>
+    void expire(uint32_t address) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_replies.find(address);
+        if (it != m_replies.end()) {
+            m_outstanding -= it->second.outstanding;
+            it->second.outstanding = 0;
+        }
+    }
+
+    void record(uint32_t address, uint16_t port, bool open) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_replies.find(address);
+            if (it == m_replies.end()) {
+                return;
+            }
+            HostReplies& host = it->second;
+            if (!host.answers.try_emplace(port, open).second) {
+                return;
+            }
+            host.open += open ? 1 : 0;
+            if (host.outstanding == 0) {
+                return;     // Its slot was already released by expire
+            }
+            --host.outstanding;
+            --m_outstanding;
+        }
+        m_slot_freed.notify_one();
+    }
+
+    /// <summary>
+    /// Removes a host, releasing the slots of its unanswered SYNs.
+    /// </summary>
+    HostReplies take(uint32_t address) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_replies.find(address);
+        if (it == m_replies.end()) {
+            return {};
+        }
+        HostReplies replies = std::move(it->second);
+        m_replies.erase(it);
+        m_outstanding -= replies.outstanding;
+        return replies;
+    }
+
+    /// <summary>
+    /// Waits until fewer than window SYNs are unanswered, the deadline
+    /// passes or the table is stopped. Returns true if a slot is free.
+    /// </summary>
+    bool waitForSlot(size_t window, Clock::time_point deadline) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_slot_freed.wait_until(lock, deadline, [this, window]() {
+            return m_stopped || m_outstanding < window;
+        }) && !m_stopped;
+    }
+
+    /// <summary>
+    /// Wakes a sender waiting for a slot, for good.
+    /// </summary>
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopped = true;
+        }
+        m_slot_freed.notify_all();
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_slot_freed;
+    std::unordered_map<uint32_t, HostReplies> m_replies;
+    size_t m_outstanding = 0;
+    bool m_stopped = false;
+};
+
+/// <summary>
+/// Pause and cancel state of the sender, fed by a ScanControl. A cancel
+/// cuts any wait of the sender short.
+/// </summary>
+class SenderGate {
+public:
+    bool cancelled() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_cancelled;
+    }
+
+    bool paused() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_paused && !m_cancelled;
+    }
+
+    void setPaused(bool paused) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_paused = paused;
+        }
+        m_changed.notify_all();
+    }
+
+    void cancel() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_cancelled = true;
+        }
+        m_changed.notify_all();
+    }
+
+    /// <summary>
+    /// Sleeps until the deadline or a cancel.
+    /// </summary>
+    void sleepUntil(Clock::time_point deadline) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_changed.wait_until(lock, deadline, [this]() { return m_cancelled; });
+    }
+
+    /// <summary>
+    /// Sleeps while paused, until the deadline at the latest.
+    /// </summary>
+    void waitWhilePaused(Clock::time_point deadline) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_changed.wait_until(lock, deadline, [this]() { return m_cancelled || !m_paused; });
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    bool m_paused = false;
+    bool m_cancelled = false;
+};
+
+/// <summary>
+/// Matches inbound TCP segments against the cookie until stopped.
+/// </summary>
+void receiveLoop(int fd, const SynCookie& cookie, uint16_t src_port,
+                 const std::atomic<bool>& stop, ReplyTable& replies) {
+    uint8_t packet[65536];
+    pollfd pfd{ fd, POLLIN, 0 };
+
+    while (!stop.load(std::memory_order_relaxed)) {
+        if (::poll(&pfd, 1, RECEIVE_POLL_MS) <= 0) {
+            continue;
+        }
+
+        for (;;) {
+            const ssize_t received = ::recv(fd, packet, sizeof(packet), MSG_DONTWAIT);
+            if (received <= 0) {
+                break;
+            }
+
+            // IPv4 header, then TCP header
+            const size_t length = static_cast<size_t>(received);
+            if (length < 20 || (packet[0] >> 4) != 4 || packet[9] != IPPROTO_TCP) {
+                continue;
+            }
+            const size_t ip_header = static_cast<size_t>(packet[0] & 0x0F) * 4;
+            if (ip_header < 20 || length < ip_header + 20) {
+                continue;
+            }
+            const uint8_t* tcp = packet + ip_header;
+            if (load16(tcp + 2) != src_port) {
+                continue;
+            }
+
+            const uint32_t target = load32(packet + 12);
+            const uint32_t local = load32(packet + 16);
+            const uint16_t target_port = load16(tcp);
+            const uint32_t ack = load32(tcp + 8);
+            const uint8_t flags = tcp[13];
+
+            if (!(flags & TCP_ACK) || ack != cookie(local, target, src_port, target_port) + 1) {
+                continue;
+            }
+
+            if ((flags & (TCP_SYN | TCP_FIN | TCP_RST)) == TCP_SYN) {
+                replies.record(target, target_port, true);
+            } else if (flags & TCP_RST) {
+                replies.record(target, target_port, false);
+            }
+        }
+    }
+}
+
+/// <summary>
+/// Resolves the local address the kernel routes a destination through, by
+/// connecting a UDP socket (which sends nothing) and reading its name.
+/// </summary>
+class SourceResolver {
+public:
+    SourceResolver() : m_fd(::socket(AF_INET, SOCK_DGRAM, 0)) {}
+
+    uint32_t sourceFor(uint32_t destination) {
+        // Routes rarely differ inside a /24
+        if (m_valid && (destination >> 8) == (m_last_destination >> 8)) {
+            return m_last_source;
+        }
+
+        sockaddr_in dst{};
+        dst.sin_family = AF_INET;
+        dst.sin_port = htons(9);
+        dst.sin_addr.s_addr = htonl(destination);
+        sockaddr_in local{};
+        socklen_t local_len = sizeof(local);
+        if (m_fd.get() < 0 ||
+            ::connect(m_fd.get(), reinterpret_cast<sockaddr*>(&dst), sizeof(dst)) != 0 ||
+            ::getsockname(m_fd.get(), reinterpret_cast<sockaddr*>(&local), &local_len) != 0) {
+            m_valid = false;
+            return 0;
+        }
+
+        m_valid = true;
+        m_last_destination = destination;
+        m_last_source = ntohl(local.sin_addr.s_addr);
+        return m_last_source;
+    }
+
+private:
+    FileDescriptor m_fd;
+    bool m_valid = false;
+    uint32_t m_last_destination = 0;
+    uint32_t m_last_source = 0;
+};
+
+/// <summary>
+/// A host whose SYNs have all been sent, waiting for late replies.
+/// </summary>
+struct PendingHost {
+    uint32_t address;
+    Clock::time_point deadline;
+};
+
+} // namespace
+
+ScanSummary SynScanEngine::executeScan(const ScanSettings& settings, const HostSink& sink,
+                                       ProgressCallback progressCallback, ScanControl* control) {
+    IntervalSet targets;
+    try {
+        targets = TargetSpec::resolve(settings);
+    } catch (const IpRangeException& e) {
+        throw std::runtime_error(std::string("IP range error: ") + e.what());
+    }
+
+    ScanSummary summary;
+    summary.total_hosts = static_cast<size_t>(targets.size());
+    // A port listed twice is probed once, so replies and filtered counts
+    // are per distinct port; the first listing keeps its place in the order
+    std::vector<uint16_t> ports;
+    ports.reserve(settings.ports.size());
+    std::vector<bool> listed(65536, false);
+    for (uint16_t port : settings.ports) {
+        if (!listed[port]) {
+            listed[port] = true;
+            ports.push_back(port);
+        }
+    }
+    const size_t port_count = ports.size();
+    if (targets.empty() || port_count == 0) {
+        return summary;
+    }
+
+    FileDescriptor raw(::socket(AF_INET, SOCK_RAW, IPPROTO_TCP));
+    if (raw.get() < 0) {
+        throw std::runtime_error(std::string("SYN scan requires a raw socket (CAP_NET_RAW): ") +
+                                 std::strerror(errno));
+    }
+    int rcvbuf = RECEIVE_BUFFER_BYTES;
+    ::setsockopt(raw.get(), SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+
+    const uint32_t timeout_ms = std::clamp(settings.timeout_ms, MIN_TIMEOUT_MS, MAX_TIMEOUT_MS);
+    size_t window = settings.max_concurrency == 0 ? DEFAULT_MAX_IN_FLIGHT : settings.max_concurrency;
+    size_t max_buffered = settings.max_buffered_hosts;
+    if (max_buffered == 0) {
+        max_buffered = window + DEFAULT_RESULT_BUFFER_HOSTS;
+    }
+
+    SynCookie cookie;
+    std::random_device rd;
+    const uint16_t src_port = static_cast<uint16_t>(40000 + rd() % 20000);
+
+    ReplyTable replies;
+    std::atomic<bool> stop_receiver{false};
+    std::thread receiver(receiveLoop, raw.get(), std::cref(cookie), src_port,
+                         std::cref(stop_receiver), std::ref(replies));
+
+    SenderGate gate;
+    ControlSubscription subscription(control,
+        [&gate](bool paused) { gate.setPaused(paused); },
+        [&gate, &replies]() {
+            gate.cancel();
+            replies.stop();
+        });
+
+    RateLimiter limiter(settings.max_rate, settings.max_subnet_rate, settings.rate_subnet_prefix);
+    RateMeter sent_rate;
+
+    // The sender publishes what the progress snapshots need besides counts
+    ProgressCounters counters;
+    std::atomic<uint32_t> last_emitted{0};
+    std::atomic<bool> any_emitted{false};
+    std::atomic<double> probe_rate{0.0};
+    ProgressReporter reporter(progressCallback, std::chrono::milliseconds(settings.progress_interval_ms),
+                              counters, summary.total_hosts, summary.total_hosts * port_count,
+                              [&](ScanProgress& progress) {
+                                  progress.window = window;
+                                  progress.probe_rate = probe_rate.load(std::memory_order_relaxed);
+                                  if (any_emitted.load(std::memory_order_acquire)) {
+                                      progress.current_ip = IpRange::toString(last_emitted.load(std::memory_order_relaxed));
+                                  }
+                              });
+
+    std::deque<PendingHost> pending;
+    std::exception_ptr sink_error;
+
+    auto emit = [&](const PendingHost& host) {
+        HostReplies reply = replies.take(host.address);
+
+        // A host that only reset its ports still answered
+        HostResult result(IpRange::toString(host.address), !reply.answers.empty());
+        if (reply.open == 0 && result.is_alive) {
+            result.liveness = Liveness::TcpReply;
+        }
+        if (reply.open > 0) {
+            result.ports.reserve(reply.open);
+            for (uint16_t port : ports) {
+                auto it = reply.answers.find(port);
+                if (it != reply.answers.end() && it->second) {
+                    result.ports.emplace_back(port, true);
+                }
+            }
+        }
+        const size_t answered = reply.answers.size();
+        result.closed_ports = static_cast<uint32_t>(answered - reply.open);
+        result.filtered_ports = static_cast<uint32_t>(port_count > answered ? port_count - answered : 0);
+
+        summary.alive_hosts += result.is_alive ? 1 : 0;
+        summary.open_ports += result.ports.size();
+
+        sink(host.address, std::move(result));
+        last_emitted.store(host.address, std::memory_order_relaxed);
+        any_emitted.store(true, std::memory_order_release);
+        probe_rate.store(sent_rate.rate(Clock::now()), std::memory_order_relaxed);
+        counters.addHosts(0, 1);
+        counters.addPorts(0, port_count);
+    };
+
+    // Emits every host whose reply deadline has passed; with wait set, first
+    // sleeps until the oldest pending host is due
+    auto emitDue = [&](bool wait) {
+        if (wait && !pending.empty()) {
+            gate.sleepUntil(pending.front().deadline);
+        }
+        if (gate.cancelled()) {
+            return;     // Hosts still waiting for replies are dropped
+        }
+        const auto now = Clock::now();
+        while (!pending.empty() && pending.front().deadline <= now) {
+            PendingHost host = pending.front();
+            pending.pop_front();
+            emit(host);
+        }
+    };
+
+    // Random order permutes the hosts and each host's ports; the sender is
+    // host by host, so only the host order spreads load across subnets
+    const bool random_order = settings.probe_order == ProbeOrder::Random;
+    uint64_t seed = settings.random_seed;
+    if (random_order && seed == 0) {
+        seed = (static_cast<uint64_t>(rd()) << 32) | rd();
+    }
+    const Permutation host_order = random_order ? Permutation(targets.size(), seed) : Permutation();
+
+    try {
+        SourceResolver resolver;
+        SynSegment segment;
+        auto next_address = targets.begin();
+
+        for (uint64_t host_index = 0; host_index < targets.size() && !gate.cancelled(); ++host_index) {
+            const uint32_t address = random_order ? targets.at(host_order(host_index)) : *next_address++;
+            const Permutation port_order = random_order
+                ? Permutation(port_count, seed ^ Permutation::mix(address))
+                : Permutation();
+
+            while (pending.size() >= max_buffered && !gate.cancelled()) {
+                emitDue(true);
+            }
+
+            const uint32_t source = resolver.sourceFor(address);
+            sockaddr_in dst{};
+            dst.sin_family = AF_INET;
+            dst.sin_addr.s_addr = htonl(address);
+            replies.open(address);
+            bool unreachable = false;
+
+            for (size_t port_index = 0; port_index < port_count && !gate.cancelled(); ++port_index) {
+                const uint16_t port = ports[random_order ? port_order(port_index) : port_index];
+                if (source == 0 || unreachable) {
+                    continue;   // No route; the port is reported as filtered
+                }
+
+                // While paused nothing is sent; due hosts are still emitted
+                while (gate.paused()) {
+                    gate.waitWhilePaused(pending.empty()
+                                             ? Clock::now() + std::chrono::milliseconds(RECEIVE_POLL_MS)
+                                             : pending.front().deadline);
+                    emitDue(false);
+                }
+
+                // Expired hosts release the slots of their unanswered SYNs;
+                // with none pending, the window is held by this host alone
+                while (!gate.cancelled() &&
+                       !replies.waitForSlot(window, pending.empty()
+                                                ? Clock::now() + std::chrono::milliseconds(timeout_ms)
+                                                : pending.front().deadline)) {
+                    if (pending.empty()) {
+                        replies.expire(address);
+                    }
+                    emitDue(false);
+                }
+
+                // Rate ceilings hold the sender; due hosts are still emitted
+                if (limiter.enabled()) {
+                    for (;;) {
+                        const auto wait = limiter.acquire(address, Clock::now());
+                        if (wait <= Clock::duration::zero()) {
+                            break;
+                        }
+                        gate.sleepUntil(Clock::now() + wait);
+                        emitDue(false);
+                    }
+                }
+                if (gate.cancelled()) {
+                    break;
+                }
+                sent_rate.add(Clock::now());
+
+                // A SYN counts as sent, and holds a window slot, only once the
+                // kernel has taken it. A full send buffer is waited out; no
+                // route to the host leaves its ports filtered; anything else
+                // fails the scan rather than passing for a silent port
+                segment.build(source, address, src_port, port, cookie(source, address, src_port, port));
+                int error = 0;
+                while (::sendto(raw.get(), segment.bytes, SynSegment::SIZE, 0,
+                                reinterpret_cast<const sockaddr*>(&dst), sizeof(dst)) < 0) {
+                    error = errno;
+                    if ((error != ENOBUFS && error != EAGAIN && error != EINTR) || gate.cancelled()) {
+                        break;
+                    }
+                    error = 0;
+                    gate.sleepUntil(Clock::now() + std::chrono::milliseconds(SEND_RETRY_MS));
+                }
+                if (error == 0 && !gate.cancelled()) {
+                    replies.sent(address);
+                } else if (error == EHOSTUNREACH || error == ENETUNREACH || error == EHOSTDOWN) {
+                    unreachable = true;
+                } else if (error != 0) {
+                    throw std::runtime_error("SYN probe to " + IpRange::toString(address) + ':' +
+                                             std::to_string(port) + " could not be sent: " + std::strerror(error));
+                }
+            }
+
+            if (gate.cancelled()) {
+                break;
+            }
+            pending.push_back({ address, Clock::now() + std::chrono::milliseconds(timeout_ms) });
+            emitDue(false);
+        }
+
+        while (!pending.empty() && !gate.cancelled()) {
+            emitDue(true);
+        }
+    } catch (...) {
+        sink_error = std::current_exception();
+    }
+
+    subscription.reset();
+    summary.cancelled = gate.cancelled();
+    stop_receiver.store(true);
+    receiver.join();
+    reporter.stop();
+
+    if (sink_error) {
+        std::rethrow_exception(sink_error);
+    }
+
+    return summary;
+}
+
+} // namespace netlens::internal
+
+#endif // __linux__
@@ -0,0 +1,52 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#pragma once
+
+#ifdef __linux__
+
+#include "ScanEngine.h"
+
+namespace netlens::internal {
+
+/// <summary>
+/// Stateless half-open SYN scanner for Linux.
+/// A raw-socket sender emits one SYN per (host, port) while a separate
+/// receive loop matches SYN-ACK and RST replies. The initial sequence number
+/// is a keyed hash of the connection tuple, so a reply is validated from the
+/// acknowledgment number alone and no per-probe state is kept. The kernel,
+/// holding no socket for the source port, answers SYN-ACKs with RST, which
+/// tears the half-open connection down.
+/// </summary>
+class SynScanEngine : public ScanEngine {
+public:
+    SynScanEngine() = default;
+    ~SynScanEngine() override = default;
+
+    SynScanEngine(const SynScanEngine&) = delete;
+    SynScanEngine& operator=(const SynScanEngine&) = delete;
+
+    using ScanEngine::executeScan;
+
+    /// <summary>
+    /// Executes a SYN scan. At most max_concurrency SYNs are unanswered at
+    /// once: each reply frees a slot and unanswered SYNs free theirs when
+    /// their host is emitted, so the send rate tracks the reply rate. A host
+    /// is emitted once its last SYN is sent and timeout_ms has elapsed;
+    /// ports that neither answered SYN-ACK (open) nor RST (closed) are
+    /// counted as filtered, as are all ports of a host the kernel has no
+    /// route to. A port listed more than once is probed once. While paused
+    /// no SYNs are sent; a cancel stops the sender and drops the hosts
+    /// still waiting for replies.
+    /// </summary>
+    /// <exception cref="std::runtime_error">Thrown if the raw socket cannot be opened (e.g. missing CAP_NET_RAW)
+    /// or a SYN cannot be sent for another reason than a full buffer or a missing route</exception>
+    ScanSummary executeScan(const ScanSettings& settings, const HostSink& sink,
+                            ProgressCallback progressCallback, ScanControl* control) override;
+};
+
+} // namespace netlens::internal
+
+#endif // __linux__
@@ -0,0 +1,77 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "TargetBlocks.h"
+#include <algorithm>
+
+namespace netlens::internal {
+
+TargetBlocks::TargetBlocks(uint64_t count, size_t owners, uint64_t block_size)
+    : m_shares(std::make_unique<Share[]>(std::max<size_t>(owners, 1)))
+    , m_owners(std::max<size_t>(owners, 1))
+    , m_block_size(std::max<uint64_t>(block_size, 1))
+    , m_remaining(count) {
+    for (size_t i = 0; i < m_owners; ++i) {
+        m_shares[i].begin = count * i / m_owners;
+        m_shares[i].end = count * (i + 1) / m_owners;
+    }
+}
+
+bool TargetBlocks::take(size_t owner, uint64_t& first, uint64_t& last) {
+    Share& own = m_shares[owner % m_owners];
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (own.begin < own.end) {
+                first = own.begin;
+                last = std::min(own.end, first + m_block_size);
+                own.begin = last;
+                m_remaining.fetch_sub(last - first, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        if (remaining() == 0 || !steal(owner % m_owners)) {
+            return false;
+        }
+    }
+}
+
+bool TargetBlocks::steal(size_t owner) {
+    // Sizes are only a hint for choosing the victim; the move itself is
+    // made under both locks, so no index is ever in transit
+    size_t victim = owner;
+    uint64_t largest = 0;
+    for (size_t i = 0; i < m_owners; ++i) {
+        if (i == owner) {
+            continue;
+        }
+        std::lock_guard<std::mutex> lock(m_shares[i].mutex);
+        const uint64_t size = m_shares[i].end - m_shares[i].begin;
+        if (size > largest) {
+            largest = size;
+            victim = i;
+        }
+    }
+    if (largest == 0) {
+        return false;
+    }
+
+    Share& own = m_shares[owner];
+    Share& from = m_shares[victim];
+    std::scoped_lock lock(own.mutex, from.mutex);
+    const uint64_t size = from.end - from.begin;
+    if (own.begin < own.end || size == 0) {
+        return true;    // Raced with another take; look again
+    }
+
+    // A last block is taken whole; otherwise the back half moves over
+    const uint64_t moved = size <= m_block_size ? size : size / 2;
+    own.begin = from.end - moved;
+    own.end = from.end;
+    from.end -= moved;
+    return true;
+}
+
+} // namespace netlens::internal
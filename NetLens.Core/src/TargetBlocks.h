@@ -0,0 +1,68 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace netlens::internal {
+
+/// <summary>
+/// Hands out the host indices [0, count) of a scan to its shards in blocks.
+/// Each shard starts with an equal contiguous share and takes blocks from
+/// its front. A shard whose share is used up steals the back half of the
+/// largest share left, so shards that drew fast hosts take over work from
+/// those stuck on slow ones. Thread-safe; each share has its own lock.
+/// </summary>
+class TargetBlocks {
+public:
+    /// <summary>
+    /// Size of the cache line a share is padded to.
+    /// </summary>
+    static constexpr size_t CACHE_LINE = 64;
+
+    /// <param name="count">Host indices to hand out</param>
+    /// <param name="owners">Number of shards</param>
+    /// <param name="block_size">Indices handed out per take</param>
+    TargetBlocks(uint64_t count, size_t owners, uint64_t block_size);
+
+    TargetBlocks(const TargetBlocks&) = delete;
+    TargetBlocks& operator=(const TargetBlocks&) = delete;
+
+    /// <summary>
+    /// Takes the next block of an owner's share, stealing from the other
+    /// shares once its own is empty.
+    /// </summary>
+    /// <param name="owner">Shard taking the block</param>
+    /// <param name="first">First index of the block</param>
+    /// <param name="last">One past the last index of the block</param>
+    /// <returns>False once every index has been handed out</returns>
+    bool take(size_t owner, uint64_t& first, uint64_t& last);
+
+    /// <summary>
+    /// Indices not yet handed out. May trail concurrent takes.
+    /// </summary>
+    uint64_t remaining() const { return m_remaining.load(std::memory_order_relaxed); }
+
+private:
+    struct alignas(CACHE_LINE) Share {
+        std::mutex mutex;
+        uint64_t begin = 0;
+        uint64_t end = 0;
+    };
+
+    bool steal(size_t owner);
+
+    std::unique_ptr<Share[]> m_shares;
+    size_t m_owners;
+    uint64_t m_block_size;
+    std::atomic<uint64_t> m_remaining;
+};
+
+} // namespace netlens::internal
@@ -0,0 +1,100 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "TargetSpec.h"
+#include <charconv>
+
+namespace netlens::internal {
+
+namespace {
+
+std::string trim(const std::string& value) {
+    const size_t first = value.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos) {
+        return {};
+    }
+    const size_t last = value.find_last_not_of(" \t\r\n");
+    return value.substr(first, last - first + 1);
+}
+
+unsigned parseNumber(const std::string& text, unsigned max, const std::string& spec) {
+    unsigned value = 0;
+    const char* end = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), end, value);
+    if (text.empty() || ec != std::errc() || ptr != end || value > max) {
+        throw IpRangeException("Invalid target specification: " + spec);
+    }
+    return value;
+}
+
+} // namespace
+
+IpRange TargetSpec::parse(const std::string& raw_spec) {
+    const std::string spec = trim(raw_spec);
+
+    // CIDR block; host bits in the base address are ignored
+    const size_t slash = spec.find('/');
+    if (slash != std::string::npos) {
+        const uint32_t base = IpRange::parse(spec.substr(0, slash));
+        const unsigned prefix = parseNumber(spec.substr(slash + 1), 32, spec);
+        const uint32_t mask = prefix == 0 ? 0 : ~uint32_t(0) << (32 - prefix);
+        return IpRange(base & mask, (base & mask) | ~mask);
+    }
+
+    // Address range; the end may be a full address or just the last octet
+    const size_t dash = spec.find('-');
+    if (dash != std::string::npos) {
+        const uint32_t first = IpRange::parse(trim(spec.substr(0, dash)));
+        const std::string end_text = trim(spec.substr(dash + 1));
+        uint32_t last;
+        if (end_text.find('.') == std::string::npos) {
+            last = (first & 0xFFFFFF00u) | parseNumber(end_text, 255, spec);
+        } else {
+            last = IpRange::parse(end_text);
+        }
+        return IpRange(first, last);
+    }
+
+    const uint32_t address = IpRange::parse(spec);
+    return IpRange(address, address);
+}
+
+IntervalSet TargetSpec::resolve(const ScanSettings& settings) {
+    std::vector<IpRange> include;
+    include.reserve(settings.targets.size() + 1);
+    if (!settings.start_ip.empty() || !settings.end_ip.empty()) {
+        include.push_back(IpRange::fromStrings(settings.start_ip, settings.end_ip));
+    }
+    for (const auto& spec : settings.targets) {
+        include.push_back(parse(spec));
+    }
+
+    std::vector<IpRange> exclude;
+    exclude.reserve(settings.excludes.size());
+    for (const auto& spec : settings.excludes) {
+        exclude.push_back(parse(spec));
+    }
+
+    IntervalSet targets = IntervalSet::fromRanges(std::move(include));
+    if (exclude.empty()) {
+        return targets;
+    }
+    return targets.subtract(IntervalSet::fromRanges(std::move(exclude)));
+}
+
+std::vector<std::string> TargetSpec::format(const IntervalSet& set) {
+    std::vector<std::string> specs;
+    specs.reserve(set.intervals().size());
+    for (const auto& range : set.intervals()) {
+        if (range.first() == range.last()) {
+            specs.push_back(IpRange::toString(range.first()));
+        } else {
+            specs.push_back(IpRange::toString(range.first()) + "-" + IpRange::toString(range.last()));
+        }
+    }
+    return specs;
+}
+
+} // namespace netlens::internal
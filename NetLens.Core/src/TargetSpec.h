@@ -0,0 +1,46 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#pragma once
+
+#include <netlens/ScanSettings.h>
+#include "IntervalSet.h"
+#include "IpRange.h"
+#include <string>
+#include <vector>
+
+namespace netlens::internal {
+
+/// <summary>
+/// Parses target specifications and resolves a scan's targets into a
+/// normalized IntervalSet.
+/// </summary>
+class TargetSpec {
+public:
+    /// <summary>
+    /// Parses a single target specification. Accepted forms:
+    /// a CIDR block ("10.0.0.0/8"), an address range ("10.0.0.1-10.0.0.50"
+    /// or "10.0.0.1-50") and a single address ("10.0.0.1").
+    /// </summary>
+    /// <param name="spec">Target specification</param>
+    /// <returns>The addresses the specification covers</returns>
+    /// <exception cref="IpRangeException">Thrown if the specification is invalid</exception>
+    static IpRange parse(const std::string& spec);
+
+    /// <summary>
+    /// Resolves the targets of a scan: start_ip/end_ip (if set) plus every
+    /// entry of targets, minus every entry of excludes.
+    /// </summary>
+    /// <exception cref="IpRangeException">Thrown if any specification is invalid</exception>
+    static IntervalSet resolve(const ScanSettings& settings);
+
+    /// <summary>
+    /// Formats a set as specifications parse accepts: one single address or
+    /// range ("10.0.0.1-10.0.0.50") per interval.
+    /// </summary>
+    static std::vector<std::string> format(const IntervalSet& set);
+};
+
+} // namespace netlens::internal
@@ -0,0 +1,142 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#pragma once
+
+#include <asio.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string_view>
+
+namespace netlens::internal {
+
+/// <summary>
+/// How the connect engine's TCP probes reach their targets: Asio sockets,
+/// an io_uring or a simulated network. A transport belongs to one shard
+/// and is only used on that shard's thread, except where noted. Each probe
+/// holds a slot from connect until close; the slot's results arrive
+/// through its handler, also on the shard's thread.
+/// </summary>
+class Transport {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// <summary>
+    /// Receives the results of one slot's operations.
+    /// </summary>
+    class Handler {
+    public:
+        virtual ~Handler() = default;
+
+        /// <summary>
+        /// Connect finished. asio::error::timed_out if the deadline passed,
+        /// operation_aborted after cancel().
+        /// </summary>
+        virtual void onConnect(const asio::error_code& ec) = 0;
+
+        /// <summary>
+        /// Banner read finished, with the same errors as onConnect.
+        /// </summary>
+        virtual void onReceive(const asio::error_code& ec, size_t bytes) = 0;
+    };
+
+    /// <summary>
+    /// One-shot timer on the transport's clock.
+    /// </summary>
+    class Timer {
+    public:
+        virtual ~Timer() = default;
+
+        /// <summary>
+        /// Calls the handler once the delay has passed, unless cancelled first.
+        /// </summary>
+        virtual void wait(Clock::duration delay, std::function<void()> handler) = 0;
+
+        /// <summary>
+        /// Drops a pending wait without calling its handler. May be called
+        /// from any thread that serializes its calls with wait.
+        /// </summary>
+        virtual void cancel() = 0;
+    };
+
+    virtual ~Transport() = default;
+
+    /// <summary>
+    /// The transport's clock: steady_clock, or the virtual clock of a
+    /// simulated network. Probe round trips and rate limits are timed on it.
+    /// </summary>
+    virtual Clock::time_point now() const = 0;
+
+    virtual std::unique_ptr<Timer> makeTimer() = 0;
+
+    /// <summary>
+    /// Probes that can be started right now.
+    /// </summary>
+    virtual size_t freeSlots() const = 0;
+
+    /// <summary>
+    /// Makes room for this many connects beyond those in progress, so that
+    /// a scan's window is allocated when it starts rather than while it
+    /// runs. A transport with a fixed number of slots ignores it.
+    /// </summary>
+    virtual void reserveSlots(size_t slots) = 0;
+
+    /// <summary>
+    /// Takes a free slot and starts a connect on it; the handler's
+    /// onConnect follows. Requires freeSlots() > 0. The handler must stay
+    /// valid until the slot is closed.
+    /// </summary>
+    /// <param name="address">IPv4 address in host byte order</param>
+    /// <returns>The slot, to pass to the other calls</returns>
+    virtual uint32_t connect(Handler& handler, uint32_t address, uint16_t port,
+                             uint32_t timeout_ms) = 0;
+
+    /// <summary>
+    /// On a connected slot, sends the request, if any, and reads once into
+    /// the buffer; the handler's onReceive follows. The request and buffer
+    /// must outlive the read.
+    /// </summary>
+    virtual void exchange(uint32_t slot, std::string_view request, char* buffer, size_t size,
+                          uint32_t timeout_ms) = 0;
+
+    /// <summary>
+    /// Ends the slot's connect or read in progress with operation_aborted.
+    /// </summary>
+    virtual void cancel(uint32_t slot) = 0;
+
+    /// <summary>
+    /// Closes the slot's connection and gives the slot back. No handler
+    /// call follows.
+    /// </summary>
+    virtual void close(uint32_t slot) = 0;
+};
+
+/// <summary>
+/// Transport timer on an io_context's steady_timer.
+/// </summary>
+class AsioTimer : public Transport::Timer {
+public:
+    explicit AsioTimer(asio::io_context& io)
+        : m_timer(io) {}
+
+    void wait(Transport::Clock::duration delay, std::function<void()> handler) override {
+        m_timer.expires_after(delay);
+        m_timer.async_wait([handler = std::move(handler)](const asio::error_code& ec) {
+            if (!ec) {
+                handler();
+            }
+        });
+    }
+
+    void cancel() override { m_timer.cancel(); }
+
+private:
+    asio::steady_timer m_timer;
+};
+
+} // namespace netlens::internal
@@ -0,0 +1,333 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "UringConnector.h"
+
+#ifdef NETLENS_HAS_IO_URING
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <algorithm>
+#include <cerrno>
+#include <ctime>
+#include <system_error>
+
+namespace netlens::internal {
+
+namespace {
+
+/// <summary>
+/// Descriptors left to the rest of the process when sizing the file table.
+/// </summary>
+constexpr unsigned RESERVED_DESCRIPTORS = 256;
+
+unsigned slotLimit(unsigned wanted) {
+    rlimit limit{};
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0 || limit.rlim_cur == RLIM_INFINITY) {
+        return wanted;
+    }
+    const rlim_t usable = limit.rlim_cur > RESERVED_DESCRIPTORS * 2
+        ? limit.rlim_cur - RESERVED_DESCRIPTORS : limit.rlim_cur / 2;
+    return static_cast<unsigned>(std::max<rlim_t>(1, std::min<rlim_t>(wanted, usable)));
+}
+
+int makeEventFd() {
+    const int fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (fd < 0) {
+        throw std::system_error(errno, std::system_category(), "eventfd");
+    }
+    return fd;
+}
+
+} // namespace
+
+bool UringConnector::supported() {
+    static const bool result = IoUring::supportsOps({
+        IORING_OP_SOCKET, IORING_OP_CONNECT, IORING_OP_SEND, IORING_OP_RECV,
+        IORING_OP_LINK_TIMEOUT, IORING_OP_CLOSE, IORING_OP_ASYNC_CANCEL});
+    return result;
+}
+
+UringConnector::UringConnector(asio::io_context& io, unsigned slots)
+    : m_ring(std::min(slotLimit(slots), 4096u), slotLimit(slots) * 4)
+    , m_io(io)
+    , m_event(io, makeEventFd())
+    , m_event_count(0)
+    , m_waiting(false)
+    , m_flush_posted(false)
+    , m_slots(slotLimit(slots)) {
+    if (int error = m_ring.registerSparseFiles(static_cast<unsigned>(m_slots.size())); error < 0) {
+        throw std::system_error(-error, std::system_category(), "io_uring file table");
+    }
+    if (int error = m_ring.registerEventFd(m_event.native_handle()); error < 0) {
+        throw std::system_error(-error, std::system_category(), "io_uring eventfd");
+    }
+    m_free.reserve(m_slots.size());
+    for (uint32_t slot = static_cast<uint32_t>(m_slots.size()); slot > 0; --slot) {
+        m_free.push_back(slot - 1);
+    }
+}
+
+UringConnector::~UringConnector() = default;
+
+std::unique_ptr<Transport::Timer> UringConnector::makeTimer() {
+    return std::make_unique<AsioTimer>(m_io);
+}
+
+uint32_t UringConnector::connect(Handler& handler, uint32_t address, uint16_t port,
+                                 uint32_t timeout_ms) {
+    const uint32_t index = m_free.back();
+    m_free.pop_back();
+    Slot& slot = m_slots[index];
+    slot.handler = &handler;
+    slot.address.sin_family = AF_INET;
+    slot.address.sin_port = htons(port);
+    slot.address.sin_addr.s_addr = htonl(address);
+    slot.socket_error = 0;
+    slot.sending = false;
+    slot.cancelled = false;
+    slot.closing = false;
+    setTimeout(slot, timeout_ms);
+
+    // A link never spans two submissions
+    reserve(3);
+
+    io_uring_sqe* socket = entry(index, Op::Socket);
+    socket->opcode = IORING_OP_SOCKET;
+    socket->fd = AF_INET;
+    socket->off = SOCK_STREAM;
+    socket->len = IPPROTO_TCP;
+    socket->file_index = index + 1;
+    socket->flags = IOSQE_IO_LINK;
+
+    io_uring_sqe* connect = entry(index, Op::Connect);
+    connect->opcode = IORING_OP_CONNECT;
+    connect->fd = static_cast<int>(index);
+    connect->addr = reinterpret_cast<uint64_t>(&slot.address);
+    connect->off = sizeof(slot.address);
+    connect->flags = IOSQE_FIXED_FILE | IOSQE_IO_LINK;
+    slot.current = connect->user_data;
+
+    io_uring_sqe* timeout = entry(index, Op::ConnectTimeout);
+    timeout->opcode = IORING_OP_LINK_TIMEOUT;
+    timeout->fd = -1;
+    timeout->addr = reinterpret_cast<uint64_t>(&slot.timeout);
+    timeout->len = 1;
+
+    wait();
+    return index;
+}
+
+void UringConnector::exchange(uint32_t index, std::string_view request, char* buffer, size_t size,
+                              uint32_t timeout_ms) {
+    Slot& slot = m_slots[index];
+    slot.request = request;
+    setDeadline(slot, timeout_ms);
+    reserve(4);
+
+    // Send and read each carry a linked timeout on the same absolute
+    // deadline, so a send the peer never drains is bounded too and the
+    // exchange as a whole never outlives the deadline
+    if (!request.empty()) {
+        io_uring_sqe* send = entry(index, Op::Send);
+        send->opcode = IORING_OP_SEND;
+        send->fd = static_cast<int>(index);
+        send->addr = reinterpret_cast<uint64_t>(slot.request.data());
+        send->len = static_cast<uint32_t>(slot.request.size());
+        send->msg_flags = MSG_NOSIGNAL;
+        send->flags = IOSQE_FIXED_FILE | IOSQE_IO_LINK;
+        slot.sending = true;
+
+        io_uring_sqe* send_timeout = entry(index, Op::SendTimeout);
+        send_timeout->opcode = IORING_OP_LINK_TIMEOUT;
+        send_timeout->fd = -1;
+        send_timeout->addr = reinterpret_cast<uint64_t>(&slot.timeout);
+        send_timeout->len = 1;
+        send_timeout->timeout_flags = IORING_TIMEOUT_ABS;
+        send_timeout->flags = IOSQE_IO_LINK;
+    }
+
+    io_uring_sqe* recv = entry(index, Op::Recv);
+    recv->opcode = IORING_OP_RECV;
+    recv->fd = static_cast<int>(index);
+    recv->addr = reinterpret_cast<uint64_t>(buffer);
+    recv->len = static_cast<uint32_t>(size);
+    recv->flags = IOSQE_FIXED_FILE | IOSQE_IO_LINK;
+    slot.current = recv->user_data;
+
+    io_uring_sqe* timeout = entry(index, Op::RecvTimeout);
+    timeout->opcode = IORING_OP_LINK_TIMEOUT;
+    timeout->fd = -1;
+    timeout->addr = reinterpret_cast<uint64_t>(&slot.timeout);
+    timeout->len = 1;
+    timeout->timeout_flags = IORING_TIMEOUT_ABS;
+}
+
+void UringConnector::cancel(uint32_t index) {
+    Slot& slot = m_slots[index];
+    if (slot.closing || slot.current == 0) {
+        return;
+    }
+    slot.cancelled = true;
+    reserve(2);
+    // A read linked behind a send has not started and cannot be found by
+    // its own cancel, so the send is cancelled too, failing the chain
+    if (slot.sending) {
+        queueCancel(index, tag(index, Op::Send));
+    }
+    queueCancel(index, slot.current);
+}
+
+void UringConnector::queueCancel(uint32_t index, uint64_t target) {
+    // Not counted as pending: the slot may be reused before it completes
+    io_uring_sqe* cancel = m_ring.nextEntry();
+    cancel->opcode = IORING_OP_ASYNC_CANCEL;
+    cancel->fd = -1;
+    cancel->addr = target;
+    cancel->user_data = tag(index, Op::Cancel);
+    // An idle shard has no other submission coming to carry it
+    postFlush();
+}
+
+void UringConnector::close(uint32_t index) {
+    Slot& slot = m_slots[index];
+    if (slot.closing) {
+        return;
+    }
+    slot.closing = true;
+    slot.current = 0;
+    reserve(1);
+    io_uring_sqe* close = entry(index, Op::Close);
+    close->opcode = IORING_OP_CLOSE;
+    close->file_index = index + 1;
+}
+
+void UringConnector::reserve(unsigned entries) {
+    if (m_ring.freeEntries() < entries) {
+        m_ring.submit();
+    }
+}
+
+io_uring_sqe* UringConnector::entry(uint32_t index, Op op) {
+    io_uring_sqe* sqe = m_ring.nextEntry();
+    sqe->user_data = tag(index, op);
+    ++m_slots[index].pending;
+    postFlush();
+    return sqe;
+}
+
+void UringConnector::postFlush() {
+    if (!m_flush_posted) {
+        // Everything queued until the current handler returns goes out in one call
+        m_flush_posted = true;
+        asio::post(m_io, [this]() { flush(); });
+    }
+}
+
+void UringConnector::setTimeout(Slot& slot, uint32_t timeout_ms) {
+    slot.timeout.tv_sec = timeout_ms / 1000;
+    slot.timeout.tv_nsec = static_cast<long long>(timeout_ms % 1000) * 1000000;
+}
+
+void UringConnector::setDeadline(Slot& slot, uint32_t timeout_ms) {
+    // Linked timeouts measure IORING_TIMEOUT_ABS on CLOCK_MONOTONIC
+    timespec now{};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    const long long nanoseconds = static_cast<long long>(now.tv_nsec)
+        + static_cast<long long>(timeout_ms % 1000) * 1000000;
+    slot.timeout.tv_sec = now.tv_sec + timeout_ms / 1000 + nanoseconds / 1000000000;
+    slot.timeout.tv_nsec = nanoseconds % 1000000000;
+}
+
+asio::error_code UringConnector::outcome(const Slot& slot, int result) const {
+    if (result >= 0) {
+        return {};
+    }
+    // The linked timeout and cancel() both end the operation with -ECANCELED
+    if (result == -ECANCELED) {
+        return slot.cancelled ? asio::error::operation_aborted : asio::error::timed_out;
+    }
+    return asio::error_code(-result, asio::error::get_system_category());
+}
+
+void UringConnector::flush() {
+    m_flush_posted = false;
+    m_ring.submit();
+}
+
+void UringConnector::wait() {
+    if (m_waiting) {
+        return;
+    }
+    m_waiting = true;
+    m_event.async_read_some(asio::buffer(&m_event_count, sizeof(m_event_count)),
+        [this](const asio::error_code& ec, size_t) {
+            m_waiting = false;
+            if (!ec) {
+                m_ring.reap([this](const io_uring_cqe& cqe) { complete(cqe); });
+            }
+            if (m_free.size() < m_slots.size()) {
+                wait();
+            }
+        });
+}
+
+void UringConnector::complete(const io_uring_cqe& cqe) {
+    const auto op = static_cast<Op>(cqe.user_data & 0xff);
+    const auto index = static_cast<uint32_t>(cqe.user_data >> 8);
+    if (op == Op::Cancel) {
+        return;
+    }
+    Slot& slot = m_slots[index];
+    --slot.pending;
+
+    switch (op) {
+    case Op::Socket:
+        // The connect linked to it then completes with -ECANCELED
+        if (cqe.res < 0) {
+            slot.socket_error = cqe.res;
+        }
+        break;
+    case Op::Connect:
+        if (!slot.closing) {
+            slot.current = 0;
+            slot.handler->onConnect(outcome(slot, slot.socket_error != 0 ? slot.socket_error : cqe.res));
+        }
+        break;
+    case Op::Send:
+        slot.sending = false;
+        break;
+    case Op::Recv:
+        if (!slot.closing) {
+            slot.current = 0;
+            slot.handler->onReceive(outcome(slot, cqe.res), cqe.res > 0 ? static_cast<size_t>(cqe.res) : 0);
+        }
+        break;
+    default:
+        break;
+    }
+    releaseIfDone(index);
+}
+
+void UringConnector::releaseIfDone(uint32_t index) {
+    Slot& slot = m_slots[index];
+    if (!slot.closing || slot.pending != 0) {
+        return;
+    }
+    slot.handler = nullptr;
+    slot.closing = false;
+    m_free.push_back(index);
+    if (m_free.size() == m_slots.size() && m_waiting) {
+        // Leave the io_context without work between scans
+        m_event.cancel();
+    }
+}
+
+} // namespace netlens::internal
+
+#endif // NETLENS_HAS_IO_URING
@@ -0,0 +1,134 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#pragma once
+
+#include "IoUring.h"
+#include "Transport.h"
+
+#ifdef NETLENS_HAS_IO_URING
+
+#include <vector>
+
+namespace netlens::internal {
+
+/// <summary>
+/// Runs TCP connect probes and banner reads through an io_uring attached to
+/// an io_context. Each probe owns a slot: a fixed descriptor in the ring's
+/// file table, the socket address and the deadline. A connect goes out as
+/// one linked chain (socket, connect, linked timeout) and a banner read as
+/// another (send and recv, each with a linked timeout on one absolute
+/// deadline), so a probe costs no epoll
+/// registration, no timer and no close(2) of its own. Entries queued
+/// during one io_context handler are submitted together by a single
+/// io_uring_enter posted after it; completions are reaped when the ring's
+/// eventfd becomes readable. Errors reach the handler as system error
+/// codes, a deadline as asio::error::timed_out.
+/// Only the io_context's thread may use the connector, and it must be
+/// created on that thread. It keeps no work outstanding while all slots
+/// are free, so io_context::run returns once the scans are over.
+/// </summary>
+class UringConnector : public Transport {
+public:
+    /// <summary>
+    /// Slots used when the descriptor limit allows.
+    /// </summary>
+    static constexpr unsigned DEFAULT_SLOTS = 4096;
+
+    /// <summary>
+    /// True if the kernel supports everything the connector needs (Linux 5.19+).
+    /// </summary>
+    static bool supported();
+
+    /// <summary>
+    /// Sets up the ring and its file table.
+    /// </summary>
+    /// <param name="io">io_context whose thread drives the connector</param>
+    /// <param name="slots">Probes in flight at most; lowered to the descriptor limit</param>
+    /// <exception cref="std::system_error">Thrown if the ring cannot be set up</exception>
+    UringConnector(asio::io_context& io, unsigned slots = DEFAULT_SLOTS);
+
+    /// <summary>
+    /// Closes the ring. No slot may be in use.
+    /// </summary>
+    ~UringConnector();
+
+    UringConnector(const UringConnector&) = delete;
+    UringConnector& operator=(const UringConnector&) = delete;
+
+    Clock::time_point now() const override { return Clock::now(); }
+    std::unique_ptr<Timer> makeTimer() override;
+    size_t freeSlots() const override { return m_free.size(); }
+
+    // The ring's slots are fixed; a window beyond them overflows to Asio sockets
+    void reserveSlots(size_t) override {}
+
+    uint32_t connect(Handler& handler, uint32_t address, uint16_t port,
+                     uint32_t timeout_ms) override;
+    void exchange(uint32_t slot, std::string_view request, char* buffer, size_t size,
+                  uint32_t timeout_ms) override;
+    void cancel(uint32_t slot) override;
+
+    /// <summary>
+    /// Closes the slot's socket. The slot is free again once the kernel is
+    /// done with it.
+    /// </summary>
+    void close(uint32_t slot) override;
+
+private:
+    enum class Op : uint8_t {
+        Socket,
+        Connect,
+        ConnectTimeout,
+        Send,
+        SendTimeout,
+        Recv,
+        RecvTimeout,
+        Close,
+        Cancel
+    };
+
+    struct Slot {
+        Handler* handler = nullptr;
+        sockaddr_in address{};
+        __kernel_timespec timeout{};
+        std::string_view request;
+        uint64_t current = 0;       // user_data of the operation cancel() targets
+        int socket_error = 0;
+        uint32_t pending = 0;       // Completions still to come
+        bool sending = false;       // The banner request's send is in progress
+        bool cancelled = false;
+        bool closing = false;
+    };
+
+    static uint64_t tag(uint32_t slot, Op op) {
+        return (static_cast<uint64_t>(slot) << 8) | static_cast<uint8_t>(op);
+    }
+
+    void reserve(unsigned entries);
+    io_uring_sqe* entry(uint32_t slot, Op op);
+    void queueCancel(uint32_t slot, uint64_t target);
+    void postFlush();
+    void setTimeout(Slot& slot, uint32_t timeout_ms);
+    void setDeadline(Slot& slot, uint32_t timeout_ms);
+    asio::error_code outcome(const Slot& slot, int result) const;
+    void flush();
+    void wait();
+    void complete(const io_uring_cqe& cqe);
+    void releaseIfDone(uint32_t slot);
+
+    IoUring m_ring;
+    asio::io_context& m_io;
+    asio::posix::stream_descriptor m_event;
+    uint64_t m_event_count;
+    bool m_waiting;
+    bool m_flush_posted;
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_free;
+};
+
+} // namespace netlens::internal
+
+#endif // NETLENS_HAS_IO_URING
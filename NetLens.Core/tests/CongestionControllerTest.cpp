@@ -0,0 +1,87 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "CongestionController.h"
+#include <gtest/gtest.h>
+
+using netlens::internal::CongestionController;
+using netlens::internal::ProbeSignal;
+
+namespace {
+
+void completeEpoch(CongestionController& controller, ProbeSignal signal) {
+    const size_t window = controller.window();
+    for (size_t i = 0; i < window; ++i) {
+        controller.onProbeComplete(signal);
+    }
+}
+
+} // namespace
+
+TEST(CongestionController, InitialWindowIsClampedToBounds) {
+    EXPECT_EQ(CongestionController(1, 1000).window(), 64u);
+    EXPECT_EQ(CongestionController(1, 32).window(), 32u);
+    EXPECT_EQ(CongestionController(100, 1000).window(), 100u);
+    EXPECT_EQ(CongestionController(0, 0).window(), 1u);
+}
+
+TEST(CongestionController, SlowStartDoublesUpToTheMaximum) {
+    CongestionController controller(1, 300);
+    completeEpoch(controller, ProbeSignal::Answered);
+    EXPECT_EQ(controller.window(), 128u);
+    completeEpoch(controller, ProbeSignal::Answered);
+    EXPECT_EQ(controller.window(), 256u);
+    completeEpoch(controller, ProbeSignal::Answered);
+    EXPECT_EQ(controller.window(), 300u);
+    completeEpoch(controller, ProbeSignal::Answered);
+    EXPECT_EQ(controller.window(), 300u);
+    EXPECT_EQ(controller.stats().decreases, 0u);
+}
+
+TEST(CongestionController, NewTimeoutsHalveTheWindowThenGrowthIsAdditive) {
+    CongestionController controller(1, 100000);
+    completeEpoch(controller, ProbeSignal::Answered);
+    ASSERT_EQ(controller.window(), 128u);
+
+    completeEpoch(controller, ProbeSignal::TimedOut);
+    EXPECT_EQ(controller.window(), 64u);
+    EXPECT_EQ(controller.stats().decreases, 1u);
+
+    completeEpoch(controller, ProbeSignal::Answered);
+    EXPECT_EQ(controller.window(), 72u);
+}
+
+TEST(CongestionController, SteadyTimeoutsAreNotLoss) {
+    // A range that is mostly firewalled times out by design
+    CongestionController controller(1, 100000);
+    for (int epoch = 0; epoch < 4; ++epoch) {
+        completeEpoch(controller, ProbeSignal::TimedOut);
+    }
+    EXPECT_EQ(controller.window(), 1024u);
+    EXPECT_EQ(controller.stats().decreases, 0u);
+}
+
+TEST(CongestionController, LocalErrorsHalveOncePerEpoch) {
+    CongestionController controller(1, 1000);
+    controller.onProbeComplete(ProbeSignal::LocalError);
+    controller.onProbeComplete(ProbeSignal::LocalError);
+    controller.onProbeComplete(ProbeSignal::LocalError);
+    EXPECT_EQ(controller.window(), 32u);
+    EXPECT_EQ(controller.stats().decreases, 1u);
+    EXPECT_EQ(controller.stats().local_errors, 3u);
+
+    // The epoch that saw the cut does not grow the window again
+    completeEpoch(controller, ProbeSignal::Answered);
+    EXPECT_EQ(controller.window(), 32u);
+}
+
+TEST(CongestionController, NeverDropsBelowTheMinimum) {
+    CongestionController controller(16, 1000);
+    for (int epoch = 0; epoch < 10; ++epoch) {
+        controller.onProbeComplete(ProbeSignal::LocalError);
+        completeEpoch(controller, ProbeSignal::Other);
+    }
+    EXPECT_EQ(controller.window(), 16u);
+}
@@ -0,0 +1,95 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "IntervalSet.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using netlens::internal::IntervalSet;
+using netlens::internal::IpRange;
+
+namespace {
+
+std::vector<IpRange> intervalsOf(const IntervalSet& set) {
+    return std::vector<IpRange>(set.intervals().begin(), set.intervals().end());
+}
+
+void expectIntervals(const IntervalSet& set, const std::vector<std::pair<uint32_t, uint32_t>>& expected) {
+    const auto actual = intervalsOf(set);
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(actual[i].first(), expected[i].first) << "interval " << i;
+        EXPECT_EQ(actual[i].last(), expected[i].second) << "interval " << i;
+    }
+}
+
+} // namespace
+
+TEST(IntervalSet, MergesOverlappingAndAdjacentRanges) {
+    const auto set = IntervalSet::fromRanges({
+        IpRange(30, 40), IpRange(10, 20), IpRange(15, 25), IpRange(26, 28), IpRange(50, 50)
+    });
+
+    expectIntervals(set, { { 10, 28 }, { 30, 40 }, { 50, 50 } });
+    EXPECT_EQ(set.size(), 19u + 11u + 1u);
+}
+
+TEST(IntervalSet, MergesContainedRanges) {
+    const auto set = IntervalSet::fromRanges({ IpRange(0, 100), IpRange(10, 20), IpRange(100, 100) });
+
+    expectIntervals(set, { { 0, 100 } });
+}
+
+TEST(IntervalSet, CoversTheWholeAddressSpace) {
+    const auto set = IntervalSet::fromRanges({ IpRange(0x80000000u, 0xFFFFFFFFu), IpRange(0, 0x7FFFFFFFu) });
+
+    expectIntervals(set, { { 0, 0xFFFFFFFFu } });
+    EXPECT_EQ(set.size(), 1ull << 32);
+    EXPECT_EQ(set.at((1ull << 32) - 1), 0xFFFFFFFFu);
+}
+
+TEST(IntervalSet, SubtractSplitsAndTrimsIntervals) {
+    const auto set = IntervalSet::fromRanges({ IpRange(0, 99), IpRange(200, 299) });
+    const auto holes = IntervalSet::fromRanges({ IpRange(10, 19), IpRange(90, 210), IpRange(299, 400) });
+
+    expectIntervals(set.subtract(holes), { { 0, 9 }, { 20, 89 }, { 211, 298 } });
+}
+
+TEST(IntervalSet, SubtractOfDisjointOrCoveringSets) {
+    const auto set = IntervalSet::fromRanges({ IpRange(100, 199) });
+
+    expectIntervals(set.subtract(IntervalSet::fromRanges({ IpRange(0, 99), IpRange(200, 300) })), { { 100, 199 } });
+    EXPECT_TRUE(set.subtract(IntervalSet::fromRanges({ IpRange(0, 1000) })).empty());
+    expectIntervals(set.subtract(IntervalSet()), { { 100, 199 } });
+}
+
+TEST(IntervalSet, SubtractAtTheEdgesOfTheAddressSpace) {
+    const auto all = IntervalSet::fromRanges({ IpRange(0, 0xFFFFFFFFu) });
+    const auto edges = IntervalSet::fromRanges({ IpRange(0, 0), IpRange(0xFFFFFFFFu, 0xFFFFFFFFu) });
+
+    const auto inner = all.subtract(edges);
+    expectIntervals(inner, { { 1, 0xFFFFFFFEu } });
+    EXPECT_EQ(inner.size(), (1ull << 32) - 2);
+}
+
+TEST(IntervalSet, IndexingAndIterationAgree) {
+    const auto set = IntervalSet::fromRanges({ IpRange(5, 7), IpRange(20, 21), IpRange(9, 9) });
+
+    std::vector<uint32_t> iterated(set.begin(), set.end());
+    ASSERT_EQ(iterated, (std::vector<uint32_t>{ 5, 6, 7, 9, 20, 21 }));
+    for (uint64_t i = 0; i < set.size(); ++i) {
+        EXPECT_EQ(set.at(i), iterated[i]);
+        EXPECT_TRUE(set.contains(iterated[i]));
+    }
+    EXPECT_FALSE(set.contains(8));
+    EXPECT_FALSE(set.contains(22));
+}
+
+TEST(IntervalSet, IntersectKeepsCommonAddresses) {
+    const auto a = IntervalSet::fromRanges({ IpRange(0, 50), IpRange(100, 150) });
+    const auto b = IntervalSet::fromRanges({ IpRange(40, 120), IpRange(150, 200) });
+
+    expectIntervals(a.intersect(b), { { 40, 50 }, { 100, 120 }, { 150, 150 } });
+}
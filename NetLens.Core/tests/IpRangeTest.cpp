@@ -0,0 +1,30 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "IpRange.h"
+#include <gtest/gtest.h>
+
+using netlens::internal::IpRange;
+using netlens::internal::IpRangeException;
+
+TEST(IpRange, FormatsEveryOctetWidth) {
+    EXPECT_EQ(IpRange::toString(0), "0.0.0.0");
+    EXPECT_EQ(IpRange::toString(0xFFFFFFFFu), "255.255.255.255");
+    EXPECT_EQ(IpRange::toString(0x0A00FF01u), "10.0.255.1");
+    EXPECT_EQ(IpRange::toString(0xC0A8630Cu), "192.168.99.12");
+}
+
+TEST(IpRange, ParseAndFormatRoundTrip) {
+    for (uint32_t ip : { 0u, 1u, 0x7F000001u, 0x08080808u, 0xDEADBEEFu, 0xFFFFFFFEu }) {
+        EXPECT_EQ(IpRange::parse(IpRange::toString(ip)), ip);
+    }
+}
+
+TEST(IpRange, RejectsMalformedAddresses) {
+    EXPECT_THROW(IpRange::parse("256.0.0.1"), IpRangeException);
+    EXPECT_THROW(IpRange::parse("10.0.0"), IpRangeException);
+    EXPECT_THROW(IpRange::parse("10.0.0.1.2"), IpRangeException);
+    EXPECT_THROW(IpRange(2, 1), IpRangeException);
+}
@@ -0,0 +1,80 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "JsonWriter.h"
+#include <json.hpp>
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+using json = nlohmann::json;
+using netlens::internal::JsonWriter;
+
+namespace {
+
+std::string escaped(const std::string& text, bool replace_invalid) {
+    std::string out;
+    JsonWriter::escape(out, text, replace_invalid);
+    return out;
+}
+
+// Mostly bytes that start, continue or break UTF-8 sequences
+std::string randomBytes(std::mt19937& rng) {
+    static const unsigned char interesting[] = {
+        'a', '"', '\\', '\n', 0x01, 0x1F, 0x7F, 0x80, 0x9F, 0xA0, 0xBF, 0xC0, 0xC2, 0xDF,
+        0xE0, 0xED, 0xEF, 0xF0, 0xF4, 0xF5, 0xFF
+    };
+    std::string text(rng() % 12, '\0');
+    for (auto& c : text) {
+        c = static_cast<char>(interesting[rng() % sizeof(interesting)]);
+    }
+    return text;
+}
+
+} // namespace
+
+TEST(JsonWriter, EscapesAsNlohmannDoes) {
+    const std::string text = "quote \" backslash \\ tab \t bell \x07 caf\xC3\xA9 \xF0\x9F\x94\x92";
+    EXPECT_EQ(escaped(text, false), json(text).dump());
+}
+
+TEST(JsonWriter, RejectsInvalidUtf8UnlessReplacing) {
+    EXPECT_THROW(escaped("bad \xC3", false), std::invalid_argument);
+    EXPECT_EQ(escaped("bad \xC3", true), "\"bad \xEF\xBF\xBD\"");
+}
+
+TEST(JsonWriter, ReplacesInvalidUtf8AsNlohmannDoes) {
+    std::mt19937 rng(2025);
+    for (int i = 0; i < 100000; ++i) {
+        const std::string text = randomBytes(rng);
+        ASSERT_EQ(escaped(text, true), json(text).dump(-1, ' ', false, json::error_handler_t::replace))
+            << "input of " << text.size() << " bytes, case " << i;
+    }
+}
+
+TEST(JsonWriter, WritesCompactAndPrettyLikeDump) {
+    const json document = { {"a", {1, 2}}, {"b", json::object()}, {"c", json::array()}, {"d", "x"} };
+    for (bool pretty : { false, true }) {
+        std::string out;
+        JsonWriter writer(out, pretty);
+        writer.beginObject();
+        writer.key("a");
+        writer.beginArray();
+        writer.value(uint64_t{ 1 });
+        writer.value(uint64_t{ 2 });
+        writer.endArray();
+        writer.key("b");
+        writer.beginObject();
+        writer.endObject();
+        writer.key("c");
+        writer.beginArray();
+        writer.endArray();
+        writer.key("d");
+        writer.value("x");
+        writer.endObject();
+        EXPECT_EQ(out, pretty ? document.dump(2) : document.dump());
+    }
+}
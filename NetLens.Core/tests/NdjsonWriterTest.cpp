@@ -0,0 +1,133 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "TestFiles.h"
+#include <netlens/NdjsonWriter.h>
+#include <json.hpp>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using json = nlohmann::json;
+using netlens::HostResult;
+using netlens::NdjsonWriter;
+using netlens::ScanSettings;
+using netlens::ScanSummary;
+
+namespace {
+
+std::string contents(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::ostringstream text;
+    text << file.rdbuf();
+    return text.str();
+}
+
+// Lines as the nlohmann-based writer produced them
+std::string expectedSettings(const ScanSettings& settings) {
+    return json{
+        {"type", "settings"},
+        {"startIp", settings.start_ip},
+        {"endIp", settings.end_ip},
+        {"targets", settings.targets},
+        {"excludes", settings.excludes},
+        {"ports", settings.ports},
+        {"timeoutMs", settings.timeout_ms},
+        {"maxConcurrency", settings.max_concurrency}
+    }.dump() + '\n';
+}
+
+std::string expectedHost(const HostResult& host) {
+    json line = {
+        {"type", "host"},
+        {"ip", host.address},
+        {"isAlive", host.is_alive},
+        {"ports", json::array()},
+        {"closedPorts", host.closed_ports},
+        {"filteredPorts", host.filtered_ports}
+    };
+    for (const auto& port : host.ports) {
+        json port_obj = { {"port", port.port}, {"isOpen", port.is_open} };
+        if (!port.banner.empty()) {
+            port_obj["banner"] = port.banner;
+        }
+        line["ports"].push_back(port_obj);
+    }
+    return line.dump(-1, ' ', false, json::error_handler_t::replace) + '\n';
+}
+
+std::string expectedSummary(const ScanSummary& summary, size_t hosts_written) {
+    return json{
+        {"type", "summary"},
+        {"version", "1.0"},
+        {"tool", "NetLens"},
+        {"totalHosts", summary.total_hosts},
+        {"aliveHosts", summary.alive_hosts},
+        {"openPorts", summary.open_ports},
+        {"hostsWritten", hosts_written}
+    }.dump() + '\n';
+}
+
+} // namespace
+
+TEST(NdjsonWriter, WritesTheSameLinesAsTheDocumentWriter) {
+    const netlens::test::TempFile path("ndjson");
+
+    ScanSettings settings;
+    settings.targets = { "10.0.0.0/24", "db.example" };
+    settings.excludes = { "10.0.0.1" };
+    settings.ports = { 22, 80 };
+
+    HostResult web("10.0.0.7", true);
+    web.ports.emplace_back(80, true, "HTTP/1.1 200 OK\r\nServer: \"x\"\r\n");
+    web.ports.emplace_back(22, true, "SSH \xC3\xA9 \xFF\xFE truncated \xE2\x82");
+    web.closed_ports = 3;
+    web.filtered_ports = 1;
+    HostResult dead("10.0.0.8", false);
+
+    ScanSummary summary;
+    summary.total_hosts = 256;
+    summary.alive_hosts = 1;
+    summary.open_ports = 2;
+    {
+        NdjsonWriter writer(path, settings);
+        writer.write(web);
+        writer.write(dead);
+        writer.finish(summary);
+    }
+
+    EXPECT_EQ(contents(path),
+              expectedSettings(settings) + expectedHost(web) + expectedHost(dead) + expectedSummary(summary, 2));
+}
+
+TEST(NdjsonWriter, FlushesWithinTheIntervalWithoutFurtherHosts) {
+    const netlens::test::TempFile path("ndjson");
+    ScanSettings settings;
+    settings.ports = { 80 };
+    NdjsonWriter writer(path, settings, NdjsonWriter::DEFAULT_FLUSH_BYTES, std::chrono::milliseconds(50));
+    const size_t settings_size = contents(path).size();
+
+    // The scan then goes quiet, e.g. waiting on timeouts
+    writer.write(HostResult("10.0.0.1", true));
+    const auto started = std::chrono::steady_clock::now();
+    while (contents(path).size() == settings_size && std::chrono::steady_clock::now() - started < std::chrono::seconds(3)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(contents(path).size(), settings_size + expectedHost(HostResult("10.0.0.1", true)).size());
+    EXPECT_EQ(writer.hostsWritten(), 1u);
+}
+
+TEST(NdjsonWriter, ZeroIntervalFlushesEveryHost) {
+    const netlens::test::TempFile path("ndjson");
+    ScanSettings settings;
+    NdjsonWriter writer(path, settings, NdjsonWriter::DEFAULT_FLUSH_BYTES, std::chrono::milliseconds(0));
+    const size_t settings_size = contents(path).size();
+
+    writer.write(HostResult("10.0.0.1", false));
+    EXPECT_GT(contents(path).size(), settings_size);
+}
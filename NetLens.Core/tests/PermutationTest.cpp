@@ -0,0 +1,66 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "Permutation.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using netlens::internal::Permutation;
+
+namespace {
+
+void expectBijection(uint64_t size, uint64_t seed) {
+    const Permutation permutation(size, seed);
+    std::vector<bool> seen(size, false);
+    for (uint64_t i = 0; i < size; ++i) {
+        const uint64_t value = permutation(i);
+        ASSERT_LT(value, size) << "size " << size << ", index " << i;
+        ASSERT_FALSE(seen[value]) << "size " << size << " maps two indices to " << value;
+        seen[value] = true;
+    }
+}
+
+} // namespace
+
+TEST(Permutation, IsABijectionForAwkwardSizes) {
+    // Sizes just around powers of two exercise the cycle-walking
+    for (uint64_t size : { 1ull, 2ull, 3ull, 4ull, 5ull, 7ull, 15ull, 16ull, 17ull, 255ull, 256ull, 257ull,
+                           1000ull, 65535ull, 65536ull, 65537ull }) {
+        expectBijection(size, 0x5EED);
+    }
+}
+
+TEST(Permutation, IsABijectionForEverySeed) {
+    for (uint64_t seed = 0; seed < 32; ++seed) {
+        expectBijection(4099, seed);
+    }
+}
+
+TEST(Permutation, IsABijectionOverASlash12) {
+    expectBijection(1ull << 20, 42);
+}
+
+TEST(Permutation, SameSeedSameOrder) {
+    const Permutation a(10000, 7);
+    const Permutation b(10000, 7);
+    const Permutation c(10000, 8);
+
+    bool differs = false;
+    for (uint64_t i = 0; i < 10000; ++i) {
+        EXPECT_EQ(a(i), b(i));
+        differs = differs || a(i) != c(i);
+    }
+    EXPECT_TRUE(differs);
+}
+
+TEST(Permutation, ShufflesTheOrder) {
+    const Permutation permutation(10000, 1);
+
+    uint64_t fixed_points = 0;
+    for (uint64_t i = 0; i < 10000; ++i) {
+        fixed_points += permutation(i) == i;
+    }
+    EXPECT_LT(fixed_points, 100u);
+}
@@ -0,0 +1,111 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "RttEstimator.h"
+#include <gtest/gtest.h>
+
+using netlens::internal::AdaptiveTimeout;
+using netlens::internal::RttEstimator;
+
+namespace {
+
+constexpr uint32_t HOST = 0x0A000001;
+constexpr uint32_t NEIGHBOUR = 0x0A000002;
+constexpr uint32_t STRANGER = 0xC0A80001;
+
+} // namespace
+
+TEST(RttEstimator, FollowsRfc6298) {
+    RttEstimator rtt;
+    rtt.addSample(100.0);
+    EXPECT_DOUBLE_EQ(rtt.srtt(), 100.0);
+    EXPECT_DOUBLE_EQ(rtt.rttvar(), 50.0);
+    EXPECT_DOUBLE_EQ(rtt.timeout(), 300.0);
+
+    rtt.addSample(200.0);
+    EXPECT_DOUBLE_EQ(rtt.rttvar(), 0.75 * 50.0 + 0.25 * 100.0);
+    EXPECT_DOUBLE_EQ(rtt.srtt(), 0.875 * 100.0 + 0.125 * 200.0);
+    EXPECT_EQ(rtt.samples(), 2u);
+}
+
+TEST(RttEstimator, VarianceTermHasAClockGranularityFloor) {
+    RttEstimator rtt;
+    for (int i = 0; i < 100; ++i) {
+        rtt.addSample(50.0);
+    }
+    EXPECT_DOUBLE_EQ(rtt.timeout(), 60.0);
+}
+
+TEST(AdaptiveTimeout, UsesTheUpperBoundUntilMeasured) {
+    const AdaptiveTimeout timeouts(100, 3000);
+    EXPECT_EQ(timeouts.timeoutFor(HOST, RttEstimator()), 3000u);
+}
+
+TEST(AdaptiveTimeout, ClampsToTheLowerBound) {
+    AdaptiveTimeout timeouts(200, 3000);
+    RttEstimator host;
+    timeouts.addSample(HOST, host, 1.0);
+    EXPECT_EQ(timeouts.timeoutFor(HOST, host), 200u);
+}
+
+TEST(AdaptiveTimeout, ClampsToTheUpperBound) {
+    AdaptiveTimeout timeouts(200, 3000);
+    RttEstimator host;
+    timeouts.addSample(HOST, host, 5000.0);
+    EXPECT_EQ(timeouts.timeoutFor(HOST, host), 3000u);
+}
+
+TEST(AdaptiveTimeout, RoundsUpWithinBounds) {
+    AdaptiveTimeout timeouts(10, 3000);
+    RttEstimator host;
+    timeouts.addSample(HOST, host, 100.0);
+    EXPECT_EQ(timeouts.timeoutFor(HOST, host), 300u);
+
+    // SRTT 100.125 + 4 * RTTVAR 37.75
+    timeouts.addSample(HOST, host, 101.0);
+    EXPECT_EQ(timeouts.timeoutFor(HOST, host), 252u);
+}
+
+TEST(AdaptiveTimeout, LowerBoundAboveUpperBoundCollapsesToUpper) {
+    AdaptiveTimeout timeouts(5000, 1000);
+    RttEstimator host;
+    timeouts.addSample(HOST, host, 1.0);
+    EXPECT_EQ(timeouts.timeoutFor(HOST, host), 1000u);
+}
+
+TEST(AdaptiveTimeout, FallsBackToTheSubnetThenTheScan) {
+    AdaptiveTimeout timeouts(10, 10000);
+    timeouts.addHost(HOST);
+    timeouts.addHost(NEIGHBOUR);
+
+    RttEstimator host;
+    timeouts.addSample(HOST, host, 100.0);
+    timeouts.addSample(HOST, host, 100.0);
+    EXPECT_EQ(timeouts.timeoutFor(NEIGHBOUR, RttEstimator()), 10000u) << "too few samples for a fallback";
+
+    // 212.5 ms from three samples, with the subnet's and the scan's margins
+    timeouts.addSample(HOST, host, 100.0);
+    EXPECT_EQ(timeouts.timeoutFor(NEIGHBOUR, RttEstimator()), 425u);
+    EXPECT_EQ(timeouts.timeoutFor(STRANGER, RttEstimator()), 850u);
+
+    // The subnet's estimate goes with its last active host
+    timeouts.removeHost(HOST);
+    timeouts.removeHost(NEIGHBOUR);
+    EXPECT_EQ(timeouts.timeoutFor(NEIGHBOUR, RttEstimator()), 850u);
+}
+
+TEST(AdaptiveTimeout, FallbacksAreClamped) {
+    AdaptiveTimeout timeouts(1000, 2000);
+    RttEstimator host;
+    for (int i = 0; i < 3; ++i) {
+        timeouts.addSample(HOST, host, 1.0);
+    }
+    EXPECT_EQ(timeouts.timeoutFor(STRANGER, RttEstimator()), 1000u);
+
+    for (int i = 0; i < 20; ++i) {
+        timeouts.addSample(HOST, host, 900.0);
+    }
+    EXPECT_EQ(timeouts.timeoutFor(STRANGER, RttEstimator()), 2000u);
+}
@@ -0,0 +1,211 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "TestFiles.h"
+#include <netlens/ScanArchive.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+using netlens::HostResult;
+using netlens::Liveness;
+using netlens::ScanArchive;
+using netlens::ScanArchiveReader;
+using netlens::ScanResult;
+
+namespace {
+
+ScanResult sampleResult() {
+    ScanResult result;
+    result.settings.targets = { "192.168.1.0/24" };
+    result.settings.ports = { 443, 22, 80 };
+
+    // Hosts out of address order; the archive sorts them
+    HostResult web("192.168.1.20", true);
+    web.ports.emplace_back(443, true, "");
+    web.ports.emplace_back(80, true, "HTTP/1.1 200 OK");
+    web.closed_ports = 1;
+
+    HostResult ssh("192.168.1.3", true);
+    ssh.ports.emplace_back(22, true, "SSH-2.0-OpenSSH_9.6");
+    ssh.filtered_ports = 2;
+
+    HostResult quiet("192.168.1.7", true);
+    quiet.liveness = Liveness::EchoReply;
+    quiet.filtered_ports = 3;
+
+    result.hosts = { web, ssh, quiet };
+    return result;
+}
+
+// Archive layout: a 48-byte header with the host, port and banner counts
+// at offsets 16, 24 and 32, then 24-byte directory entries of kind,
+// reserved, offset and size
+constexpr std::streamoff PORT_COUNT_OFFSET = 24;
+constexpr std::streamoff BANNER_COUNT_OFFSET = 32;
+constexpr std::streamoff DIRECTORY_OFFSET = 48;
+constexpr uint32_t HOST_FIRST_PORT = 3;
+constexpr uint32_t PORT_BANNER = 9;
+constexpr uint32_t BANNER_OFFSETS = 10;
+
+template<typename T>
+T readAt(const std::string& path, std::streamoff offset) {
+    std::ifstream file(path, std::ios::binary);
+    file.seekg(offset);
+    T value{};
+    file.read(reinterpret_cast<char*>(&value), sizeof(value));
+    return value;
+}
+
+template<typename T>
+void writeAt(const std::string& path, std::streamoff offset, T value) {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(offset);
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+std::streamoff sectionOffset(const std::string& path, uint32_t kind) {
+    const auto count = readAt<uint32_t>(path, 12);
+    for (uint32_t i = 0; i < count; ++i) {
+        const std::streamoff entry = DIRECTORY_OFFSET + i * 24;
+        if (readAt<uint32_t>(path, entry) == kind) {
+            return static_cast<std::streamoff>(readAt<uint64_t>(path, entry + 8));
+        }
+    }
+    ADD_FAILURE() << "no section of kind " << kind;
+    return 0;
+}
+
+} // namespace
+
+TEST(ScanArchive, ReaderQueriesTheSavedResult) {
+    const netlens::test::TempFile path("nlar");
+    ScanArchive::save(sampleResult(), path);
+    ASSERT_TRUE(ScanArchive::isArchive(path));
+
+    const ScanArchiveReader reader(path);
+    EXPECT_EQ(reader.settings().ports, (std::vector<uint16_t>{ 443, 22, 80 }));
+    ASSERT_EQ(reader.hostCount(), 3u);
+    EXPECT_EQ(reader.openPortCount(), 3u);
+    EXPECT_EQ(reader.hostAt(0).address, 0xC0A80103u);
+    EXPECT_EQ(reader.hostAt(1).address, 0xC0A80107u);
+    EXPECT_EQ(reader.hostAt(2).address, 0xC0A80114u);
+
+    const auto web = reader.findHost(0xC0A80114u);
+    ASSERT_TRUE(web.has_value());
+    const auto ports = reader.openPorts(*web);
+    const auto banners = reader.openPortBanners(*web);
+    ASSERT_EQ(ports.size(), 2u);
+    EXPECT_EQ(ports[0], 80);
+    EXPECT_EQ(ports[1], 443);
+    EXPECT_EQ(reader.banner(banners[0]), "HTTP/1.1 200 OK");
+    EXPECT_EQ(reader.banner(banners[1]), "");
+    EXPECT_EQ(reader.hostAt(*web).closed_count, 1u);
+
+    EXPECT_FALSE(reader.findHost(0xC0A80104u).has_value());
+
+    const auto quiet = reader.findHost(0xC0A80107u);
+    ASSERT_TRUE(quiet.has_value());
+    EXPECT_EQ(reader.hostAt(*quiet).liveness, Liveness::EchoReply);
+    EXPECT_EQ(reader.hostAt(*quiet).filtered_count, 3u);
+    EXPECT_TRUE(reader.openPorts(*quiet).empty());
+}
+
+TEST(ScanArchive, LegacyHostListsEveryPortInSettingsOrder) {
+    const netlens::test::TempFile path("nlar");
+    ScanArchive::save(sampleResult(), path);
+    const ScanArchiveReader reader(path);
+
+    const HostResult ssh = reader.host(0);
+    EXPECT_EQ(ssh.address, "192.168.1.3");
+    ASSERT_EQ(ssh.ports.size(), 3u);
+    EXPECT_EQ(ssh.ports[0].port, 443);
+    EXPECT_FALSE(ssh.ports[0].is_open);
+    EXPECT_EQ(ssh.ports[1].port, 22);
+    EXPECT_TRUE(ssh.ports[1].is_open);
+    EXPECT_EQ(ssh.ports[1].banner, "SSH-2.0-OpenSSH_9.6");
+}
+
+TEST(ScanArchive, JsonRoundTripPreservesHostsAndOpenPorts) {
+    const netlens::test::TempFile archive("nlar");
+    const netlens::test::TempFile json("json");
+    const netlens::test::TempFile again("nlar");
+    ScanArchive::save(sampleResult(), archive);
+
+    ASSERT_TRUE(ScanArchive::toJsonFile(archive, json));
+    EXPECT_FALSE(ScanArchive::isArchive(json));
+    ASSERT_TRUE(ScanArchive::fromJsonFile(json, again));
+
+    // JSON lists every probed port and carries no liveness or filtered
+    // counts, so only the hosts and their open ports survive the trip
+    const ScanArchiveReader first(archive);
+    const ScanArchiveReader second(again);
+    ASSERT_EQ(first.hostCount(), second.hostCount());
+    for (size_t i = 0; i < first.hostCount(); ++i) {
+        EXPECT_EQ(first.hostAt(i).address, second.hostAt(i).address);
+        EXPECT_EQ(first.hostAt(i).is_alive, second.hostAt(i).is_alive);
+        const auto a = first.openPorts(i);
+        const auto b = second.openPorts(i);
+        ASSERT_TRUE(std::equal(a.begin(), a.end(), b.begin(), b.end()));
+        for (size_t p = 0; p < a.size(); ++p) {
+            EXPECT_EQ(first.banner(first.openPortBanners(i)[p]), second.banner(second.openPortBanners(i)[p]));
+        }
+    }
+}
+
+TEST(ScanArchive, RejectsATruncatedArchive) {
+    const netlens::test::TempFile path("nlar");
+    ScanArchive::save(sampleResult(), path);
+    std::filesystem::resize_file(path.path(), std::filesystem::file_size(path.path()) / 2);
+
+    EXPECT_THROW(ScanArchiveReader reader(path), std::runtime_error);
+}
+
+TEST(ScanArchive, RejectsAnInvalidAddress) {
+    const netlens::test::TempFile path("nlar");
+    ScanResult result = sampleResult();
+    result.hosts.emplace_back("host.example", true);
+
+    EXPECT_THROW(ScanArchive::save(result, path), std::runtime_error);
+}
+
+TEST(ScanArchive, RejectsCountsThatWrapTheSectionSize) {
+    const netlens::test::TempFile path("nlar");
+
+    // 2^63 ports: 2^63 * 2 and 2^63 * 4 bytes both wrap to 0
+    ScanResult empty;
+    empty.settings.ports = { 80 };
+    ScanArchive::save(empty, path);
+    writeAt<uint64_t>(path, PORT_COUNT_OFFSET, 1ull << 63);
+    EXPECT_THROW(ScanArchiveReader reader(path), std::runtime_error);
+
+    // banner_count + 1 offsets wrap to 0, or to a single offset
+    ScanArchive::save(empty, path);
+    writeAt<uint64_t>(path, BANNER_COUNT_OFFSET, std::numeric_limits<uint64_t>::max());
+    EXPECT_THROW(ScanArchiveReader reader(path), std::runtime_error);
+    writeAt<uint64_t>(path, BANNER_COUNT_OFFSET, 1ull << 61);
+    EXPECT_THROW(ScanArchiveReader reader(path), std::runtime_error);
+}
+
+TEST(ScanArchive, RejectsIndexesPointingOutsideTheColumns) {
+    const netlens::test::TempFile path("nlar");
+
+    ScanArchive::save(sampleResult(), path);
+    writeAt<uint32_t>(path, sectionOffset(path, HOST_FIRST_PORT), 0xFFFFFFF0u);
+    EXPECT_THROW(ScanArchiveReader reader(path), std::runtime_error);
+
+    ScanArchive::save(sampleResult(), path);
+    writeAt<uint32_t>(path, sectionOffset(path, PORT_BANNER), 1000u);
+    EXPECT_THROW(ScanArchiveReader reader(path), std::runtime_error);
+
+    ScanArchive::save(sampleResult(), path);
+    writeAt<uint64_t>(path, sectionOffset(path, BANNER_OFFSETS) + 8, 1ull << 40);
+    EXPECT_THROW(ScanArchiveReader reader(path), std::runtime_error);
+}
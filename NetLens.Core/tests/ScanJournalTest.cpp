@@ -0,0 +1,257 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "ScanJournal.h"
+#include "TestFiles.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <csignal>
+#include <sys/resource.h>
+#endif
+
+using netlens::HostResult;
+using netlens::Liveness;
+using netlens::ScanSettings;
+using netlens::internal::ScanJournal;
+
+namespace {
+
+// Header and frame sizes of the on-disk format, and the size of a record
+// for a host without open ports: address, flags, closed, filtered, open count
+constexpr size_t HEADER_SIZE = 24;
+constexpr size_t FRAME_SIZE = 8;
+constexpr size_t PLAIN_RECORD_SIZE = FRAME_SIZE + 4 + 1 + 4 + 4 + 4;
+
+ScanSettings journalSettings() {
+    ScanSettings settings;
+    settings.targets = { "10.0.0.0/24" };
+    settings.ports = { 22, 80, 443 };
+    return settings;
+}
+
+HostResult plainHost(uint32_t closed) {
+    HostResult host("", true);
+    host.liveness = Liveness::TcpReply;
+    host.closed_ports = closed;
+    host.filtered_ports = 3 - closed;
+    return host;
+}
+
+std::vector<std::pair<uint32_t, HostResult>> replay(const std::string& path) {
+    std::vector<std::pair<uint32_t, HostResult>> hosts;
+    ScanJournal journal(path, journalSettings(), [&hosts](uint32_t address, HostResult&& host) {
+        hosts.emplace_back(address, std::move(host));
+    });
+    return hosts;
+}
+
+void writeHosts(const std::string& path, uint32_t first, uint32_t count) {
+    ScanJournal journal(path, journalSettings(), nullptr);
+    for (uint32_t i = 0; i < count; ++i) {
+        journal.append(first + i, plainHost(i % 4));
+    }
+}
+
+void flipByte(const std::string& path, size_t offset) {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekg(static_cast<std::streamoff>(offset));
+    char byte = 0;
+    file.get(byte);
+    file.seekp(static_cast<std::streamoff>(offset));
+    file.put(static_cast<char>(byte ^ 0x5A));
+}
+
+// Waits until the file reaches size or the timeout passes, and returns
+// how long that took
+ScanJournal::Clock::duration waitForSize(const std::filesystem::path& path, uintmax_t size,
+                                        ScanJournal::Clock::duration timeout) {
+    const auto started = ScanJournal::Clock::now();
+    while (std::filesystem::file_size(path) < size && ScanJournal::Clock::now() - started < timeout) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return ScanJournal::Clock::now() - started;
+}
+
+} // namespace
+
+TEST(ScanJournal, ReplaysRecordedHosts) {
+    const netlens::test::TempFile path("journal");
+    {
+        ScanJournal journal(path, journalSettings(), nullptr);
+        HostResult web("", true);
+        web.ports.emplace_back(80, true, "HTTP/1.1 200 OK");
+        web.ports.emplace_back(22, false);
+        web.filtered_ports = 1;
+        journal.append(0x0A000001, web);
+        journal.append(0x0A000002, plainHost(3));
+    }
+
+    const auto hosts = replay(path);
+    ASSERT_EQ(hosts.size(), 2u);
+    EXPECT_EQ(hosts[0].first, 0x0A000001u);
+    EXPECT_EQ(hosts[0].second.address, "10.0.0.1");
+    EXPECT_TRUE(hosts[0].second.is_alive);
+    EXPECT_EQ(hosts[0].second.liveness, Liveness::OpenPort);
+    ASSERT_EQ(hosts[0].second.ports.size(), 1u);
+    EXPECT_EQ(hosts[0].second.ports[0].port, 80);
+    EXPECT_EQ(hosts[0].second.ports[0].banner, "HTTP/1.1 200 OK");
+    EXPECT_EQ(hosts[0].second.closed_ports, 1u);
+    EXPECT_EQ(hosts[0].second.filtered_ports, 1u);
+    EXPECT_EQ(hosts[1].first, 0x0A000002u);
+    EXPECT_EQ(hosts[1].second.liveness, Liveness::TcpReply);
+    EXPECT_EQ(hosts[1].second.closed_ports, 3u);
+    EXPECT_EQ(hosts[1].second.filtered_ports, 0u);
+}
+
+TEST(ScanJournal, DropsATruncatedLastRecord) {
+    const netlens::test::TempFile path("journal");
+    writeHosts(path, 0x0A000001, 3);
+    ASSERT_EQ(std::filesystem::file_size(path.path()), HEADER_SIZE + 3 * PLAIN_RECORD_SIZE);
+
+    // A crash in the middle of the last write
+    std::filesystem::resize_file(path.path(), HEADER_SIZE + 2 * PLAIN_RECORD_SIZE + 5);
+
+    auto hosts = replay(path);
+    ASSERT_EQ(hosts.size(), 2u);
+    EXPECT_EQ(hosts[1].first, 0x0A000002u);
+
+    // The torn bytes were cut off, so records appended after reopening are readable
+    EXPECT_EQ(std::filesystem::file_size(path.path()), HEADER_SIZE + 2 * PLAIN_RECORD_SIZE);
+    writeHosts(path, 0x0A000010, 1);
+    hosts = replay(path);
+    ASSERT_EQ(hosts.size(), 3u);
+    EXPECT_EQ(hosts[2].first, 0x0A000010u);
+}
+
+TEST(ScanJournal, DropsATruncatedFrameHeader) {
+    const netlens::test::TempFile path("journal");
+    writeHosts(path, 0x0A000001, 2);
+    std::filesystem::resize_file(path.path(), HEADER_SIZE + PLAIN_RECORD_SIZE + 3);
+
+    EXPECT_EQ(replay(path).size(), 1u);
+}
+
+TEST(ScanJournal, StopsAtACorruptRecord) {
+    const netlens::test::TempFile path("journal");
+    writeHosts(path, 0x0A000001, 4);
+
+    // One payload byte of the second record no longer matches its checksum;
+    // it and everything after it are dropped
+    flipByte(path, HEADER_SIZE + PLAIN_RECORD_SIZE + FRAME_SIZE + 1);
+
+    const auto hosts = replay(path);
+    ASSERT_EQ(hosts.size(), 1u);
+    EXPECT_EQ(hosts[0].first, 0x0A000001u);
+    EXPECT_EQ(std::filesystem::file_size(path.path()), HEADER_SIZE + PLAIN_RECORD_SIZE);
+}
+
+TEST(ScanJournal, StopsAtAnImplausibleLength) {
+    const netlens::test::TempFile path("journal");
+    writeHosts(path, 0x0A000001, 2);
+    flipByte(path, HEADER_SIZE + PLAIN_RECORD_SIZE + 3);
+
+    EXPECT_EQ(replay(path).size(), 1u);
+}
+
+TEST(ScanJournal, RecordedAddressesAreSorted) {
+    const netlens::test::TempFile path("journal");
+    {
+        ScanJournal journal(path, journalSettings(), nullptr);
+        for (uint32_t address : { 0x0A000009u, 0x0A000003u, 0x0A000006u }) {
+            journal.append(address, plainHost(0));
+        }
+    }
+
+    const ScanJournal journal(path, journalSettings(), nullptr);
+    EXPECT_EQ(journal.recorded(), (std::vector<uint32_t>{ 0x0A000003u, 0x0A000006u, 0x0A000009u }));
+}
+
+TEST(ScanJournal, RejectsAJournalOfOtherSettings) {
+    const netlens::test::TempFile path("journal");
+    writeHosts(path, 0x0A000001, 1);
+
+    ScanSettings other = journalSettings();
+    other.ports.push_back(8080);
+    EXPECT_THROW(ScanJournal(path, other, nullptr), std::runtime_error);
+
+    // Timing is not part of the work and may change between runs
+    ScanSettings slower = journalSettings();
+    slower.timeout_ms += 1000;
+    EXPECT_NO_THROW(ScanJournal(path, slower, nullptr));
+}
+
+TEST(ScanJournal, RejectsAForeignFile) {
+    const netlens::test::TempFile path("journal");
+    {
+        std::ofstream file(path.path(), std::ios::binary);
+        file << "{\"scan\": \"not a journal\"}";
+    }
+
+    EXPECT_THROW(ScanJournal(path, journalSettings(), nullptr), std::runtime_error);
+}
+
+TEST(ScanJournal, SyncsWithinTheIntervalWithoutFurtherAppends) {
+    const netlens::test::TempFile path("journal");
+    ScanJournal journal(path, journalSettings(), nullptr);
+    ASSERT_EQ(std::filesystem::file_size(path.path()), HEADER_SIZE);
+
+    // No host completes after this one, as in a scan stuck on slow targets
+    journal.append(0x0A000001, plainHost(0));
+    waitForSize(path.path(), HEADER_SIZE + PLAIN_RECORD_SIZE, 3 * ScanJournal::SYNC_INTERVAL);
+    EXPECT_EQ(std::filesystem::file_size(path.path()), HEADER_SIZE + PLAIN_RECORD_SIZE);
+}
+
+TEST(ScanJournal, SyncsOnRequestWithoutWaitingForTheInterval) {
+    const netlens::test::TempFile path("journal");
+    ScanJournal journal(path, journalSettings(), nullptr);
+    journal.append(0x0A000001, plainHost(0));
+    journal.requestSync();
+
+    const auto waited = waitForSize(path.path(), HEADER_SIZE + PLAIN_RECORD_SIZE, 3 * ScanJournal::SYNC_INTERVAL);
+    EXPECT_EQ(std::filesystem::file_size(path.path()), HEADER_SIZE + PLAIN_RECORD_SIZE);
+    EXPECT_LT(waited, ScanJournal::SYNC_INTERVAL / 2);
+}
+
+#ifndef _WIN32
+TEST(ScanJournal, RetriesOnlyWhatAFailedWriteLeftOut) {
+    const netlens::test::TempFile path("journal");
+    ScanJournal journal(path, journalSettings(), nullptr);
+    const auto hosts = [&path]() {
+        // Read from a copy, since the journal under test stays open
+        const netlens::test::TempFile copy("journal");
+        std::filesystem::copy_file(path.path(), copy.path());
+        return replay(copy).size();
+    };
+
+    // Cap the file size in the middle of the third record, so the write
+    // of the batch stops part-way with EFBIG
+    rlimit original{};
+    ASSERT_EQ(::getrlimit(RLIMIT_FSIZE, &original), 0);
+    const auto previous_handler = std::signal(SIGXFSZ, SIG_IGN);
+    rlimit capped = original;
+    capped.rlim_cur = HEADER_SIZE + 2 * PLAIN_RECORD_SIZE + 10;
+    ASSERT_EQ(::setrlimit(RLIMIT_FSIZE, &capped), 0);
+
+    for (uint32_t i = 0; i < 5; ++i) {
+        journal.append(0x0A000001 + i, plainHost(i % 4));
+    }
+    EXPECT_THROW(journal.sync(), std::runtime_error);
+    EXPECT_EQ(std::filesystem::file_size(path.path()), capped.rlim_cur);
+
+    ASSERT_EQ(::setrlimit(RLIMIT_FSIZE, &original), 0);
+    std::signal(SIGXFSZ, previous_handler);
+    journal.sync();
+    EXPECT_EQ(std::filesystem::file_size(path.path()), HEADER_SIZE + 5 * PLAIN_RECORD_SIZE);
+    EXPECT_EQ(hosts(), 5u);
+}
+#endif
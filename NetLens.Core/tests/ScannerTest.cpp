@@ -0,0 +1,57 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include "TestFiles.h"
+#include <netlens/ScanControl.h>
+#include <netlens/Scanner.h>
+#include <gtest/gtest.h>
+#include <filesystem>
+
+using netlens::HostResult;
+using netlens::ScanControl;
+using netlens::ScanSettings;
+using netlens::Scanner;
+
+namespace {
+
+// Refused at once on loopback, so the scans finish quickly
+ScanSettings loopbackSettings(const std::string& journal) {
+    ScanSettings settings;
+    settings.start_ip = "127.0.0.1";
+    settings.end_ip = "127.0.0.4";
+    settings.ports = { 1, 2 };
+    settings.timeout_ms = 500;
+    settings.journal_path = journal;
+    return settings;
+}
+
+} // namespace
+
+TEST(Scanner, CompletedScanDeletesItsJournal) {
+    const netlens::test::TempFile journal("journal");
+    Scanner scanner;
+
+    size_t hosts = 0;
+    const auto summary = scanner.scanStream(loopbackSettings(journal), [&hosts](HostResult&&) { ++hosts; });
+    ASSERT_FALSE(summary.cancelled);
+    EXPECT_EQ(hosts, 4u);
+    EXPECT_FALSE(std::filesystem::exists(journal.path()));
+
+    // A repeated scan, such as a scheduled one, probes again instead of
+    // replaying the previous run
+    EXPECT_EQ(scanner.scanCompact(loopbackSettings(journal)).hostCount(), 4u);
+    EXPECT_FALSE(std::filesystem::exists(journal.path()));
+}
+
+TEST(Scanner, CancelledScanKeepsItsJournal) {
+    const netlens::test::TempFile journal("journal");
+    Scanner scanner;
+    ScanControl control;
+    control.cancel();
+
+    const auto summary = scanner.scanStream(loopbackSettings(journal), [](HostResult&&) {}, nullptr, &control);
+    EXPECT_TRUE(summary.cancelled);
+    EXPECT_TRUE(std::filesystem::exists(journal.path()));
+}
@@ -0,0 +1,145 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#include <netlens/Scanner.h>
+#include <gtest/gtest.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using netlens::HostResult;
+using netlens::Liveness;
+using netlens::ScanMode;
+using netlens::ScanSettings;
+using netlens::Scanner;
+
+namespace {
+
+/// <summary>
+/// TCP socket bound to an ephemeral port on 127.0.0.1, optionally listening.
+/// </summary>
+class LoopbackSocket {
+public:
+    explicit LoopbackSocket(bool listening) : m_fd(::socket(AF_INET, SOCK_STREAM, 0)), m_port(0) {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t length = sizeof(address);
+        if (m_fd < 0 ||
+            ::bind(m_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            (listening && ::listen(m_fd, 16) != 0) ||
+            ::getsockname(m_fd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+            return;
+        }
+        m_port = ntohs(address.sin_port);
+    }
+
+    ~LoopbackSocket() {
+        if (m_fd >= 0) {
+            ::close(m_fd);
+        }
+    }
+
+    LoopbackSocket(const LoopbackSocket&) = delete;
+    LoopbackSocket& operator=(const LoopbackSocket&) = delete;
+
+    uint16_t port() const { return m_port; }
+
+private:
+    int m_fd;
+    uint16_t m_port;
+};
+
+bool canOpenRawSocket() {
+    const int fd = ::socket(AF_INET, SOCK_RAW, IPPROTO_TCP);
+    if (fd < 0) {
+        return false;
+    }
+    ::close(fd);
+    return true;
+}
+
+} // namespace
+
+TEST(SynScan, ReportsOpenClosedAndRefusingHostsOnLoopback) {
+    if (!canOpenRawSocket()) {
+        GTEST_SKIP() << "SYN scans need a raw socket (CAP_NET_RAW)";
+    }
+
+    const LoopbackSocket listener(true);
+    ASSERT_NE(listener.port(), 0);
+
+    // Bound but not listening, so the kernel answers its SYNs with a reset
+    // and no other socket can take the port during the scan
+    const LoopbackSocket closed(false);
+    ASSERT_NE(closed.port(), 0);
+
+    ScanSettings settings;
+    settings.start_ip = "127.0.0.1";
+    settings.end_ip = "127.0.0.2";
+    settings.scan_mode = ScanMode::Syn;
+    settings.timeout_ms = 1000;
+    settings.ports = { closed.port(), listener.port() };
+
+    std::map<std::string, HostResult> hosts;
+    const auto summary = Scanner().scanStream(settings, [&hosts](HostResult&& host) {
+        std::string address = host.address;
+        hosts.emplace(std::move(address), std::move(host));
+    });
+
+    ASSERT_EQ(hosts.size(), 2u);
+    EXPECT_EQ(summary.alive_hosts, 2u);
+    EXPECT_EQ(summary.open_ports, 1u);
+
+    const HostResult& open = hosts.at("127.0.0.1");
+    EXPECT_TRUE(open.is_alive);
+    EXPECT_EQ(open.liveness, Liveness::OpenPort);
+    ASSERT_EQ(open.ports.size(), 1u);
+    EXPECT_EQ(open.ports[0].port, listener.port());
+    EXPECT_TRUE(open.ports[0].is_open);
+    EXPECT_EQ(open.closed_ports, 1u);
+    EXPECT_EQ(open.filtered_ports, 0u);
+
+    // The listener is bound to 127.0.0.1 only: every SYN to 127.0.0.2 is
+    // refused, which still proves the host is up
+    const HostResult& refusing = hosts.at("127.0.0.2");
+    EXPECT_TRUE(refusing.is_alive);
+    EXPECT_EQ(refusing.liveness, Liveness::TcpReply);
+    EXPECT_TRUE(refusing.ports.empty());
+    EXPECT_EQ(refusing.closed_ports, 2u);
+    EXPECT_EQ(refusing.filtered_ports, 0u);
+}
+
+TEST(SynScan, CountsAPortListedTwiceOnce) {
+    if (!canOpenRawSocket()) {
+        GTEST_SKIP() << "SYN scans need a raw socket (CAP_NET_RAW)";
+    }
+
+    const LoopbackSocket listener(true);
+    ASSERT_NE(listener.port(), 0);
+    const LoopbackSocket closed(false);
+    ASSERT_NE(closed.port(), 0);
+
+    ScanSettings settings;
+    settings.start_ip = "127.0.0.1";
+    settings.end_ip = "127.0.0.1";
+    settings.scan_mode = ScanMode::Syn;
+    settings.timeout_ms = 1000;
+    settings.ports = { closed.port(), listener.port(), closed.port(), listener.port() };
+
+    std::vector<HostResult> hosts;
+    Scanner().scanStream(settings, [&hosts](HostResult&& host) { hosts.push_back(std::move(host)); });
+
+    ASSERT_EQ(hosts.size(), 1u);
+    ASSERT_EQ(hosts[0].ports.size(), 1u);
+    EXPECT_EQ(hosts[0].ports[0].port, listener.port());
+    EXPECT_EQ(hosts[0].closed_ports, 1u);
+    EXPECT_EQ(hosts[0].filtered_ports, 0u);
+}
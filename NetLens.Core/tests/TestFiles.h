@@ -0,0 +1,56 @@
+// NetLens - Modern Windows Network Scanner
+// Copyright (c) 2025 Olivier Flentge
+// Licensed under the GNU Affero General Public License v3.0 (AGPL-3.0).
+// See the LICENSE file in the project root for details.
+
+#pragma once
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+namespace netlens::test {
+
+/// <summary>
+/// Unique path in the temporary directory, removed when the object goes
+/// out of scope. The file itself is not created.
+/// </summary>
+class TempFile {
+public:
+    explicit TempFile(const std::string& extension) {
+        static std::atomic<unsigned> counter{ 0 };
+        const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+        std::string name = "netlens-";
+        if (info != nullptr) {
+            name += info->test_suite_name();
+            name += '-';
+            name += info->name();
+            name += '-';
+        }
+        name += std::to_string(counter++);
+        name += '.';
+        name += extension;
+        m_path = std::filesystem::temp_directory_path() / name;
+        std::error_code ignored;
+        std::filesystem::remove(m_path, ignored);
+    }
+
+    ~TempFile() {
+        std::error_code ignored;
+        std::filesystem::remove(m_path, ignored);
+    }
+
+    TempFile(const TempFile&) = delete;
+    TempFile& operator=(const TempFile&) = delete;
+
+    const std::filesystem::path& path() const { return m_path; }
+    std::string string() const { return m_path.string(); }
+    operator std::string() const { return m_path.string(); }
+
+private:
+    std::filesystem::path m_path;
+};
+
+} // namespace netlens::test
@@ -95,6 +95,9 @@ namespace winrt::NetLens::implementation
         // Disable controls
         RunScanButton().IsEnabled(false);
         ExportJsonButton().IsEnabled(false);
+        PauseScanButton().Content(winrt::box_value(L"Pause"));
+        PauseScanButton().IsEnabled(true);
+        CancelScanButton().IsEnabled(true);
         StartIpTextBox().IsEnabled(false);
         EndIpTextBox().IsEnabled(false);
         PortsTextBox().IsEnabled(false);
@@ -140,6 +143,33 @@ namespace winrt::NetLens::implementation
         );
     }
 
+    void MainWindow::OnPauseScanClick(winrt::Windows::Foundation::IInspectable const&,
+                                       winrt::Microsoft::UI::Xaml::RoutedEventArgs const&)
+    {
+        if (!m_viewModel->IsScanRunning()) {
+            return;
+        }
+
+        if (m_viewModel->IsScanPaused()) {
+            m_viewModel->ResumeScan();
+            PauseScanButton().Content(winrt::box_value(L"Pause"));
+            StatusTextBlock().Text(L"Resuming scan...");
+        } else {
+            m_viewModel->PauseScan();
+            PauseScanButton().Content(winrt::box_value(L"Resume"));
+            StatusTextBlock().Text(L"Scan paused");
+        }
+    }
+
+    void MainWindow::OnCancelScanClick(winrt::Windows::Foundation::IInspectable const&,
+                                        winrt::Microsoft::UI::Xaml::RoutedEventArgs const&)
+    {
+        m_viewModel->CancelScan();
+        PauseScanButton().IsEnabled(false);
+        CancelScanButton().IsEnabled(false);
+        StatusTextBlock().Text(L"Cancelling scan...");
+    }
+
     void MainWindow::OnExportJsonClick(winrt::Windows::Foundation::IInspectable const&,
                                         winrt::Microsoft::UI::Xaml::RoutedEventArgs const&)
     {
@@ -194,6 +224,8 @@ namespace winrt::NetLens::implementation
         // Re-enable controls
         RunScanButton().IsEnabled(true);
         ExportJsonButton().IsEnabled(true);
+        PauseScanButton().IsEnabled(false);
+        CancelScanButton().IsEnabled(false);
         StartIpTextBox().IsEnabled(true);
         EndIpTextBox().IsEnabled(true);
         PortsTextBox().IsEnabled(true);
@@ -207,7 +239,8 @@ namespace winrt::NetLens::implementation
         // Clear status
         auto statusText = StatusTextBlock();
         if (statusText) {
-            statusText.Text(L"Scan complete!");
+            statusText.Text(m_viewModel->WasScanCancelled() ? L"Scan cancelled; showing partial results"
+                                                            : L"Scan complete!");
         }
 
         // Update the UI to display results
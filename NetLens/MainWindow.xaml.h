@@ -27,6 +27,12 @@ namespace winrt::NetLens::implementation
         void OnExportJsonClick(winrt::Windows::Foundation::IInspectable const& sender, 
                                winrt::Microsoft::UI::Xaml::RoutedEventArgs const& args);
 
+        void OnPauseScanClick(winrt::Windows::Foundation::IInspectable const& sender, 
+                              winrt::Microsoft::UI::Xaml::RoutedEventArgs const& args);
+
+        void OnCancelScanClick(winrt::Windows::Foundation::IInspectable const& sender, 
+                               winrt::Microsoft::UI::Xaml::RoutedEventArgs const& args);
+
     private:
         std::unique_ptr<::NetLens::ViewModels::MainViewModel> m_viewModel;
         winrt::Microsoft::UI::Dispatching::DispatcherQueue m_dispatcherQueue{ nullptr };
@@ -14,10 +14,18 @@ namespace NetLens::ViewModels
         : m_scanner(std::make_unique<netlens::Scanner>())
         , m_scanResult()
         , m_isScanning(false)
+        , m_wasCancelled(false)
     {
     }
 
-    MainViewModel::~MainViewModel() = default;
+    MainViewModel::~MainViewModel()
+    {
+        // Tear down a running scan instead of leaving it to a detached thread
+        CancelScan();
+        if (m_scanThread.joinable()) {
+            m_scanThread.join();
+        }
+    }
 
     void MainViewModel::RunScanAsync(
         const std::string& startIp,
@@ -31,41 +39,53 @@ namespace NetLens::ViewModels
             return;
         }
 
+        // The previous scan thread has finished; reap it
+        if (m_scanThread.joinable()) {
+            m_scanThread.join();
+        }
+
+        auto control = std::make_shared<netlens::ScanControl>();
+        {
+            std::lock_guard<std::mutex> lock(m_controlMutex);
+            m_scanControl = control;
+        }
+        m_wasCancelled.store(false);
+
         // Launch scan on a background thread
-        std::thread scanThread([this, startIp, endIp, ports, progressCallback, completionCallback]() {
+        m_scanThread = std::thread([this, startIp, endIp, ports, progressCallback, completionCallback, control]() {
             try {
                 // Create scan settings from user input
                 netlens::ScanSettings settings;
                 settings.start_ip = startIp;
                 settings.end_ip = endIp;
                 settings.ports = ports;
-                settings.timeout_ms = 500;
-                settings.max_concurrency = 50;
-
-                // Calculate approximate total operations for progress
-                size_t estimated_hosts = 254;  // Rough estimate
-                size_t total_operations = estimated_hosts * ports.size();
-                size_t completed_operations = 0;
+                settings.timeout_ms = 1500;  // Upper bound; adapted per host from measured RTT
+                settings.max_concurrency = 256;
+                settings.progress_interval_ms = 250;  // Coalesced snapshots; one UI update each
 
                 // Execute scan with progress callback
                 netlens::ScanResult result = m_scanner->scan(settings, 
                     [&](const netlens::ScanProgress& progress) {
-                        // Calculate overall progress
-                        completed_operations = 
-                            (progress.completed_hosts * ports.size()) + 
-                            progress.completed_ports;
-
                         // Format status message
                         std::ostringstream status;
-                        status << "Scanning " << progress.current_ip 
-                               << " (Host " << (progress.completed_hosts + 1) 
-                               << "/" << progress.total_hosts << ")";
+                        status << "Scanned " << progress.completed_hosts
+                               << "/" << progress.total_hosts << " hosts";
+                        if (!progress.current_ip.empty()) {
+                            status << ", last " << progress.current_ip;
+                        }
+                        status << " (" << static_cast<size_t>(progress.port_rate) << " ports/s";
+                        if (progress.eta_seconds >= 0.0) {
+                            status << ", " << static_cast<size_t>(progress.eta_seconds + 0.5) << " s left";
+                        }
+                        status << ")";
 
                         // Call UI progress callback
                         if (progressCallback) {
-                            progressCallback(completed_operations, total_operations, status.str());
+                            progressCallback(progress.completed_ports, progress.total_ports, status.str());
                         }
-                    });
+                    },
+                    control.get());
+                m_wasCancelled.store(control->cancelled());
 
                 // Store result (thread-safe)
                 {
@@ -92,6 +112,10 @@ namespace NetLens::ViewModels
             }
 
             // Mark scan as complete
+            {
+                std::lock_guard<std::mutex> lock(m_controlMutex);
+                m_scanControl.reset();
+            }
             m_isScanning.store(false);
 
             // Call completion callback
@@ -99,9 +123,36 @@ namespace NetLens::ViewModels
                 completionCallback();
             }
         });
+    }
+
+    void MainViewModel::CancelScan()
+    {
+        std::lock_guard<std::mutex> lock(m_controlMutex);
+        if (m_scanControl) {
+            m_scanControl->cancel();
+        }
+    }
+
+    void MainViewModel::PauseScan()
+    {
+        std::lock_guard<std::mutex> lock(m_controlMutex);
+        if (m_scanControl) {
+            m_scanControl->pause();
+        }
+    }
 
-        // Detach thread so it runs independently
-        scanThread.detach();
+    void MainViewModel::ResumeScan()
+    {
+        std::lock_guard<std::mutex> lock(m_controlMutex);
+        if (m_scanControl) {
+            m_scanControl->resume();
+        }
+    }
+
+    bool MainViewModel::IsScanPaused() const
+    {
+        std::lock_guard<std::mutex> lock(m_controlMutex);
+        return m_scanControl && m_scanControl->paused();
     }
 
     netlens::ScanResult MainViewModel::GetScanResult() const
@@ -10,6 +10,7 @@
 #include <vector>
 #include <atomic>
 #include <mutex>
+#include <thread>
 #include <netlens/Scanner.h>
 #include <netlens/ScanResult.h>
 
@@ -40,6 +41,22 @@ namespace NetLens::ViewModels
             std::function<void()> completionCallback
         );
 
+        /// <summary>
+        /// Cancels the running scan. Its sockets close at once and the hosts
+        /// completed so far become the scan result.
+        /// </summary>
+        void CancelScan();
+
+        /// <summary>
+        /// Pauses the running scan, closing its connections in flight.
+        /// </summary>
+        void PauseScan();
+
+        /// <summary>
+        /// Resumes a paused scan where it stopped.
+        /// </summary>
+        void ResumeScan();
+
         /// <summary>
         /// Gets the current scan result (thread-safe).
         /// </summary>
@@ -55,10 +72,26 @@ namespace NetLens::ViewModels
         /// </summary>
         bool IsScanRunning() const { return m_isScanning.load(); }
 
+        /// <summary>
+        /// Checks if the running scan is paused.
+        /// </summary>
+        bool IsScanPaused() const;
+
+        /// <summary>
+        /// Checks if the last scan was cancelled before it completed.
+        /// </summary>
+        bool WasScanCancelled() const { return m_wasCancelled.load(); }
+
     private:
         std::unique_ptr<netlens::Scanner> m_scanner;
         netlens::ScanResult m_scanResult;
         mutable std::mutex m_resultMutex;
         std::atomic<bool> m_isScanning;
+        std::atomic<bool> m_wasCancelled;
+
+        // Control of the running scan, replaced for each scan
+        std::shared_ptr<netlens::ScanControl> m_scanControl;
+        mutable std::mutex m_controlMutex;
+        std::thread m_scanThread;
     };
 }